@@ -0,0 +1,79 @@
+#include "benchmark/benchmark_utils.hpp"
+#include "ast/ast_node.hpp"
+#include "ast/parser.hpp"
+#include "common/strings_container_impl.hpp"
+#include "errors/errors_observer.hpp"
+#include "lexer/lexer.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Parses a large generated, expression heavy script and prints parser
+// throughput. The script is lexed once, before the measurement.
+//
+// Usage: parser_cmakesl_benchmark [iterations] [functions count]
+
+namespace cmsl::benchmark {
+namespace {
+std::string generate_function(unsigned index)
+{
+  const auto n = std::to_string(index);
+
+  std::string function;
+  function += "int compute_" + n + "(int a, int b, double c)\n";
+  function += "{\n"
+              "    int x = a + b * 2 - (a - b) / 3 % 4;\n"
+              "    bool y = a < b && b <= x || !(a == b) && x != 0;\n"
+              "    x += a * (b + 1) - c.to_int() * 2;\n"
+              "    x = (x | 1) ^ (a & b);\n"
+              "    auto s = \"value: \" + x.to_string() + \", \" + "
+              "c.to_string();\n"
+              "    list<int> l = { a, b, a + b, a * b };\n"
+              "    return y ? x + l.size() : x - l.at(0) * 2 + 1;\n"
+              "}\n"
+              "\n";
+  return function;
+}
+
+std::string generate_source(unsigned functions_count)
+{
+  std::string source;
+  for (auto i = 0u; i < functions_count; ++i) {
+    source += generate_function(i);
+  }
+  return source;
+}
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const auto iterations =
+    argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 20u;
+  const auto functions_count =
+    argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 5000u;
+
+  const auto source = cmsl::benchmark::generate_source(functions_count);
+  const cmsl::source_info info{ source };
+  const auto source_view = cmsl::source_view{ info };
+
+  cmsl::errors::errors_observer errs;
+  const auto tokens = cmsl::lexer::lexer{ errs, source_view }.lex();
+
+  const auto parse = [&] {
+    cmsl::strings_container_impl strings;
+    cmsl::ast::parser parser{ errs, strings, source_view, tokens };
+    if (!parser.parse_translation_unit()) {
+      std::fprintf(stderr, "parser/generated: parsing failed\n");
+      std::exit(1);
+    }
+  };
+
+  const auto ns =
+    cmsl::benchmark::measure("parser/generated", iterations, parse);
+
+  const auto tokens_per_s = tokens.size() / (ns / 1e9);
+  std::printf("%-48s %14.0f tokens/s (%zu tokens)\n", "parser/generated",
+              tokens_per_s, tokens.size());
+}
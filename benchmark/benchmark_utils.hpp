@@ -0,0 +1,28 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace cmsl::benchmark {
+// Calls fun given number of times, after a single warm up call, and prints
+// the average duration of a call. Returns the average in nanoseconds, so
+// callers can derive their own metrics, e.g. throughput.
+template <typename Function>
+double measure(const std::string& name, unsigned iterations, Function&& fun)
+{
+  fun();
+
+  const auto begin = std::chrono::steady_clock::now();
+  for (auto i = 0u; i < iterations; ++i) {
+    fun();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const auto total =
+    std::chrono::duration<double, std::nano>(end - begin).count();
+  const auto average = total / iterations;
+  std::printf("%-48s %14.0f ns/iter\n", name.c_str(), average);
+  return average;
+}
+}
@@ -0,0 +1,167 @@
+#include "benchmark/benchmark_utils.hpp"
+#include "exec/global_executor.hpp"
+#include "test/mock/cmake_facade_mock.hpp"
+
+#include <sys/resource.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Compiles a large generated script, whose main() does nothing, and prints
+// compilation time, which is dominated by semantic analysis, and peak RSS of
+// the process.
+//
+// Then it compiles a generated tree of subdirectories and prints a memory
+// report: per module memory that is released after semantic analysis and
+// memory that is kept till the end of execution.
+//
+// Usage: compile_cmakesl_benchmark [iterations] [classes count]
+//                                  [subdirectories count]
+
+namespace cmsl::benchmark {
+namespace {
+std::string generate_class(unsigned index)
+{
+  const auto n = std::to_string(index);
+
+  std::string cls;
+  cls += "class Item_" + n + "\n";
+  cls += "{\n"
+         "    int value;\n"
+         "    string name;\n"
+         "    list<int> history;\n"
+         "\n"
+         "    int add(int a, int b)\n"
+         "    {\n"
+         "        int x = a + b * 2 - (a - b) / 3;\n"
+         "        history.push_back(x);\n"
+         "        if(x > value && !(a == b))\n"
+         "        {\n"
+         "            value = x;\n"
+         "        }\n"
+         "        return value;\n"
+         "    }\n"
+         "\n"
+         "    string describe(int factor)\n"
+         "    {\n"
+         "        auto s = name + \": \" + value.to_string();\n"
+         "        for(int i = 0; i < history.size(); i += 1)\n"
+         "        {\n"
+         "            s += \", \" + (history.at(i) * factor).to_string();\n"
+         "        }\n"
+         "        return s;\n"
+         "    }\n"
+         "};\n"
+         "\n";
+  cls += "int use_item_" + n + "(int a)\n";
+  cls += "{\n";
+  cls += "    Item_" + n + " item;\n";
+  cls += "    item.value = a;\n"
+         "    item.add(a, a + 1);\n"
+         "    return item.describe(2).size();\n"
+         "}\n"
+         "\n";
+  return cls;
+}
+
+std::string generate_source(unsigned classes_count,
+                            const std::string& main_body = "")
+{
+  std::string source;
+  for (auto i = 0u; i < classes_count; ++i) {
+    source += generate_class(i);
+  }
+  source += "int main()\n"
+            "{\n";
+  source += main_body;
+  source += "    return 0;\n"
+            "}\n";
+  return source;
+}
+
+void write_file(const std::filesystem::path& path, const std::string& content)
+{
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream{ path } << content;
+}
+
+void report_memory_of_tree(unsigned classes_count, unsigned subdirs_count)
+{
+  const auto root =
+    std::filesystem::temp_directory_path() / "cmakesl_compile_benchmark";
+  std::filesystem::remove_all(root);
+
+  std::string root_main_body;
+  for (auto i = 0u; i < subdirs_count; ++i) {
+    const auto name = "module_" + std::to_string(i);
+    write_file(root / name / "CMakeLists.cmsl",
+               generate_source(classes_count));
+    root_main_body += "    add_subdirectory(\"" + name + "\");\n";
+  }
+
+  ::testing::NiceMock<exec::test::cmake_facade_mock> facade;
+  ON_CALL(facade, current_directory())
+    .WillByDefault(::testing::Return(root.string()));
+
+  exec::global_executor executor{ root.string(), facade };
+  if (executor.execute(generate_source(classes_count, root_main_body)) != 0) {
+    std::fprintf(stderr, "compile/tree: unexpected result\n");
+    std::exit(1);
+  }
+
+  auto released_total = std::size_t{ 0u };
+  auto kept_total = std::size_t{ 0u };
+  for (const auto& module : executor.memory_report()) {
+    const auto path = std::filesystem::path{ std::string{ module.path } };
+    const auto name = path.parent_path().filename().string();
+    std::printf("%-48s %8zu KiB released %8zu KiB kept\n",
+                ("compile/tree/" + name).c_str(),
+                module.released_bytes / 1024u, module.kept_bytes / 1024u);
+    released_total += module.released_bytes;
+    kept_total += module.kept_bytes;
+  }
+  std::printf("%-48s %8zu KiB released %8zu KiB kept\n", "compile/tree",
+              released_total / 1024u, kept_total / 1024u);
+
+  std::filesystem::remove_all(root);
+}
+
+long peak_rss_kib()
+{
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const auto iterations =
+    argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 5u;
+  const auto classes_count =
+    argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 1000u;
+  const auto subdirs_count =
+    argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 20u;
+
+  const auto source = cmsl::benchmark::generate_source(classes_count);
+
+  cmsl::benchmark::measure("compile/generated", iterations, [&] {
+    ::testing::NiceMock<cmsl::exec::test::cmake_facade_mock> facade;
+    cmsl::exec::global_executor executor{ CMAKESL_EXEC_BENCHMARK_ROOT_DIR,
+                                          facade };
+    if (executor.execute(source) != 0) {
+      std::fprintf(stderr, "compile/generated: unexpected result\n");
+      std::exit(1);
+    }
+  });
+
+  std::printf("%-48s %14ld KiB peak RSS (%zu bytes of source)\n",
+              "compile/generated", cmsl::benchmark::peak_rss_kib(),
+              source.size());
+
+  cmsl::benchmark::report_memory_of_tree(classes_count / 10u, subdirs_count);
+}
@@ -0,0 +1,132 @@
+#include "benchmark/benchmark_utils.hpp"
+#include "exec/global_executor.hpp"
+#include "test/mock/cmake_facade_mock.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Executes scripts with both execution engines. The scripts use the same
+// kinds of statements as test/exec smoke tests, but loop long enough for the
+// execution itself to dominate over creation of an executor and compilation,
+// which are part of each run.
+//
+// Usage: exec_cmakesl_benchmark [iterations]
+
+namespace cmsl::benchmark {
+namespace {
+struct script
+{
+  std::string name;
+  std::string source;
+  int expected_result;
+};
+
+std::vector<script> scripts()
+{
+  return {
+    { "exec/for_loop",
+      "int main()"
+      "{"
+      "    int value;"
+      "    for(int i = 0; i < 20000; i += 1)"
+      "    {"
+      "        value = i;"
+      "        if(value == 10000)"
+      "        {"
+      "            value = 0;"
+      "        }"
+      "    }"
+      "    return value;"
+      "}",
+      19999 },
+    { "exec/recursive_function",
+      "int fib(int n)"
+      "{"
+      "    if(n < 2)"
+      "    {"
+      "        return n;"
+      "    }"
+      ""
+      "    return fib(n - 1) + fib(n - 2);"
+      "}"
+      ""
+      "int main()"
+      "{"
+      "    return fib(18);"
+      "}",
+      2584 },
+    { "exec/class_member_function",
+      "class Counter"
+      "{"
+      "    int value;"
+      ""
+      "    void increment()"
+      "    {"
+      "        value += 1;"
+      "    }"
+      "};"
+      ""
+      "int main()"
+      "{"
+      "    Counter c;"
+      "    int i = 0;"
+      "    while(i < 10000)"
+      "    {"
+      "        c.increment();"
+      "        i += 1;"
+      "    }"
+      "    return c.value;"
+      "}",
+      10000 },
+    { "exec/list",
+      "int main()"
+      "{"
+      "    list<int> l;"
+      "    int i = 0;"
+      "    while(i < 10000)"
+      "    {"
+      "        l.push_back(i);"
+      "        i += 1;"
+      "    }"
+      "    return l.size();"
+      "}",
+      10000 },
+  };
+}
+
+const char* engine_name(exec::execution_engine engine)
+{
+  return engine == exec::execution_engine::tree_walker ? "tree_walker"
+                                                       : "bytecode_vm";
+}
+
+void run(const std::vector<script>& scripts, unsigned iterations)
+{
+  for (const auto engine : { exec::execution_engine::tree_walker,
+                             exec::execution_engine::bytecode_vm }) {
+    for (const auto& s : scripts) {
+      const auto name = s.name + " [" + engine_name(engine) + "]";
+      measure(name, iterations, [&] {
+        ::testing::NiceMock<exec::test::cmake_facade_mock> facade;
+        exec::global_executor executor{ CMAKESL_EXEC_BENCHMARK_ROOT_DIR,
+                                        facade, engine };
+        if (executor.execute(s.source) != s.expected_result) {
+          std::fprintf(stderr, "%s: unexpected result\n", name.c_str());
+          std::exit(1);
+        }
+      });
+    }
+  }
+}
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const auto iterations =
+    argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 10u;
+
+  cmsl::benchmark::run(cmsl::benchmark::scripts(), iterations);
+}
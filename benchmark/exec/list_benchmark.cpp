@@ -0,0 +1,144 @@
+#include "benchmark/benchmark_utils.hpp"
+#include "exec/instance/list_value.hpp"
+#include "exec/instance/simple_unnamed_instance.hpp"
+#include "sema/sema_context_impl.hpp"
+#include "sema/sema_type.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Measures operations of list_value with elements of builtin types: building
+// a list with push_back, copying it, sorting a copy, finding a value that is
+// not in the list, which scans all the elements, repeated lookups of values,
+// which are served by the hash index, and removing duplicates.
+//
+// Usage: list_cmakesl_benchmark [iterations]
+
+namespace cmsl::benchmark {
+namespace {
+using elements_t = std::vector<std::unique_ptr<exec::inst::instance>>;
+
+int_t g_sink{ 0 };
+
+// Pseudo random, but the same in every run.
+std::vector<int_t> generate_numbers(unsigned count)
+{
+  std::vector<int_t> numbers;
+  numbers.reserve(count);
+  unsigned state{ 42u };
+  for (auto i = 0u; i < count; ++i) {
+    state = state * 1664525u + 1013904223u;
+    numbers.push_back(static_cast<int_t>(state % 1000000u));
+  }
+  return numbers;
+}
+
+elements_t create_ints(const sema::sema_type& type, unsigned count)
+{
+  elements_t elements;
+  for (const auto number : generate_numbers(count)) {
+    elements.emplace_back(
+      std::make_unique<exec::inst::simple_unnamed_instance>(type, number));
+  }
+  return elements;
+}
+
+elements_t create_strings(const sema::sema_type& type, unsigned count)
+{
+  elements_t elements;
+  for (const auto number : generate_numbers(count)) {
+    auto source = "source_file_" + std::to_string(number) + ".cpp";
+    elements.emplace_back(
+      std::make_unique<exec::inst::simple_unnamed_instance>(
+        type, std::move(source)));
+  }
+  return elements;
+}
+
+exec::inst::list_value create_list(const elements_t& elements)
+{
+  exec::inst::list_value list{ elements.front()->type() };
+  for (const auto& element : elements) {
+    list.push_back(*element);
+  }
+  return list;
+}
+
+void run(const std::string& name, const elements_t& elements,
+         const exec::inst::instance& missing_value, unsigned iterations)
+{
+  const auto prefix = name + " " + std::to_string(elements.size());
+
+  measure(prefix + " push_back", iterations,
+          [&] { g_sink += create_list(elements).size(); });
+
+  const auto list = create_list(elements);
+
+  measure(prefix + " copy", iterations, [&] {
+    auto copied = list;
+    g_sink += copied.size();
+  });
+
+  measure(prefix + " copy and sort", iterations, [&] {
+    auto copied = list;
+    copied.sort();
+    g_sink += copied.size();
+  });
+
+  measure(prefix + " find", iterations,
+          [&] { g_sink += list.find(missing_value); });
+
+  const auto lookups = 1000u;
+  const auto step = elements.size() / lookups;
+  measure(prefix + " contains x" + std::to_string(lookups), iterations, [&] {
+    for (auto i = 0u; i < lookups; ++i) {
+      g_sink += list.contains(*elements[i * step]);
+    }
+  });
+
+  measure(prefix + " copy and unique", iterations, [&] {
+    auto copied = list;
+    g_sink += copied.unique();
+  });
+}
+}
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace cmsl;
+
+  const auto iterations =
+    argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 20u;
+
+  const sema::sema_context_impl ctx{ "" };
+  const sema::sema_type int_type{
+    ctx, ast::type_representation{ lexer::token{ lexer::token_type::kw_int } },
+    {}, sema::sema_type::flags::builtin
+  };
+  const sema::sema_type string_type{
+    ctx,
+    ast::type_representation{ lexer::token{ lexer::token_type::kw_string } },
+    {},
+    sema::sema_type::flags::builtin
+  };
+
+  const exec::inst::simple_unnamed_instance missing_int{ int_type,
+                                                         int_t{ -1 } };
+  const exec::inst::simple_unnamed_instance missing_string{ string_type,
+                                                            "missing" };
+
+  for (const auto count : { 10000u, 100000u }) {
+    benchmark::run("list<int>", benchmark::create_ints(int_type, count),
+                   missing_int, iterations);
+    benchmark::run("list<string>",
+                   benchmark::create_strings(string_type, count),
+                   missing_string, iterations);
+  }
+
+  std::printf("(sink %lld)\n", static_cast<long long>(benchmark::g_sink));
+}
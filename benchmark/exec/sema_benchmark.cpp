@@ -0,0 +1,158 @@
+#include "benchmark/benchmark_utils.hpp"
+#include "errors/errors_observer.hpp"
+#include "exec/global_executor.hpp"
+#include "sema/builtin_sema_context.hpp"
+#include "sema/builtin_token_provider.hpp"
+#include "sema/enum_values_context.hpp"
+#include "sema/factories_provider.hpp"
+#include "sema/functions_context.hpp"
+#include "sema/identifiers_context.hpp"
+#include "sema/sema_function.hpp"
+#include "sema/qualified_contextes_refs.hpp"
+#include "sema/types_context.hpp"
+#include "test/mock/cmake_facade_mock.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Compiles a generated script that is dominated by calls: member functions
+// of builtin types, which have dozens of them, free functions and methods of
+// classes. main() does nothing, so the time is spent in parsing and semantic
+// analysis, mostly in lookups of the called functions. The second script
+// uses nested generic types, which are found and compared by their names.
+// Startup is measured separately, as creation of the builtin context alone.
+//
+// Usage: sema_cmakesl_benchmark [iterations] [functions count]
+
+namespace cmsl::benchmark {
+namespace {
+std::string generate_function(unsigned index)
+{
+  const auto n = std::to_string(index);
+  const auto previous = std::to_string(index == 0u ? 0u : index - 1u);
+
+  std::string fun;
+  fun += "class Worker_" + n + "\n";
+  fun += "{\n"
+         "    string name;\n"
+         "    list<string> sources;\n"
+         "\n"
+         "    int count() { return sources.size(); }\n"
+         "};\n"
+         "\n";
+  fun += "int process_" + n + "(string s, list<string> l, int a)\n";
+  fun += "{\n"
+         "    int r = s.size() + l.size() + a.to_string().size();\n"
+         "    if(s.empty() || l.empty() || s.starts_with(\"src\"))\n"
+         "    {\n"
+         "        r += s.find(\"cpp\") + s.find_last(\"/\");\n"
+         "    }\n"
+         "    auto upper = s.make_upper();\n"
+         "    r += upper.substr(1, 2).size() + l.find(s);\n"
+         "    l.push_back(s.make_lower());\n"
+         "    l.sort();\n"
+         "    r += l.at(0).size() + l.back().size() + l.front().size();\n";
+  fun += "    Worker_" + n + " w;\n";
+  fun += "    w.sources.push_back(s);\n"
+         "    r += w.count() + w.name.size();\n";
+  fun += "    r += process_" + previous + "(s, l, a);\n";
+  fun += "    return r;\n"
+         "}\n"
+         "\n";
+  return fun;
+}
+
+std::string generate_nested_generics_function(unsigned index)
+{
+  const auto n = std::to_string(index);
+
+  std::string fun;
+  fun += "list<list<string>> nested_" + n +
+    "(list<list<list<string>>> l, list<list<int>> ints)\n";
+  fun += "{\n"
+         "    list<list<string>> r = l.at(0);\n"
+         "    r.push_back(l.back().front());\n"
+         "    list<list<list<list<string>>>> deeper;\n"
+         "    deeper.push_back(l);\n"
+         "    r += deeper.at(0).at(0);\n"
+         "    ints.push_back(ints.front());\n"
+         "    return r;\n"
+         "}\n"
+         "\n";
+  return fun;
+}
+
+template <typename Generator>
+std::string generate_source(unsigned functions_count, Generator generator)
+{
+  std::string source;
+  for (auto i = 0u; i < functions_count; ++i) {
+    source += generator(i);
+  }
+  source += "int main()\n"
+            "{\n"
+            "    return 0;\n"
+            "}\n";
+  return source;
+}
+
+void measure_compilation(const std::string& name, unsigned iterations,
+                         const std::string& source)
+{
+  measure(name, iterations, [&] {
+    ::testing::NiceMock<cmsl::exec::test::cmake_facade_mock> facade;
+    cmsl::exec::global_executor executor{ CMAKESL_EXEC_BENCHMARK_ROOT_DIR,
+                                          facade };
+    if (executor.execute(source) != 0) {
+      std::fprintf(stderr, "%s: unexpected result\n", name.c_str());
+      std::exit(1);
+    }
+  });
+}
+
+// Also prints how many functions the builtin context creates. Member
+// functions of list types are created on their first lookup, so only the
+// ones the builtin context itself looks up are counted.
+void measure_builtin_context_creation(unsigned iterations)
+{
+  auto functions_count = std::size_t{ 0u };
+  measure("sema/builtin context", iterations, [&functions_count] {
+    sema::factories_provider factories;
+    errors::errors_observer errors_observer;
+    const sema::builtin_token_provider tokens{ "" };
+    auto ctxs = sema::qualified_contextes{
+      std::make_unique<sema::enum_values_context_impl>(),
+      std::make_unique<sema::functions_context_impl>(),
+      std::make_unique<sema::identifiers_context_impl>(),
+      std::make_unique<sema::types_context_impl>()
+    };
+    auto refs = sema::qualified_contextes_refs{ ctxs };
+    const sema::builtin_sema_context ctx{ factories, errors_observer, tokens,
+                                          refs };
+    functions_count = factories.functions_count();
+  });
+  std::printf("%-48s %14zu functions\n", "sema/builtin context",
+              functions_count);
+}
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const auto iterations =
+    argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 5u;
+  const auto functions_count =
+    argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 1000u;
+
+  using namespace cmsl::benchmark;
+
+  measure_builtin_context_creation(iterations * 10u);
+
+  measure_compilation(
+    "sema/calls", iterations,
+    generate_source(functions_count, generate_function));
+  measure_compilation(
+    "sema/nested generics", iterations,
+    generate_source(functions_count, generate_nested_generics_function));
+}
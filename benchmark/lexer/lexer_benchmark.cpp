@@ -0,0 +1,81 @@
+#include "benchmark/benchmark_utils.hpp"
+#include "errors/errors_observer.hpp"
+#include "lexer/lexer.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Lexes a large generated script and prints lexer throughput.
+//
+// Usage: lexer_cmakesl_benchmark [iterations] [source size in MB]
+
+namespace cmsl::benchmark {
+namespace {
+// A chunk of code that uses every kind of token: keywords, identifiers,
+// numbers, strings, operators and comments.
+std::string generate_chunk(unsigned index)
+{
+  const auto n = std::to_string(index);
+
+  std::string chunk;
+  chunk += "// Generated class number " + n + "\n";
+  chunk += "class generated_" + n + "\n";
+  chunk += "{\n";
+  chunk += "    int counter = " + n + ";\n";
+  chunk += "    double ratio = 0.25;\n"
+           "    list<string> names;\n"
+           "\n"
+           "    /* Multiline\n"
+           "       comment */\n"
+           "    bool update(int value)\n"
+           "    {\n"
+           "        counter += value * 2 - (value % 3);\n"
+           "        if (counter >= 100 && !names.empty() || value == 0) {\n"
+           "            names.push_back(\"name_\" + value.to_string());\n"
+           "            return true;\n"
+           "        }\n"
+           "        for (auto i = 0; i < value; ++i) {\n"
+           "            ratio = ratio / 2.0;\n"
+           "        }\n"
+           "        return cmake::get_cxx_compiler_info().id == \"gcc\";\n"
+           "    }\n"
+           "};\n"
+           "\n";
+  return chunk;
+}
+
+std::string generate_source(std::size_t size)
+{
+  std::string source;
+  source.reserve(size + 1024u);
+  for (auto i = 0u; source.size() < size; ++i) {
+    source += generate_chunk(i);
+  }
+  return source;
+}
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const auto iterations =
+    argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 20u;
+  const auto megabytes =
+    argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 4u;
+
+  const auto source =
+    cmsl::benchmark::generate_source(megabytes * 1024u * 1024u);
+  std::size_t tokens_count{ 0u };
+
+  const auto ns = cmsl::benchmark::measure("lexer/generated", iterations, [&] {
+    cmsl::errors::errors_observer errs;
+    const cmsl::source_info info{ source };
+    cmsl::lexer::lexer lex{ errs, cmsl::source_view{ info } };
+    tokens_count = lex.lex().size();
+  });
+
+  const auto mb_per_s = (source.size() / (1024.0 * 1024.0)) / (ns / 1e9);
+  std::printf("%-48s %14.1f MB/s (%zu bytes, %zu tokens)\n",
+              "lexer/generated", mb_per_s, source.size(), tokens_count);
+}
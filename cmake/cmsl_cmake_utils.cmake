@@ -27,3 +27,33 @@ function(cmsl_add_test)
 
     add_test(NAME ${test_name} COMMAND ${test_name})
 endfunction()
+
+# Benchmarks are not registered in CTest. Run them by hand, preferably with a
+# Release build.
+function(cmsl_add_benchmark)
+    set(options)
+    set(oneValueArgs NAME)
+    set(multiValueArgs SOURCES INCLUDE_DIRS LIBRARIES)
+    cmake_parse_arguments(CMSL_ADD_BENCHMARK "${options}" "${oneValueArgs}"
+            "${multiValueArgs}" ${ARGN} )
+
+    set(benchmark_name ${CMSL_ADD_BENCHMARK_NAME}_cmakesl_benchmark)
+
+    add_executable(${benchmark_name} ${CMSL_ADD_BENCHMARK_SOURCES})
+
+    target_link_libraries(${benchmark_name}
+        PRIVATE
+            gmock
+            ${CMSL_ADD_BENCHMARK_LIBRARIES}
+    )
+
+    target_include_directories(${benchmark_name}
+        PRIVATE
+            ${CMSL_ADD_BENCHMARK_INCLUDE_DIRS}
+    )
+
+    target_compile_options(${benchmark_name}
+        PRIVATE
+            ${CMAKESL_ADDITIONAL_COMPILER_FLAGS}
+    )
+endfunction()
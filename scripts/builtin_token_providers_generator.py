@@ -24,31 +24,21 @@ TOKENS_PROVIDER_TEMPLATE = """
 class %type_name%_tokens_provider
 {
 public:
-    explicit %type_name%_tokens_provider(std::optional<cmsl::string_view> path_to_documentation)
-        : m_path_to_documentation{ path_to_documentation }
+    explicit %type_name%_tokens_provider(const source_info& documentation)
+        : m_source{ documentation }
     {}
     
     %methods%
 
 private:
-    source_view get_source_view() const
-    {
-        return m_path_to_documentation.has_value()
-            ? source_view{ *m_path_to_documentation, %type_name%_documentation_source }
-            : source_view{ %type_name%_documentation_source };
-    }
-    
-private:
-    std::optional<cmsl::string_view> m_path_to_documentation;
+    source_view m_source;
 };
 """
 
 TOKEN_PROVIDER_METHOD_TEMPLATE = """
     lexer::token %token_name%() const
     {
-        const auto src_range = source_range{ source_location{ %line%, %column%, %absolute_position% },
-                                             source_location{ %line%, %column% + %token_length%, %absolute_position% + %token_length% } };
-        return lexer::token{ lexer::token_type::%token_type%, src_range, get_source_view()};
+        return lexer::token{ lexer::token_type::%token_type%, m_source, %absolute_position%, %token_length% };
     }
 """
 
@@ -221,7 +211,9 @@ GENERATION_INFO = {
             'size': ['int size();', 'int ', 'size'],
             'empty': ['bool empty();', 'bool ', 'empty'],
             'find_value': ['int find(value_type value);', 'int ', 'find'],
-            'find_value_pos': ['int find(value_type value, int position);', 'int ', 'find']
+            'find_value_pos': ['int find(value_type value, int position);', 'int ', 'find'],
+            'contains_value': ['bool contains(value_type value);', 'bool ', 'contains'],
+            'unique': ['int unique();', 'int ', 'unique']
         }
     },
     'extern': {
@@ -354,18 +346,6 @@ def find_absolute(documentation_content, to_search, to_skip):
     return token_absolute_position
 
 
-def find_line_and_column(documentation_content, to_search, to_skip):
-    lines = documentation_content.splitlines()
-    line_no = 0
-    for line in lines:
-        line_no = line_no + 1
-        if to_search in line:
-            column = line.find(to_search) + len(to_skip)
-            return line_no, column
-
-    return None
-
-
 def generate_providers():
     print('Generating providers...')
 
@@ -391,11 +371,8 @@ def generate_providers():
             token_value = token_search_info[2]
             token_type = token_search_info[3] if len(token_search_info) > 3 else 'identifier'
             token_absolute_position = find_absolute(type_documentation, to_search, to_skip)
-            token_line, token_column = find_line_and_column(type_documentation, to_search, to_skip)
             token_length = len(token_value)
             method_source = method_source.replace('%absolute_position%', str(token_absolute_position))
-            method_source = method_source.replace('%line%', str(token_line))
-            method_source = method_source.replace('%column%', str(token_column))
             method_source = method_source.replace('%token_length%', str(token_length))
             method_source = method_source.replace('%token_type%', str(token_type))
 
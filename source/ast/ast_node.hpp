@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/nodes_arena.hpp"
 #include "lexer/token.hpp"
 
 namespace cmsl {
@@ -15,6 +16,16 @@ public:
 
   virtual ~ast_node() {}
 
+  // Nodes are allocated in the current nodes_arena, if there is one.
+  static void* operator new(std::size_t size)
+  {
+    return nodes_arena::allocate_node(size);
+  }
+  static void operator delete(void* node)
+  {
+    nodes_arena::deallocate_node(node);
+  }
+
   virtual void visit(ast_node_visitor& visitor) const = 0;
   virtual source_location begin_location() const = 0;
   virtual source_location end_location() const = 0;
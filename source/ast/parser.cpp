@@ -26,9 +26,69 @@
 #include "errors/error.hpp"
 #include "errors/errors_observer.hpp"
 
-#include <map>
+#include <array>
+#include <initializer_list>
 
 namespace cmsl::ast {
+namespace {
+using token_type_t = lexer::token_type;
+
+constexpr auto k_token_types_count =
+  static_cast<std::size_t>(token_type_t::_keywords_end) + 1u;
+
+// Precedences of binary operators, indexed by token type. Lower value binds
+// tighter. Member access, with precedence 2, is handled separately.
+using precedences_t = std::array<unsigned char, k_token_types_count>;
+
+constexpr void set_precedence(precedences_t& precedences,
+                              std::initializer_list<token_type_t> types,
+                              unsigned char precedence)
+{
+  for (const auto type : types) {
+    precedences[static_cast<std::size_t>(type)] = precedence;
+  }
+}
+
+constexpr precedences_t create_binary_operator_precedences()
+{
+  precedences_t precedences{};
+  set_precedence(precedences, { token_type_t::exclaim }, 3u);
+  set_precedence(
+    precedences,
+    { token_type_t::star, token_type_t::slash, token_type_t::percent }, 5u);
+  set_precedence(precedences, { token_type_t::plus, token_type_t::minus }, 6u);
+  set_precedence(precedences,
+                 { token_type_t::less, token_type_t::lessequal,
+                   token_type_t::greater, token_type_t::greaterequal },
+                 9u);
+  set_precedence(precedences,
+                 { token_type_t::equalequal, token_type_t::exclaimequal },
+                 10u);
+  set_precedence(precedences, { token_type_t::amp }, 11u);
+  set_precedence(precedences, { token_type_t::xor_ }, 12u);
+  set_precedence(precedences, { token_type_t::pipe }, 13u);
+  set_precedence(precedences, { token_type_t::ampamp }, 14u);
+  set_precedence(precedences, { token_type_t::pipepipe }, 15u);
+  set_precedence(precedences,
+                 { token_type_t::equal, token_type_t::plusequal,
+                   token_type_t::minusequal, token_type_t::starequal,
+                   token_type_t::slashequal, token_type_t::ampequal,
+                   token_type_t::xorequal, token_type_t::pipeequal },
+                 16u);
+  return precedences;
+}
+
+constexpr auto k_binary_operator_precedences =
+  create_binary_operator_precedences();
+
+constexpr auto k_not_binary_operator = 0u;
+
+unsigned binary_operator_precedence(token_type_t type)
+{
+  return k_binary_operator_precedences[static_cast<std::size_t>(type)];
+}
+}
+
 parser::parser(errors::errors_observer& err_observer,
                strings_container& strings_container, cmsl::source_view source,
                const token_container_t& tokens)
@@ -490,95 +550,64 @@ std::optional<parser::token_t> parser::eat_function_call_name()
 
 std::unique_ptr<ast_node> parser::parse_operator(unsigned precedence)
 {
-  static const std::map<unsigned, std::vector<token_type_t>> operators{
-    { 2, { token_type_t::dot } },
-    { 3, { token_type_t::exclaim } },
-    { 5, { token_type_t::star, token_type_t::slash, token_type_t::percent } },
-    { 6, { token_type_t::plus, token_type_t::minus } },
-    { 9,
-      { token_type_t::less, token_type_t::lessequal, token_type_t::greater,
-        token_type_t::greaterequal } },
-    { 10, { token_type_t::equalequal, token_type_t::exclaimequal } },
-    { 11, { token_type_t::amp } },
-    { 12, { token_type_t::xor_ } },
-    { 13, { token_type_t::pipe } },
-    { 14, { token_type_t::ampamp } },
-    { 15, { token_type_t::pipepipe } },
-    { 16,
-      { token_type_t::equal, token_type_t::plusequal, token_type_t::minusequal,
-        token_type_t::starequal, token_type_t::slashequal,
-        token_type_t::ampequal, token_type_t::xorequal,
-        token_type_t::pipeequal } }
-  };
-
-  const auto is_current_same_precedence_operator =
-    [current_precedence = precedence, this] {
-      const auto found = operators.find(current_precedence);
-      if (found == std::cend(operators)) {
-        return false;
-      }
-
-      const auto& ops = found->second;
+  auto f = parse_member_access_or_factor();
+  if (!f) {
+    return nullptr;
+  }
 
-      return contains(ops, curr_type());
-    };
+  while (!is_at_end()) {
+    const auto op_precedence = binary_operator_precedence(curr_type());
+    if (op_precedence == k_not_binary_operator ||
+        op_precedence > precedence) {
+      break;
+    }
 
-  const auto get_next_precedence = [current_precedence = precedence] {
-    const auto found = operators.find(current_precedence);
-    const auto higher_precedence_it = std::prev(found);
-    return higher_precedence_it->first;
-  };
+    const auto op = current();
+    eat(); // eat operator
 
-  if (precedence == k_min_precedence) {
-    auto f = parse_factor();
-    if (!f) {
+    // All the operators are left associative, so rhs takes only operators
+    // that bind tighter.
+    auto rhs = parse_operator(op_precedence - 1u);
+    if (!rhs) {
       return nullptr;
     }
 
-    while (!is_at_end() && is_current_same_precedence_operator()) {
-      const auto dot = eat(); // dot
-      auto lhs = std::move(f);
-      if (current_is_class_member_access()) {
-        const auto member_name = eat();
-        f = std::make_unique<class_member_access_node>(std::move(lhs), *dot,
-                                                       *member_name);
-      } else // class member function call
-      {
-        auto vals = get_member_function_call_values();
-        if (!vals) {
-          return nullptr;
-        }
-
-        f = std::make_unique<member_function_call_node>(
-          std::move(lhs), *dot, vals->name, vals->open_paren,
-          std::move(vals->params), vals->close_paren);
-      }
-    }
+    auto lhs = std::move(f);
+    f = std::make_unique<binary_operator_node>(std::move(lhs), op,
+                                               std::move(rhs));
+  }
 
-    return f;
-  } else {
-    const auto next_precedence = get_next_precedence();
-    auto f = parse_operator(next_precedence);
-    if (!f) {
-      return nullptr;
-    }
+  return f;
+}
 
-    while (!is_at_end() && is_current_same_precedence_operator()) {
-      const auto op = current();
-      eat(); // eat operator
+std::unique_ptr<ast_node> parser::parse_member_access_or_factor()
+{
+  auto f = parse_factor();
+  if (!f) {
+    return nullptr;
+  }
 
-      auto rhs = parse_operator(next_precedence);
-      if (!rhs) {
+  while (!is_at_end() && current_is(token_type_t::dot)) {
+    const auto dot = eat(); // dot
+    auto lhs = std::move(f);
+    if (current_is_class_member_access()) {
+      const auto member_name = eat();
+      f = std::make_unique<class_member_access_node>(std::move(lhs), *dot,
+                                                     *member_name);
+    } else // class member function call
+    {
+      auto vals = get_member_function_call_values();
+      if (!vals) {
         return nullptr;
       }
 
-      auto lhs = std::move(f);
-      f = std::make_unique<binary_operator_node>(std::move(lhs), op,
-                                                 std::move(rhs));
+      f = std::make_unique<member_function_call_node>(
+        std::move(lhs), *dot, vals->name, vals->open_paren,
+        std::move(vals->params), vals->close_paren);
     }
-
-    return f;
   }
+
+  return f;
 }
 
 bool parser::current_is_class_member_access() const
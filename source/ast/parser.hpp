@@ -103,10 +103,11 @@ private:
   bool function_declaration_starts() const;
   bool declaration_starts() const;
 
-  static constexpr auto k_min_precedence{ 2u };
+  // Parses binary operators with given precedence or ones that bind tighter.
   static constexpr auto k_max_precedence{ 16u };
   std::unique_ptr<ast_node> parse_operator(
     unsigned precedence = k_max_precedence);
+  std::unique_ptr<ast_node> parse_member_access_or_factor();
 
   std::unique_ptr<ast_node> fundamental_value();
   std::unique_ptr<ast_node> function_call();
@@ -2,7 +2,146 @@
 #include "common/assert.hpp"
 #include "common/overloaded.hpp"
 
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 namespace cmsl::ast {
+namespace {
+using lexer::symbol_t;
+
+// Ids of names that are more than a single atom, e.g. of foo::bar, list<int>
+// or int&. A name is a key of atoms and ids of its parts, separated by tags.
+// Ids of such names have the highest bit set, so they never collide with
+// atoms, which are ids of single names. Types are created by parsing threads,
+// so the table is synchronized.
+class type_ids_table
+{
+public:
+  static constexpr auto k_coloncolon_tag =
+    std::numeric_limits<symbol_t>::max();
+  static constexpr auto k_qualified_tag = k_coloncolon_tag - 1u;
+  static constexpr auto k_generic_tag = k_coloncolon_tag - 2u;
+  static constexpr auto k_reference_tag = k_coloncolon_tag - 3u;
+
+  using key_t = std::vector<symbol_t>;
+
+  static type_ids_table& instance()
+  {
+    static type_ids_table table;
+    return table;
+  }
+
+  symbol_t id_of(key_t key)
+  {
+    {
+      std::shared_lock<std::shared_mutex> lock{ m_mutex };
+      if (const auto found = m_ids.find(key); found != m_ids.end()) {
+        return found->second;
+      }
+    }
+
+    std::unique_lock<std::shared_mutex> lock{ m_mutex };
+    const auto id = static_cast<symbol_t>(k_first_id + m_ids.size());
+    CMSL_ASSERT_MSG(id < k_reference_tag, "Too many type names");
+    return m_ids.emplace(std::move(key), id).first->second;
+  }
+
+private:
+  static constexpr auto k_first_id = symbol_t{ 1u } << 31u;
+
+  struct key_hash
+  {
+    std::size_t operator()(const key_t& key) const
+    {
+      auto hash = std::size_t{ 0u };
+      for (const auto part : key) {
+        hash ^= std::hash<symbol_t>{}(part) + 0x9e3779b9u + (hash << 6u) +
+          (hash >> 2u);
+      }
+      return hash;
+    }
+  };
+
+  std::shared_mutex m_mutex;
+  std::unordered_map<key_t, symbol_t, key_hash> m_ids;
+};
+
+// Atom of a spelling of a name. Keywords, e.g. int, have no atoms in their
+// tokens, so they're cached per thread, to not lock the symbol table for
+// every builtin type name.
+symbol_t atom_of(const lexer::token& name)
+{
+  const auto type = name.get_type();
+  if (type == lexer::token_type::identifier) {
+    return name.symbol();
+  }
+
+  const auto type_index = static_cast<std::size_t>(type);
+  const auto is_keyword = type > lexer::token_type::_keywords_begin &&
+    type < lexer::token_type::_keywords_end;
+  if (!is_keyword) {
+    return lexer::symbol_table::instance().intern(name.str());
+  }
+
+  using keyword_atoms_t =
+    std::array<std::optional<symbol_t>,
+               static_cast<std::size_t>(lexer::token_type::_keywords_end)>;
+  thread_local keyword_atoms_t keyword_atoms;
+  auto& atom = keyword_atoms[type_index];
+  if (!atom) {
+    atom = lexer::symbol_table::instance().intern(name.str());
+  }
+
+  return *atom;
+}
+
+symbol_t id_of(const qualified_name& name)
+{
+  const auto& names = name.names();
+  if (names.size() == 1u && !names.front().coloncolon) {
+    return atom_of(names.front().name);
+  }
+
+  auto key = type_ids_table::key_t{ type_ids_table::k_qualified_tag };
+  key.reserve(names.size() * 2u + 1u);
+  for (const auto& n : names) {
+    key.emplace_back(atom_of(n.name));
+    if (n.coloncolon) {
+      key.emplace_back(type_ids_table::k_coloncolon_tag);
+    }
+  }
+
+  return type_ids_table::instance().id_of(std::move(key));
+}
+
+symbol_t id_of(const type_representation::generic_type_name& name)
+{
+  auto key = type_ids_table::key_t{ type_ids_table::k_generic_tag,
+                                    atom_of(name.primary_name()) };
+  key.reserve(name.nested_types.size() + 2u);
+  for (const auto& nested : name.nested_types) {
+    key.emplace_back(nested.id());
+  }
+
+  return type_ids_table::instance().id_of(std::move(key));
+}
+
+template <typename Name>
+symbol_t id_of_name(const Name& name)
+{
+  return std::visit([](const auto& n) { return id_of(n); }, name);
+}
+
+symbol_t reference_id_of(symbol_t id)
+{
+  return type_ids_table::instance().id_of(
+    { type_ids_table::k_reference_tag, id });
+}
+}
 // type_representation::type_representation(
 //  qualified_name_t qualified_name,
 //  lexer::token primary_name, lexer::token reference_token,
@@ -80,30 +219,31 @@ type_representation::type_representation(lexer::token name,
 }
 
 type_representation::type_representation(qualified_name name)
-  : m_name{ std::move(name) }
+  : type_representation{ name_t{ std::move(name) } }
 {
 }
 
-type_representation::type_representation(qualified_name name, is_reference_tag)
-  : m_name{ std::move(name) }
-  , m_is_reference{ true }
+type_representation::type_representation(qualified_name name,
+                                         is_reference_tag tag)
+  : type_representation{ name_t{ std::move(name) }, tag }
 {
 }
 
 type_representation::type_representation(generic_type_name name)
-  : m_name{ std::move(name) }
+  : type_representation{ name_t{ std::move(name) } }
 {
 }
 
 type_representation::type_representation(generic_type_name name,
-                                         is_reference_tag)
-  : m_name{ std::move(name) }
-  , m_is_reference{ true }
+                                         is_reference_tag tag)
+  : type_representation{ name_t{ std::move(name) }, tag }
 {
 }
 
 type_representation::type_representation(type_representation::name_t name)
   : m_name{ std::move(name) }
+  , m_id_without_reference{ id_of_name(m_name) }
+  , m_id{ m_id_without_reference }
 {
 }
 
@@ -111,6 +251,8 @@ type_representation::type_representation(type_representation::name_t name,
                                          type_representation::is_reference_tag)
   : m_name{ std::move(name) }
   , m_is_reference{ true }
+  , m_id_without_reference{ id_of_name(m_name) }
+  , m_id{ reference_id_of(m_id_without_reference) }
 {
 }
 
@@ -161,13 +303,23 @@ std::string type_representation::to_string_without_reference() const
   return std::visit(visitor, m_name);
 }
 
+lexer::symbol_t type_representation::id() const
+{
+  return m_id;
+}
+
+lexer::symbol_t type_representation::id_without_reference() const
+{
+  return m_id_without_reference;
+}
+
 bool type_representation::operator==(const type_representation& rhs) const
 {
-  // For now, we need to compare strings because when we execute
+  // For now, we need to compare names because when we execute
   // add_subdirectory, a new builtin context is created there. Because of that,
   // we have two instances representing e.g. int type. That should be fixed at
   // some point.
-  return this == &rhs || to_string() == rhs.to_string();
+  return this == &rhs || id() == rhs.id();
 }
 
 bool type_representation::operator!=(const type_representation& rhs) const
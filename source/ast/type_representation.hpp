@@ -68,6 +68,14 @@ public:
   std::string to_string() const;
   std::string to_string_without_reference() const;
 
+  // Canonical id of the name. It's the same for all the representations
+  // spelled the same way, e.g. each list<list<string>>, so they're compared
+  // and hashed as integers. It's computed on construction from atoms of the
+  // names and ids of the nested types.
+  lexer::symbol_t id() const;
+  // Id of the same name without the reference, e.g. of int for int&.
+  lexer::symbol_t id_without_reference() const;
+
   bool operator==(const type_representation& rhs) const;
   bool operator!=(const type_representation& rhs) const;
 
@@ -82,6 +90,8 @@ private:
   name_t m_name;
   std::optional<lexer::token> m_reference_token;
   bool m_is_reference{ false };
+  lexer::symbol_t m_id_without_reference;
+  lexer::symbol_t m_id;
 };
 }
 
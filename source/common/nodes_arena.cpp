@@ -0,0 +1,88 @@
+#include "common/nodes_arena.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace cmsl {
+namespace {
+thread_local nodes_arena* current_arena{ nullptr };
+
+// Every node is preceded by a header that tells whether it lives in an arena,
+// because a node can be deleted on another thread than the one that created
+// it.
+struct node_header
+{
+  bool in_arena;
+};
+
+constexpr std::size_t align(std::size_t size)
+{
+  constexpr auto alignment = alignof(std::max_align_t);
+  return (size + alignment - 1u) / alignment * alignment;
+}
+
+constexpr auto k_header_size = align(sizeof(node_header));
+}
+
+nodes_arena::scope::scope(nodes_arena& arena)
+  : m_previous{ current_arena }
+{
+  current_arena = &arena;
+}
+
+nodes_arena::scope::~scope()
+{
+  current_arena = m_previous;
+}
+
+void* nodes_arena::allocate_node(std::size_t size)
+{
+  const auto total_size = k_header_size + size;
+  auto memory = current_arena
+    ? static_cast<unsigned char*>(current_arena->allocate(total_size))
+    : static_cast<unsigned char*>(::operator new(total_size));
+
+  new (memory) node_header{ current_arena != nullptr };
+  return memory + k_header_size;
+}
+
+void nodes_arena::deallocate_node(void* node)
+{
+  if (node == nullptr) {
+    return;
+  }
+
+  auto memory = static_cast<unsigned char*>(node) - k_header_size;
+  if (!reinterpret_cast<node_header*>(memory)->in_arena) {
+    ::operator delete(memory);
+  }
+}
+
+void* nodes_arena::allocate(std::size_t size)
+{
+  size = align(size);
+
+  ++m_stats.nodes_allocated;
+  m_stats.bytes_allocated += size;
+
+  if (size > m_left) {
+    // Bigger nodes get a block of their own, so that the current block is
+    // not wasted.
+    const auto block_size = std::max(size, k_block_size);
+    auto& block = m_blocks.emplace_back(new unsigned char[block_size]);
+    ++m_stats.blocks_allocated;
+
+    if (block_size > k_block_size) {
+      return block.get();
+    }
+
+    m_current = block.get();
+    m_left = block_size;
+  }
+
+  const auto result = m_current;
+  m_current += size;
+  m_left -= size;
+  return result;
+}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace cmsl {
+// Memory for AST and sema nodes of one translation unit. While an arena is
+// installed with a scope, nodes created on the same thread are bump
+// allocated in its blocks, so a tree is laid out close to the order in which
+// it is built and walked. Deleting a node only runs its destructor. The
+// memory is given back all at once, when the arena is destroyed, so the
+// arena has to outlive all the nodes allocated in it.
+//
+// Nodes created without an installed arena are allocated on the heap, as
+// usual.
+class nodes_arena
+{
+public:
+  struct statistics
+  {
+    std::size_t nodes_allocated{ 0u };
+    std::size_t bytes_allocated{ 0u };
+    std::size_t blocks_allocated{ 0u };
+  };
+
+  // Installs an arena as the current one of this thread, till the end of
+  // the scope. Scopes can be nested.
+  class scope
+  {
+  public:
+    explicit scope(nodes_arena& arena);
+    ~scope();
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+  private:
+    nodes_arena* m_previous;
+  };
+
+  nodes_arena() = default;
+  ~nodes_arena() = default;
+
+  nodes_arena(const nodes_arena&) = delete;
+  nodes_arena& operator=(const nodes_arena&) = delete;
+
+  const statistics& stats() const { return m_stats; }
+
+  // To be used by operator new and delete of node classes.
+  static void* allocate_node(std::size_t size);
+  static void deallocate_node(void* node);
+
+private:
+  static constexpr auto k_block_size = std::size_t{ 64u * 1024u };
+
+  void* allocate(std::size_t size);
+
+private:
+  std::vector<std::unique_ptr<unsigned char[]>> m_blocks;
+  unsigned char* m_current{ nullptr };
+  std::size_t m_left{ 0u };
+  statistics m_stats;
+};
+}
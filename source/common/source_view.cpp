@@ -1,7 +1,73 @@
 #include "common/source_view.hpp"
-#include "source_view.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace cmsl {
+namespace {
+std::vector<unsigned> find_new_lines(cmsl::string_view source)
+{
+  std::vector<unsigned> new_lines;
+  for (auto pos = source.find('\n', 1u); pos != cmsl::string_view::npos;
+       pos = source.find('\n', pos + 1u)) {
+    new_lines.push_back(static_cast<unsigned>(pos));
+  }
+  return new_lines;
+}
+
+struct unowned_key
+{
+  const char* path;
+  std::size_t path_size;
+  const char* source;
+  std::size_t source_size;
+
+  bool operator==(const unowned_key& rhs) const
+  {
+    return path == rhs.path && path_size == rhs.path_size &&
+      source == rhs.source && source_size == rhs.source_size;
+  }
+};
+
+struct unowned_key_hash
+{
+  std::size_t operator()(const unowned_key& k) const
+  {
+    const auto h = std::hash<const char*>{};
+    return h(k.source) ^ (h(k.path) << 1u) ^ (k.source_size << 2u);
+  }
+};
+}
+
+source_info::source_info(cmsl::string_view source)
+  : source_info("<unknown source>", source)
+{
+}
+
+source_info::source_info(cmsl::string_view source_path,
+                         cmsl::string_view source)
+  : m_path{ source_path }
+  , m_source{ source }
+  , m_has_line_table{ true }
+  , m_new_lines{ find_new_lines(source) }
+{
+}
+
+source_info::source_info(unowned_tag, cmsl::string_view source_path,
+                         cmsl::string_view source)
+  : m_path{ source_path }
+  , m_source{ source }
+  , m_has_line_table{ false }
+{
+}
+
+source_view::source_view(const source_info& info)
+  : m_info{ &info }
+{
+}
+
 source_view::source_view(cmsl::string_view source)
   : source_view("<unknown source>", source)
 {
@@ -9,59 +75,128 @@ source_view::source_view(cmsl::string_view source)
 
 source_view::source_view(cmsl::string_view source_path,
                          cmsl::string_view source)
-  : m_path{ source_path }
-  , m_source{ source }
+  : m_info{ &unowned_info(source_path, source) }
+{
+}
+
+const source_info& source_view::unowned_info(cmsl::string_view path,
+                                             cmsl::string_view source)
 {
+  // Texts without an owner are mostly string literals, so there are few of
+  // them and their infos are never freed. Infos are found by addresses and
+  // sizes of a path and a text. An info has no line table, so it stays
+  // correct when another text of the same size lands at the same address.
+  static std::mutex infos_mutex;
+  static std::unordered_map<unowned_key, std::unique_ptr<source_info>,
+                            unowned_key_hash>
+    infos;
+  // Views of the same literals are created over and over, e.g. for tokens
+  // made by sema, so lookups are cached per thread, without locking.
+  thread_local std::unordered_map<unowned_key, const source_info*,
+                                  unowned_key_hash>
+    cached_infos;
+
+  const auto key =
+    unowned_key{ path.data(), path.size(), source.data(), source.size() };
+  if (const auto found = cached_infos.find(key);
+      found != std::cend(cached_infos)) {
+    return *found->second;
+  }
+
+  std::lock_guard<std::mutex> lock{ infos_mutex };
+  auto& info = infos[key];
+  if (!info) {
+    info.reset(new source_info{ source_info::unowned_tag{}, path, source });
+  }
+
+  cached_infos.emplace(key, info.get());
+  return *info;
+}
+
+const std::vector<unsigned>& source_view::new_lines(
+  std::vector<unsigned>& scanned) const
+{
+  if (m_info->m_has_line_table) {
+    return m_info->m_new_lines;
+  }
+
+  scanned = find_new_lines(m_info->m_source);
+  return scanned;
 }
 
 cmsl::string_view source_view::path() const
 {
-  return m_path;
+  return m_info->m_path;
 }
 
 cmsl::string_view source_view::source() const
 {
-  return m_source;
+  return m_info->m_source;
 }
 
 source_view::line_info source_view::line(unsigned line_no) const
 {
-  unsigned counter{ 1u };
+  const auto& source = m_info->m_source;
+  std::vector<unsigned> scanned;
+  const auto& new_lines = this->new_lines(scanned);
 
+  // The line starts after the new line that ends the previous one. The first
+  // line is treated as if it started after a new line at position 0.
   auto pos = cmsl::string_view::size_type{ 0u };
-
-  while (counter < line_no) {
-    pos = m_source.find('\n', pos + 1);
-    if (pos == cmsl::string_view::npos) {
+  if (line_no > 1u) {
+    const auto new_line_index = line_no - 2u;
+    if (new_line_index >= new_lines.size()) {
       return { "", 0 };
     }
-
-    ++counter;
+    pos = new_lines[new_line_index];
   }
 
-  const auto line_end = [pos, source = m_source] {
-    const auto p = source.find('\n', pos + 1);
-    return p != cmsl::string_view::npos ? p : source.size();
+  const auto line_begin = std::min(pos + 1u, source.size());
+  const auto line_end = [&] {
+    const auto next =
+      std::upper_bound(std::cbegin(new_lines), std::cend(new_lines), pos);
+    return next != std::cend(new_lines) ? *next : source.size();
   }();
 
-  const auto line_size = line_end - (pos + 1);
-  const auto line_begin = std::next(m_source.data(), pos + 1);
+  const auto line_size = std::max(line_end, line_begin) - line_begin;
+  return { source.substr(line_begin, line_size), pos + 1 };
+}
+
+source_location source_view::location(unsigned absolute) const
+{
+  const auto& source = m_info->m_source;
+  std::vector<unsigned> scanned;
+  const auto& new_lines = this->new_lines(scanned);
+
+  // At the end of the source, line and column are the ones of the last char.
+  const auto char_pos = (absolute >= source.size() && !source.empty())
+    ? static_cast<unsigned>(source.size() - 1u)
+    : absolute;
+
+  const auto after_last_new_line =
+    std::upper_bound(std::cbegin(new_lines), std::cend(new_lines), char_pos);
+  const auto new_lines_before = static_cast<unsigned>(
+    std::distance(std::cbegin(new_lines), after_last_new_line));
+
+  const auto column = new_lines_before == 0u
+    ? char_pos + 1u
+    : char_pos - *std::prev(after_last_new_line) + 1u;
 
-  return { cmsl::string_view{ line_begin, line_size }, pos + 1 };
+  return source_location{ new_lines_before + 1u, column, absolute };
 }
 
 cmsl::string_view::const_iterator source_view::cbegin() const
 {
-  return std::cbegin(m_source);
+  return std::cbegin(m_info->m_source);
 }
 
 cmsl::string_view::const_iterator source_view::cend() const
 {
-  return std::cend(m_source);
+  return std::cend(m_info->m_source);
 }
 
 cmsl::string_view::const_pointer source_view::cdata() const
 {
-  return m_source.data();
+  return m_info->m_source.data();
 }
 }
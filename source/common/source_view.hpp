@@ -1,8 +1,46 @@
 #pragma once
 
+#include "common/source_location.hpp"
 #include "common/string.hpp"
 
+#include <vector>
+
 namespace cmsl {
+// Path and text of a source, with a table of new line positions, so that
+// locations in the source are found in O(log n). It's created once per
+// source by the owner of the source text, e.g. by the executor that loaded
+// it, and has to outlive views of the source and tokens lexed from it.
+class source_info
+{
+public:
+  explicit source_info(cmsl::string_view source);
+  explicit source_info(cmsl::string_view source_path,
+                       cmsl::string_view source);
+
+  source_info(const source_info&) = delete;
+  source_info& operator=(const source_info&) = delete;
+
+private:
+  friend class source_view;
+
+  struct unowned_tag
+  {
+  };
+
+  // Info of a text without an owner. It has no line table.
+  explicit source_info(unowned_tag, cmsl::string_view source_path,
+                       cmsl::string_view source);
+
+  cmsl::string_view m_path;
+  cmsl::string_view m_source;
+  bool m_has_line_table;
+  // Positions of new line chars. A new line at position 0 doesn't start a
+  // new line, the same as in the lexer.
+  std::vector<unsigned> m_new_lines;
+};
+
+// A view of a source and its path. It's a pointer to the info of the source,
+// so copying a view is cheap.
 class source_view
 {
 public:
@@ -12,6 +50,11 @@ public:
     cmsl::string_view::size_type start_pos;
   };
 
+  explicit source_view(const source_info& info);
+
+  // Views of texts that have no owner to keep their info, e.g. of string
+  // literals. The text has to outlive the view. Locations are found by
+  // scanning the text, so it should be short.
   explicit source_view(cmsl::string_view source);
   explicit source_view(cmsl::string_view source_path,
                        cmsl::string_view source);
@@ -26,8 +69,20 @@ public:
   // Line numbers start from 1, not 0.
   line_info line(unsigned line_no) const;
 
+  // Location of a char at given absolute position. Position equal to the
+  // source size is the end of the source, which has line and column of the
+  // last char, the same as the lexer reports.
+  source_location location(unsigned absolute) const;
+
 private:
-  cmsl::string_view m_path;
-  cmsl::string_view m_source;
+  static const source_info& unowned_info(cmsl::string_view path,
+                                         cmsl::string_view source);
+
+  // Returns the line table of the source, or scans the source into scanned
+  // if it has none.
+  const std::vector<unsigned>& new_lines(
+    std::vector<unsigned>& scanned) const;
+
+  const source_info* m_info;
 };
 }
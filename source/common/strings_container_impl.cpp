@@ -5,6 +5,7 @@ cmsl::string_view strings_container_impl::store(std::string str)
 {
   auto str_ptr = std::make_unique<std::string>(std::move(str));
   cmsl::string_view view = *str_ptr;
+  std::lock_guard<std::mutex> lock{ m_mutex };
   m_strings.emplace_back(std::move(str_ptr));
   return view;
 }
@@ -3,10 +3,13 @@
 #include "common/strings_container.hpp"
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace cmsl {
+// Strings can be stored concurrently, e.g. by parsers running on worker
+// threads.
 class strings_container_impl : public strings_container
 {
 public:
@@ -14,5 +17,6 @@ public:
 
 private:
   std::vector<std::unique_ptr<std::string>> m_strings;
+  std::mutex m_mutex;
 };
 }
@@ -40,8 +40,21 @@ errors_observer::errors_observer(std::ostream& out)
 {
 }
 
+errors_observer::errors_observer(defer_errors_t)
+  : m_deferring{ true }
+{
+}
+
 void errors_observer::notify_error(const error& error)
 {
+  ++m_notified_count;
+
+  std::lock_guard<std::mutex> lock{ m_mutex };
+  if (m_deferring) {
+    m_deferred_errors.push_back(error);
+    return;
+  }
+
   const auto str = format_error(error);
   if (m_facade != nullptr) {
     m_facade->error(str);
@@ -50,6 +63,24 @@ void errors_observer::notify_error(const error& error)
   }
 }
 
+void errors_observer::forward_deferred_errors(errors_observer& observer)
+{
+  std::vector<error> errors;
+  {
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    errors.swap(m_deferred_errors);
+  }
+
+  for (const auto& err : errors) {
+    observer.notify_error(err);
+  }
+}
+
+std::size_t errors_observer::notified_count() const
+{
+  return m_notified_count;
+}
+
 std::string errors_observer::format_error(const error& err) const
 {
   std::stringstream ss;
@@ -1,6 +1,11 @@
 #pragma once
 
+#include "errors/error.hpp"
+
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace cmsl {
 namespace facade {
@@ -8,22 +13,42 @@ class cmake_facade;
 }
 
 namespace errors {
-struct error;
-
 class errors_observer
 {
 public:
+  struct defer_errors_t
+  {
+  };
+  static constexpr defer_errors_t defer_errors{};
+
   explicit errors_observer(std::ostream& out);
   explicit errors_observer(facade::cmake_facade* facade = nullptr);
 
+  // Errors notified to such observer are not reported, but kept till they
+  // are forwarded to another observer. It allows to process a source ahead
+  // of time, e.g. on a worker thread, and report its errors only if and when
+  // the source is really used.
+  explicit errors_observer(defer_errors_t);
+
+  // Can be called concurrently.
   void notify_error(const error& error);
 
+  void forward_deferred_errors(errors_observer& observer);
+
+  // Count of all the errors, warnings and notes notified so far, including
+  // the deferred ones.
+  std::size_t notified_count() const;
+
 private:
   std::string format_error(const error& err) const;
 
 private:
   facade::cmake_facade* m_facade{ nullptr };
   std::ostream* m_out{ nullptr };
+  bool m_deferring{ false };
+  std::vector<error> m_deferred_errors;
+  std::atomic<std::size_t> m_notified_count{ 0u };
+  std::mutex m_mutex;
 };
 }
 }
@@ -15,15 +15,15 @@
 #include <algorithm>
 #include <sema/homogeneous_generic_type.hpp>
 
-#define CASE_BUILTIN_MEMBER_FUNCTION_CALL(function)                           \
-  case sema::builtin_function_kind::function: {                               \
-    result = function(instance, params);                                      \
-  } break
+#define ADD_BUILTIN_MEMBER_FUNCTION(function)                                 \
+  member_functions[static_cast<std::size_t>(                                  \
+    sema::builtin_function_kind::function)] =                                 \
+    &builtin_function_caller::function
 
-#define CASE_BUILTIN_FUNCTION_CALL(function)                                  \
-  case sema::builtin_function_kind::function: {                               \
-    result = function(params);                                                \
-  } break
+#define ADD_BUILTIN_FUNCTION(function)                                        \
+  functions[static_cast<std::size_t>(                                         \
+    sema::builtin_function_kind::function)] =                                 \
+    &builtin_function_caller::function
 
 namespace cmsl::exec {
 template <auto... Alternatives, typename Params>
@@ -47,247 +47,270 @@ builtin_function_caller::builtin_function_caller(
 {
 }
 
-std::unique_ptr<inst::instance> builtin_function_caller::call_member(
-  inst::instance& instance, sema::builtin_function_kind function_kind,
-  const params_t& params)
+// Maps every builtin function kind to the function implementing it, so a
+// call is an index into a table and one indirect call. The table is
+// constant initialized, there is no run time setup.
+struct builtin_function_caller::dispatch_table
 {
-  inst::instance* result{ nullptr };
+  using member_function_t = inst::instance* (builtin_function_caller::*)(
+    inst::instance&, const params_t&);
+  using function_t =
+    inst::instance* (builtin_function_caller::*)(const params_t&);
+
+  static constexpr auto size =
+    static_cast<std::size_t>(sema::builtin_function_kind::count);
 
-  switch (function_kind) {
+  constexpr dispatch_table()
+  {
     // bool
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_ctor);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_ctor_bool);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_ctor_int);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_operator_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_operator_equal_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_operator_pipe_pipe);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_operator_amp_amp);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_operator_unary_exclaim);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(bool_to_string);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_ctor);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_ctor_bool);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_ctor_int);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_operator_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_operator_equal_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_operator_pipe_pipe);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_operator_amp_amp);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_operator_unary_exclaim);
+    ADD_BUILTIN_MEMBER_FUNCTION(bool_to_string);
 
     // int
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_ctor);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_ctor_bool);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_ctor_int);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_ctor_double);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_plus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_unary_plusplus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_minus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_unary_minus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_unary_minusminus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_star);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_slash);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_plus_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_minus_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_star_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_slash_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_less);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_less_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_greater);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_greater_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_operator_equal_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(int_to_string);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_ctor);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_ctor_bool);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_ctor_int);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_ctor_double);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_plus);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_unary_plusplus);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_minus);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_unary_minus);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_unary_minusminus);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_star);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_slash);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_plus_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_minus_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_star_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_slash_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_less);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_less_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_greater);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_greater_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_operator_equal_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(int_to_string);
 
     // double
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_ctor);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_ctor_double);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_ctor_int);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_plus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_unary_plusplus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_minus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_unary_minus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_unary_minusminus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_star);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_slash);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_plus_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_minus_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_star_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_slash_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_less);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_less_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_greater);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(double_operator_greater_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_ctor);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_ctor_double);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_ctor_int);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_plus);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_unary_plusplus);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_minus);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_unary_minus);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_unary_minusminus);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_star);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_slash);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_plus_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_minus_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_star_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_slash_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_less);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_less_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_greater);
+    ADD_BUILTIN_MEMBER_FUNCTION(double_operator_greater_equal);
 
     // string
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_ctor);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_ctor_string);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_ctor_string_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_empty);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_size);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_equal_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_not_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_less);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_less_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_greater);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_greater_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_plus);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_plus_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_slash);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_operator_slash_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_clear);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_insert_pos_str);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_erase_pos);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_erase_pos_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_starts_with);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_ends_with);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_replace_pos_count_str);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_substr_pos);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_substr_pos_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_resize_newsize);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_resize_newsize_fill);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_find_str);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_find_str_pos);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_find_not_of_str);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_find_not_of_str_pos);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_find_last_str);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_find_last_not_of_str);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_contains);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_lower);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_make_lower);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_upper);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(string_make_upper);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_ctor);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_ctor_string);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_ctor_string_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_empty);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_size);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_equal_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_not_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_less);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_less_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_greater);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_greater_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_plus);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_plus_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_slash);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_operator_slash_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_clear);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_insert_pos_str);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_erase_pos);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_erase_pos_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_starts_with);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_ends_with);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_replace_pos_count_str);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_substr_pos);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_substr_pos_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_resize_newsize);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_resize_newsize_fill);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_find_str);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_find_str_pos);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_find_not_of_str);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_find_not_of_str_pos);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_find_last_str);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_find_last_not_of_str);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_contains);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_lower);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_make_lower);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_upper);
+    ADD_BUILTIN_MEMBER_FUNCTION(string_make_upper);
 
     // version
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_ctor_major);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_ctor_major_minor);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_ctor_major_minor_patch);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_ctor_major_minor_patch_tweak);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_operator_equal_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_operator_not_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_operator_less);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_operator_less_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_operator_greater);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_operator_greater_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_major);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_minor);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_patch);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_tweak);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(version_to_string);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_ctor_major);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_ctor_major_minor);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_ctor_major_minor_patch);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_ctor_major_minor_patch_tweak);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_operator_equal_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_operator_not_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_operator_less);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_operator_less_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_operator_greater);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_operator_greater_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_major);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_minor);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_patch);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_tweak);
+    ADD_BUILTIN_MEMBER_FUNCTION(version_to_string);
 
     // extern
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(extern_constructor_name);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(extern_has_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(extern_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(extern_constructor_name);
+    ADD_BUILTIN_MEMBER_FUNCTION(extern_has_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(extern_value);
 
     // list
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_ctor);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_ctor_list);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_ctor_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_ctor_value_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_push_back_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_push_back_list);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_push_front_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_push_front_list);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_pop_back);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_pop_front);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_at);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_front);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_back);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_insert_pos_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_insert_pos_list);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_erase_pos);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_erase_pos_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_remove_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_remove_value_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_remove_last_value_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_clear);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_resize);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_sort);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_reverse);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_min);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_max);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_sublist_pos);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_sublist_pos_count);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_size);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_empty);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_find_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_find_value_pos);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_operator_plus_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_operator_plus_list);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_operator_plus_equal_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(list_operator_plus_equal_list);
-
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(project_ctor_name);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(project_name);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(project_add_executable);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(project_add_library);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(project_find_library);
-
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(library_name);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(library_link_to);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(library_link_to_visibility);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(library_include_directories);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(library_include_directories_visibility);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(library_compile_definitions);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(library_compile_definitions_visibility);
-
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(executable_name);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(executable_link_to);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(executable_link_to_visibility);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(executable_include_directories);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(
+    ADD_BUILTIN_MEMBER_FUNCTION(list_ctor);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_ctor_list);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_ctor_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_ctor_value_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_push_back_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_push_back_list);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_push_front_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_push_front_list);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_pop_back);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_pop_front);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_at);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_front);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_back);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_insert_pos_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_insert_pos_list);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_erase_pos);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_erase_pos_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_remove_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_remove_value_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_remove_last_value_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_clear);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_resize);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_sort);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_reverse);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_min);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_max);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_sublist_pos);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_sublist_pos_count);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_size);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_empty);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_find_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_find_value_pos);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_contains_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_unique);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_operator_plus_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_operator_plus_list);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_operator_plus_equal_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(list_operator_plus_equal_list);
+
+    ADD_BUILTIN_MEMBER_FUNCTION(project_ctor_name);
+    ADD_BUILTIN_MEMBER_FUNCTION(project_name);
+    ADD_BUILTIN_MEMBER_FUNCTION(project_add_executable);
+    ADD_BUILTIN_MEMBER_FUNCTION(project_add_library);
+    ADD_BUILTIN_MEMBER_FUNCTION(project_find_library);
+
+    ADD_BUILTIN_MEMBER_FUNCTION(library_name);
+    ADD_BUILTIN_MEMBER_FUNCTION(library_link_to);
+    ADD_BUILTIN_MEMBER_FUNCTION(library_link_to_visibility);
+    ADD_BUILTIN_MEMBER_FUNCTION(library_include_directories);
+    ADD_BUILTIN_MEMBER_FUNCTION(library_include_directories_visibility);
+    ADD_BUILTIN_MEMBER_FUNCTION(library_compile_definitions);
+    ADD_BUILTIN_MEMBER_FUNCTION(library_compile_definitions_visibility);
+
+    ADD_BUILTIN_MEMBER_FUNCTION(executable_name);
+    ADD_BUILTIN_MEMBER_FUNCTION(executable_link_to);
+    ADD_BUILTIN_MEMBER_FUNCTION(executable_link_to_visibility);
+    ADD_BUILTIN_MEMBER_FUNCTION(executable_include_directories);
+    ADD_BUILTIN_MEMBER_FUNCTION(
       executable_include_directories_visibility);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(executable_compile_definitions);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(
+    ADD_BUILTIN_MEMBER_FUNCTION(executable_compile_definitions);
+    ADD_BUILTIN_MEMBER_FUNCTION(
       executable_compile_definitions_visibility);
 
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(enum_to_string);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(enum_operator_equal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(enum_operator_equalequal);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(enum_operator_exclaimequal);
+    ADD_BUILTIN_MEMBER_FUNCTION(enum_to_string);
+    ADD_BUILTIN_MEMBER_FUNCTION(enum_operator_equal);
+    ADD_BUILTIN_MEMBER_FUNCTION(enum_operator_equalequal);
+    ADD_BUILTIN_MEMBER_FUNCTION(enum_operator_exclaimequal);
+
+    ADD_BUILTIN_MEMBER_FUNCTION(user_type_operator_equal);
+
+    ADD_BUILTIN_MEMBER_FUNCTION(option_ctor_description);
+    ADD_BUILTIN_MEMBER_FUNCTION(option_ctor_description_value);
+    ADD_BUILTIN_MEMBER_FUNCTION(option_value);
+
+    ADD_BUILTIN_FUNCTION(cmake_minimum_required);
+    ADD_BUILTIN_FUNCTION(cmake_message);
+    ADD_BUILTIN_FUNCTION(cmake_warning);
+    ADD_BUILTIN_FUNCTION(cmake_error);
+    ADD_BUILTIN_FUNCTION(cmake_fatal_error);
+    ADD_BUILTIN_FUNCTION(cmake_get_cxx_compiler_info);
+    ADD_BUILTIN_FUNCTION(cmake_get_system_info);
+    ADD_BUILTIN_FUNCTION(cmake_install_executable);
+    ADD_BUILTIN_FUNCTION(cmake_install_executable_destination);
+    ADD_BUILTIN_FUNCTION(cmake_install_library);
+    ADD_BUILTIN_FUNCTION(cmake_install_library_destination);
+    ADD_BUILTIN_FUNCTION(cmake_enable_ctest);
+    ADD_BUILTIN_FUNCTION(cmake_add_test);
+    ADD_BUILTIN_FUNCTION(cmake_root_source_dir);
+    ADD_BUILTIN_FUNCTION(cmake_current_binary_dir);
+    ADD_BUILTIN_FUNCTION(cmake_current_source_dir);
+    ADD_BUILTIN_FUNCTION(cmake_add_custom_command);
+    ADD_BUILTIN_FUNCTION(cmake_make_directory);
+    ADD_BUILTIN_FUNCTION(cmake_set_old_style_variable);
+    ADD_BUILTIN_FUNCTION(cmake_get_old_style_variable);
+    ADD_BUILTIN_FUNCTION(cmake_add_custom_target);
+    ADD_BUILTIN_FUNCTION(cmake_ctest_command);
+  }
 
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(user_type_operator_equal);
+  member_function_t member_functions[size]{};
+  function_t functions[size]{};
+};
 
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(option_ctor_description);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(option_ctor_description_value);
-    CASE_BUILTIN_MEMBER_FUNCTION_CALL(option_value);
+const builtin_function_caller::dispatch_table
+  builtin_function_caller::m_dispatch_table{};
 
-    default:
-      CMSL_UNREACHABLE("Calling unimplemented member function");
-      return nullptr;
+std::unique_ptr<inst::instance> builtin_function_caller::call_member(
+  inst::instance& instance, sema::builtin_function_kind function_kind,
+  const params_t& params)
+{
+  const auto function =
+    m_dispatch_table.member_functions[static_cast<std::size_t>(function_kind)];
+  if (function == nullptr) {
+    CMSL_UNREACHABLE("Calling unimplemented member function");
+    return nullptr;
   }
 
-  return m_instances.gather_ownership(result);
+  return m_instances.gather_ownership((this->*function)(instance, params));
 }
 
 std::unique_ptr<inst::instance> builtin_function_caller::call(
   sema::builtin_function_kind function_kind,
   const builtin_function_caller::params_t& params)
 {
-  inst::instance* result{ nullptr };
-
-  switch (function_kind) {
-    CASE_BUILTIN_FUNCTION_CALL(cmake_minimum_required);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_message);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_warning);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_error);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_fatal_error);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_get_cxx_compiler_info);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_get_system_info);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_install_executable);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_install_executable_destination);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_install_library);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_install_library_destination);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_enable_ctest);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_add_test);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_root_source_dir);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_current_binary_dir);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_current_source_dir);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_add_custom_command);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_make_directory);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_set_old_style_variable);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_get_old_style_variable);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_add_custom_target);
-    CASE_BUILTIN_FUNCTION_CALL(cmake_ctest_command);
-
-    default:
-      CMSL_UNREACHABLE("Calling unimplemented function");
-      return nullptr;
+  const auto function =
+    m_dispatch_table.functions[static_cast<std::size_t>(function_kind)];
+  if (function == nullptr) {
+    CMSL_UNREACHABLE("Calling unimplemented function");
+    return nullptr;
   }
 
-  return m_instances.gather_ownership(result);
+  return m_instances.gather_ownership((this->*function)(params));
 }
 
 inst::instance* builtin_function_caller::int_operator_minus(
@@ -1296,7 +1319,7 @@ inst::instance* builtin_function_caller::list_ctor(
   inst::instance& instance, const builtin_function_caller::params_t&)
 {
   auto& list = instance.value_accessor().access().get_list_ref();
-  list = inst::list_value{};
+  list.clear();
   return m_instances.create_reference(instance);
 }
 
@@ -1320,7 +1343,7 @@ inst::instance* builtin_function_caller::list_ctor_value(
   inst::instance& instance, const builtin_function_caller::params_t& params)
 {
   auto& list = instance.value_accessor().access().get_list_ref();
-  list.push_back(params[0]->copy());
+  list.push_back(*params[0]);
   return m_instances.create_reference(instance);
 }
 
@@ -1331,7 +1354,7 @@ inst::instance* builtin_function_caller::list_ctor_value_count(
   const auto count = params[1]->value_cref().get_int();
 
   for (auto i = 0u; i < count; ++i) {
-    list.push_back(params[0]->copy());
+    list.push_back(*params[0]);
   }
 
   return m_instances.create_reference(instance);
@@ -1341,7 +1364,7 @@ inst::instance* builtin_function_caller::list_push_back_value(
   inst::instance& instance, const builtin_function_caller::params_t& params)
 {
   auto& list = instance.value_accessor().access().get_list_ref();
-  list.push_back(params[0]->copy());
+  list.push_back(*params[0]);
   return m_instances.create_void();
 }
 
@@ -1358,7 +1381,7 @@ inst::instance* builtin_function_caller::list_push_front_value(
   inst::instance& instance, const builtin_function_caller::params_t& params)
 {
   auto& list = instance.value_accessor().access().get_list_ref();
-  list.push_front(params[0]->copy());
+  list.push_front(*params[0]);
   return m_instances.create_void();
 }
 
@@ -1392,24 +1415,30 @@ inst::instance* builtin_function_caller::list_at(
 {
   auto& list = instance.value_accessor().access().get_list_ref();
   const auto& [position] = get_params<alternative_t::int_>(params);
-  auto& instance_at = list.at(position);
-  return m_instances.create_reference(instance_at);
+  auto element = list.reference_at(position);
+  auto ptr = element.get();
+  m_instances.store(std::move(element));
+  return ptr;
 }
 
 inst::instance* builtin_function_caller::list_front(
   inst::instance& instance, const builtin_function_caller::params_t&)
 {
   auto& list = instance.value_accessor().access().get_list_ref();
-  auto& instance_at_front = list.front();
-  return m_instances.create_reference(instance_at_front);
+  auto element = list.reference_at(0);
+  auto ptr = element.get();
+  m_instances.store(std::move(element));
+  return ptr;
 }
 
 inst::instance* builtin_function_caller::list_back(
   inst::instance& instance, const builtin_function_caller::params_t&)
 {
   auto& list = instance.value_accessor().access().get_list_ref();
-  auto& instance_at_back = list.back();
-  return m_instances.create_reference(instance_at_back);
+  auto element = list.reference_at(list.size() - 1);
+  auto ptr = element.get();
+  m_instances.store(std::move(element));
+  return ptr;
 }
 
 inst::instance* builtin_function_caller::list_insert_pos_value(
@@ -1417,7 +1446,7 @@ inst::instance* builtin_function_caller::list_insert_pos_value(
 {
   auto& list = instance.value_accessor().access().get_list_ref();
   const auto& [position] = get_params<alternative_t::int_>(params);
-  list.insert(position, params[1]->copy());
+  list.insert(position, *params[1]);
   return m_instances.create_void();
 }
 
@@ -1581,12 +1610,26 @@ inst::instance* builtin_function_caller::list_find_value_pos(
   return m_instances.create(found_index);
 }
 
+inst::instance* builtin_function_caller::list_contains_value(
+  inst::instance& instance, const builtin_function_caller::params_t& params)
+{
+  const auto& list = instance.value_cref().get_list_cref();
+  return m_instances.create(list.contains(*params[0]));
+}
+
+inst::instance* builtin_function_caller::list_unique(
+  inst::instance& instance, const builtin_function_caller::params_t&)
+{
+  auto& list = instance.value_accessor().access().get_list_ref();
+  const auto removed_count = list.unique();
+  return m_instances.create(removed_count);
+}
+
 inst::instance* builtin_function_caller::list_operator_plus_value(
   inst::instance& instance, const builtin_function_caller::params_t& params)
 {
   auto list_copy = instance.value_cref().get_list_cref();
-  auto value = params[0]->copy();
-  list_copy.push_back(std::move(value));
+  list_copy.push_back(*params[0]);
   return m_instances.create(instance.type(), std::move(list_copy));
 }
 
@@ -1603,8 +1646,7 @@ inst::instance* builtin_function_caller::list_operator_plus_equal_value(
   inst::instance& instance, const builtin_function_caller::params_t& params)
 {
   auto& list = instance.value_accessor().access().get_list_ref();
-  auto value = params[0]->copy();
-  list.push_back(std::move(value));
+  list.push_back(*params[0]);
   return m_instances.create_reference(instance);
 }
 
@@ -1875,7 +1917,7 @@ inst::instance* builtin_function_caller::enum_operator_exclaimequal(
 inst::instance* builtin_function_caller::user_type_operator_equal(
   inst::instance& instance, const builtin_function_caller::params_t& params)
 {
-  instance.assign(params[0]->copy());
+  instance.assign(m_instances.gather_ownership_or_copy(params[0]));
   return m_instances.create_reference(instance);
 }
 
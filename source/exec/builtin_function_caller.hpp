@@ -309,6 +309,10 @@ private:
                                   const params_t& params);
   inst::instance* list_find_value_pos(inst::instance& instance,
                                       const params_t& params);
+  inst::instance* list_contains_value(inst::instance& instance,
+                                      const params_t& params);
+  inst::instance* list_unique(inst::instance& instance,
+                              const params_t& params);
   inst::instance* list_operator_plus_value(inst::instance& instance,
                                            const params_t& params);
   inst::instance* list_operator_plus_list(inst::instance& instance,
@@ -405,7 +409,10 @@ private:
   int_t string_pos_to_int(std::string::size_type pos) const;
 
 private:
+  struct dispatch_table;
+
   static const std::locale m_utf8_locale;
+  static const dispatch_table m_dispatch_table;
 
   facade::cmake_facade& m_cmake_facade;
   inst::instances_holder_interface& m_instances;
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "common/int_alias.hpp"
+#include "exec/bytecode/instruction.hpp"
+#include "exec/instance/instance.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cmsl {
+namespace sema {
+class sema_function;
+class sema_type;
+}
+
+namespace exec::bytecode {
+// Result of compiling a body of a sema::user_sema_function. Everything that
+// instructions refer to is stored in pools, so instructions stay compact.
+struct compiled_function
+{
+  const sema::sema_function& function;
+  std::vector<instruction> code;
+
+  std::vector<bool> bools;
+  std::vector<int_t> ints;
+  std::vector<double> doubles;
+  std::vector<std::string> strings;
+  std::vector<const sema::sema_type*> types;
+  std::vector<const sema::sema_function*> functions;
+  // Literals shared by all calls. Loaded only where they are not modified.
+  std::vector<std::unique_ptr<inst::instance>> instances;
+
+  unsigned registers_count{ 0u };
+  unsigned locals_count{ 0u };
+};
+}
+}
@@ -0,0 +1,662 @@
+#include "exec/bytecode/function_compiler.hpp"
+
+#include "common/assert.hpp"
+#include "exec/constant_pool.hpp"
+#include "exec/fundamental_operators.hpp"
+#include "sema/builtin_sema_function.hpp"
+#include "sema/sema_node_visitor.hpp"
+#include "sema/sema_nodes.hpp"
+#include "sema/user_sema_function.hpp"
+
+#include <optional>
+
+namespace cmsl::exec::bytecode {
+namespace {
+class emitter
+{
+public:
+  explicit emitter(compiled_function& result)
+    : m_result{ result }
+  {
+  }
+
+  unsigned emit(opcode op, unsigned a = 0u, unsigned b = 0u, unsigned c = 0u)
+  {
+    m_result.code.push_back(instruction{ op, a, b, c });
+    return static_cast<unsigned>(m_result.code.size() - 1u);
+  }
+
+  unsigned current_position() const
+  {
+    return static_cast<unsigned>(m_result.code.size());
+  }
+
+  void patch_jump_target(unsigned instruction_position, unsigned target)
+  {
+    auto& instr = m_result.code[instruction_position];
+    if (instr.op == opcode::jump) {
+      instr.a = target;
+    } else {
+      instr.b = target;
+    }
+  }
+
+  unsigned add_constant(bool value)
+  {
+    return add_to_pool(m_result.bools, value);
+  }
+  unsigned add_constant(int_t value)
+  {
+    return add_to_pool(m_result.ints, value);
+  }
+  unsigned add_constant(double value)
+  {
+    return add_to_pool(m_result.doubles, value);
+  }
+  unsigned add_constant(std::string value)
+  {
+    return add_to_pool(m_result.strings, std::move(value));
+  }
+  unsigned add_instance(std::unique_ptr<inst::instance> instance)
+  {
+    return add_to_pool(m_result.instances, std::move(instance));
+  }
+  unsigned add_type(const sema::sema_type& type)
+  {
+    return add_to_pool(m_result.types, &type);
+  }
+  unsigned add_function(const sema::sema_function& function)
+  {
+    return add_to_pool(m_result.functions, &function);
+  }
+
+  unsigned allocate_register()
+  {
+    const auto reg = m_next_register++;
+    if (m_next_register > m_result.registers_count) {
+      m_result.registers_count = m_next_register;
+    }
+    return reg;
+  }
+
+  unsigned allocate_registers(unsigned count)
+  {
+    const auto first = m_next_register;
+    for (auto i = 0u; i < count; ++i) {
+      allocate_register();
+    }
+    return first;
+  }
+
+  unsigned next_register() const { return m_next_register; }
+  void release_registers_from(unsigned reg) { m_next_register = reg; }
+
+  void enter_loop() { m_breaks.emplace_back(); }
+  void add_break(unsigned jump_position)
+  {
+    CMSL_ASSERT(!m_breaks.empty());
+    m_breaks.back().push_back(jump_position);
+  }
+  void leave_loop(unsigned exit_position)
+  {
+    for (const auto jump_position : m_breaks.back()) {
+      patch_jump_target(jump_position, exit_position);
+    }
+    m_breaks.pop_back();
+  }
+
+private:
+  template <typename Pool, typename Value>
+  unsigned add_to_pool(Pool& pool, Value&& value)
+  {
+    pool.emplace_back(std::forward<Value>(value));
+    return static_cast<unsigned>(pool.size() - 1u);
+  }
+
+private:
+  compiled_function& m_result;
+  unsigned m_next_register{ 0u };
+  std::vector<std::vector<unsigned>> m_breaks;
+};
+
+// Restores registers allocation state, so registers used by a subexpression
+// can be reused by its siblings.
+class registers_guard
+{
+public:
+  explicit registers_guard(emitter& e)
+    : m_emitter{ e }
+    , m_first_free{ e.next_register() }
+  {
+  }
+
+  ~registers_guard() { m_emitter.release_registers_from(m_first_free); }
+
+private:
+  emitter& m_emitter;
+  unsigned m_first_free;
+};
+
+class expression_compiler : public sema::empty_sema_node_visitor
+{
+public:
+  // Expected type mirrors the expected types stack of
+  // expression_evaluation_context. It's needed by designated initializers.
+  explicit expression_compiler(emitter& e, unsigned dst,
+                               const sema::sema_type* expected_type)
+    : m_emitter{ e }
+    , m_dst{ dst }
+    , m_expected_type{ expected_type }
+  {
+  }
+
+  void visit(const sema::bool_value_node& node) override
+  {
+    m_emitter.emit(opcode::load_bool, m_dst,
+                   m_emitter.add_constant(node.value()));
+  }
+
+  void visit(const sema::int_value_node& node) override
+  {
+    m_emitter.emit(opcode::load_int, m_dst,
+                   m_emitter.add_constant(node.value()));
+  }
+
+  void visit(const sema::double_value_node& node) override
+  {
+    m_emitter.emit(opcode::load_double, m_dst,
+                   m_emitter.add_constant(node.value()));
+  }
+
+  void visit(const sema::string_value_node& node) override
+  {
+    m_emitter.emit(opcode::load_string, m_dst,
+                   m_emitter.add_constant(std::string{ node.value() }));
+  }
+
+  void visit(const sema::enum_constant_access_node& node) override
+  {
+    m_emitter.emit(opcode::load_enum_constant, m_dst, node.value(),
+                   m_emitter.add_type(node.type()));
+  }
+
+  void visit(const sema::id_node& node) override
+  {
+    if (const auto slot = node.slot()) {
+      m_emitter.emit(opcode::load_local, m_dst, *slot);
+      return;
+    }
+
+    switch (node.storage()) {
+      case sema::identifier_storage::global:
+      case sema::identifier_storage::builtin:
+        m_emitter.emit(opcode::load_global, m_dst, node.index());
+        break;
+      case sema::identifier_storage::member:
+        m_emitter.emit(opcode::load_member, m_dst, node.index());
+        break;
+      default:
+        m_emitter.emit(opcode::load_identifier, m_dst, node.index());
+        break;
+    }
+  }
+
+  void visit(const sema::binary_operator_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto lhs = m_emitter.allocate_register();
+    const auto rhs = m_emitter.allocate_register();
+    const auto& function = node.operator_function();
+    const auto kind = sema::fundamental_operator_kind(function);
+
+    // Only operators that don't modify lhs can take a shared literal.
+    if (kind && !sema::is_fundamental_assignment(*kind) &&
+        !sema::assigned_value_operator(*kind)) {
+      compile_read_only_child(node.lhs(), lhs, m_expected_type);
+    } else {
+      compile_child(node.lhs(), lhs);
+    }
+    compile_read_only_child(node.rhs(), rhs, m_expected_type);
+
+    if (kind) {
+      m_emitter.emit(opcode::call_fundamental_operator, m_dst, rhs,
+                     static_cast<unsigned>(*kind));
+      return;
+    }
+
+    m_emitter.emit(opcode::call_member, m_dst, rhs,
+                   m_emitter.add_function(function));
+  }
+
+  void visit(const sema::function_call_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto first_param = compile_call_parameters(node);
+    m_emitter.emit(opcode::call, m_dst, first_param,
+                   m_emitter.add_function(node.function()));
+  }
+
+  void visit(const sema::add_subdirectory_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto first_param = compile_call_parameters(node);
+    m_emitter.emit(
+      opcode::add_subdirectory_prepare,
+      m_emitter.add_constant(std::string{ node.dir_name().value() }));
+    m_emitter.emit(opcode::call_add_subdirectory, m_dst, first_param,
+                   m_emitter.add_function(node.function()));
+    m_emitter.emit(opcode::add_subdirectory_finalize);
+  }
+
+  void visit(const sema::implicit_member_function_call_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto class_instance = m_emitter.allocate_register();
+    const auto first_param = compile_call_parameters(node);
+    m_emitter.emit(opcode::load_this, class_instance);
+    m_emitter.emit(opcode::call_member, m_dst, first_param,
+                   m_emitter.add_function(node.function()));
+  }
+
+  void visit(const sema::constructor_call_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto class_instance = m_emitter.allocate_register();
+    const auto first_param = compile_call_parameters(node);
+    m_emitter.emit(opcode::create, class_instance,
+                   m_emitter.add_type(node.type()));
+    m_emitter.emit(opcode::call_member, m_dst, first_param,
+                   m_emitter.add_function(node.function()));
+  }
+
+  void visit(const sema::member_function_call_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto lhs = m_emitter.allocate_register();
+    compile_child(node.lhs(), lhs);
+    const auto first_param = compile_call_parameters(node);
+    m_emitter.emit(opcode::call_member, m_dst, first_param,
+                   m_emitter.add_function(node.function()));
+  }
+
+  void visit(const sema::class_member_access_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto lhs = m_emitter.allocate_register();
+    compile_child(node.lhs(), lhs);
+    m_emitter.emit(opcode::member_access, m_dst, lhs, node.member_index());
+  }
+
+  void visit(const sema::return_node& node) override
+  {
+    compile_child(node.expression(), m_dst);
+  }
+
+  void visit(const sema::cast_to_reference_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto evaluated = m_emitter.allocate_register();
+    compile_child(node.expression(), evaluated);
+    m_emitter.emit(opcode::cast_to_reference, m_dst, evaluated);
+  }
+
+  void visit(const sema::cast_to_value_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto evaluated = m_emitter.allocate_register();
+    compile_child(node.expression(), evaluated);
+    m_emitter.emit(opcode::cast_to_value, m_dst, evaluated);
+  }
+
+  void visit(const sema::initializer_list_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    m_emitter.emit(opcode::create, m_dst, m_emitter.add_type(node.type()));
+
+    const auto value = m_emitter.allocate_register();
+    for (const auto& value_expression : node.values()) {
+      compile_child(*value_expression, value);
+      m_emitter.emit(opcode::list_push_back, m_dst, value);
+    }
+  }
+
+  void visit(const sema::ternary_operator_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto condition = m_emitter.allocate_register();
+    compile_child(node.condition(), condition);
+    const auto jump_to_false =
+      m_emitter.emit(opcode::jump_if_false, condition);
+
+    compile_child(node.true_(), m_dst);
+    const auto jump_to_end = m_emitter.emit(opcode::jump);
+
+    m_emitter.patch_jump_target(jump_to_false,
+                                m_emitter.current_position());
+    compile_child(node.false_(), m_dst);
+    m_emitter.patch_jump_target(jump_to_end, m_emitter.current_position());
+  }
+
+  void visit(const sema::designated_initializers_node& node) override
+  {
+    CMSL_ASSERT(m_expected_type != nullptr);
+    const auto& expected_type = *m_expected_type;
+
+    registers_guard guard{ m_emitter };
+    m_emitter.emit(opcode::create, m_dst, m_emitter.add_type(expected_type));
+
+    const auto value = m_emitter.allocate_register();
+    for (const auto& initializer : node.initializers()) {
+      const auto member_info =
+        expected_type.find_member(initializer.name.str());
+      compile_child(*initializer.init, value, &member_info->ty);
+      m_emitter.emit(opcode::assign_member, m_dst, member_info->index, value);
+    }
+  }
+
+  void visit(const sema::unary_operator_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto lhs = m_emitter.allocate_register();
+    compile_child(node.expression(), lhs);
+    m_emitter.emit(opcode::call_member, m_dst, lhs + 1u,
+                   m_emitter.add_function(node.function()));
+  }
+
+private:
+  void compile_child(const sema::sema_node& child, unsigned dst)
+  {
+    compile_child(child, dst, m_expected_type);
+  }
+
+  void compile_child(const sema::sema_node& child, unsigned dst,
+                     const sema::sema_type* expected_type)
+  {
+    expression_compiler compiler{ m_emitter, dst, expected_type };
+    child.visit(compiler);
+  }
+
+  // Same as compile_child, but a literal is loaded as a shared instance
+  // instead of a new temporary. The value in dst must not be modified.
+  void compile_read_only_child(const sema::sema_node& child, unsigned dst,
+                               const sema::sema_type* expected_type)
+  {
+    const auto expression =
+      dynamic_cast<const sema::expression_node*>(&child);
+    if (expression != nullptr) {
+      if (auto instance = constant_pool::create_constant(*expression)) {
+        m_emitter.emit(opcode::load_constant_instance, dst,
+                       m_emitter.add_instance(std::move(instance)));
+        return;
+      }
+    }
+
+    compile_child(child, dst, expected_type);
+  }
+
+  // Evaluated parameters are placed in consecutive registers. Returns the
+  // first of them.
+  unsigned compile_call_parameters(const sema::call_node& node)
+  {
+    const auto& params = node.param_expressions();
+    const auto& declared_params = node.function().signature().params;
+    const auto first_param =
+      m_emitter.allocate_registers(static_cast<unsigned>(params.size()));
+
+    for (auto i = 0u; i < params.size(); ++i) {
+      compile_read_only_child(*params[i], first_param + i,
+                              &declared_params[i].ty);
+    }
+
+    return first_param;
+  }
+
+private:
+  emitter& m_emitter;
+  const unsigned m_dst;
+  const sema::sema_type* m_expected_type;
+};
+
+class statement_compiler : public sema::empty_sema_node_visitor
+{
+public:
+  explicit statement_compiler(emitter& e)
+    : m_emitter{ e }
+  {
+  }
+
+  void visit(const sema::block_node& node) override
+  {
+    for (const auto& child : node.nodes()) {
+      child->visit(*this);
+    }
+  }
+
+  void visit(const sema::variable_declaration_node& node) override
+  {
+    if (const auto initialization = node.initialization()) {
+      registers_guard guard{ m_emitter };
+      const auto value = m_emitter.allocate_register();
+      compile_expression(*initialization, value, &node.type());
+      m_emitter.emit(opcode::declare_local, *node.slot(), value);
+      m_emitter.emit(opcode::end_full_expression);
+    } else {
+      m_emitter.emit(opcode::declare_local_default, *node.slot(),
+                     m_emitter.add_type(node.type()));
+    }
+  }
+
+  void visit(const sema::return_node& node) override
+  {
+    registers_guard guard{ m_emitter };
+    const auto value = m_emitter.allocate_register();
+    compile_expression(node.expression(), value, nullptr);
+    m_emitter.emit(opcode::ret, value);
+  }
+
+  void visit(const sema::implicit_return_node&) override
+  {
+    m_emitter.emit(opcode::ret_void);
+  }
+
+  void visit(const sema::if_else_node& node) override
+  {
+    std::vector<unsigned> jumps_to_end;
+
+    for (const auto& if_ : node.ifs()) {
+      const auto jump_to_next = compile_condition(if_->get_condition());
+      visit(if_->get_body());
+      jumps_to_end.push_back(m_emitter.emit(opcode::jump));
+      m_emitter.patch_jump_target(jump_to_next,
+                                  m_emitter.current_position());
+    }
+
+    if (const auto else_body = node.else_body()) {
+      visit(*else_body);
+    }
+
+    for (const auto jump : jumps_to_end) {
+      m_emitter.patch_jump_target(jump, m_emitter.current_position());
+    }
+  }
+
+  void visit(const sema::while_node& node) override
+  {
+    const auto condition_position = m_emitter.current_position();
+    const auto jump_to_exit = compile_condition(node.condition());
+
+    m_emitter.enter_loop();
+    visit(node.body());
+    m_emitter.emit(opcode::jump, condition_position);
+
+    const auto exit_position = m_emitter.current_position();
+    m_emitter.patch_jump_target(jump_to_exit, exit_position);
+    m_emitter.leave_loop(exit_position);
+  }
+
+  void visit(const sema::for_node& node) override
+  {
+    if (const auto init = node.init()) {
+      init->visit(*this);
+    }
+
+    const auto condition_position = m_emitter.current_position();
+    std::optional<unsigned> jump_to_exit;
+    if (const auto condition = node.condition()) {
+      jump_to_exit = compile_condition(*condition);
+    }
+
+    m_emitter.enter_loop();
+    visit(node.body());
+    if (const auto iteration = node.iteration()) {
+      iteration->visit(*this);
+    }
+    m_emitter.emit(opcode::jump, condition_position);
+
+    const auto exit_position = m_emitter.current_position();
+    if (jump_to_exit) {
+      m_emitter.patch_jump_target(*jump_to_exit, exit_position);
+    }
+    m_emitter.leave_loop(exit_position);
+  }
+
+  void visit(const sema::break_node&) override
+  {
+    m_emitter.add_break(m_emitter.emit(opcode::jump));
+  }
+
+  void visit(const sema::add_subdirectory_with_old_script_node& node) override
+  {
+    m_emitter.emit(
+      opcode::add_subdirectory_with_old_script,
+      m_emitter.add_constant(std::string{ node.dir_name().value() }));
+  }
+
+  // Stand alone infix expressions.
+  void visit(const sema::bool_value_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::int_value_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::double_value_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::string_value_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::id_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::enum_constant_access_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::binary_operator_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::function_call_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::member_function_call_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::implicit_member_function_call_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::constructor_call_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::add_subdirectory_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::class_member_access_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::cast_to_reference_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::cast_to_value_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::initializer_list_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::ternary_operator_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::designated_initializers_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+  void visit(const sema::unary_operator_node& node) override
+  {
+    compile_expression_statement(node);
+  }
+
+private:
+  void compile_expression(const sema::sema_node& node, unsigned dst,
+                          const sema::sema_type* expected_type)
+  {
+    expression_compiler compiler{ m_emitter, dst, expected_type };
+    node.visit(compiler);
+  }
+
+  void compile_expression_statement(const sema::sema_node& node)
+  {
+    registers_guard guard{ m_emitter };
+    const auto value = m_emitter.allocate_register();
+    compile_expression(node, value, nullptr);
+    m_emitter.emit(opcode::end_full_expression);
+  }
+
+  // Returns position of the jump that needs to be patched with a target to
+  // jump to, when the condition is false.
+  unsigned compile_condition(const sema::sema_node& condition)
+  {
+    registers_guard guard{ m_emitter };
+    const auto value = m_emitter.allocate_register();
+    compile_expression(condition, value, nullptr);
+    return m_emitter.emit(opcode::end_expression_jump_if_false, value);
+  }
+
+private:
+  emitter& m_emitter;
+};
+}
+
+std::unique_ptr<compiled_function> function_compiler::compile(
+  const sema::user_sema_function& function) const
+{
+  auto result = std::make_unique<compiled_function>(compiled_function{
+    function,
+  });
+
+  // Parameters and local variables got their frame slots during semantic
+  // analysis.
+  result->locals_count = function.locals_count();
+
+  emitter e{ *result };
+
+  statement_compiler compiler{ e };
+  function.body().visit(compiler);
+
+  return result;
+}
+}
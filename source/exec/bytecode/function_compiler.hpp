@@ -0,0 +1,21 @@
+#pragma once
+
+#include "exec/bytecode/compiled_function.hpp"
+
+#include <memory>
+
+namespace cmsl::sema {
+class user_sema_function;
+}
+
+namespace cmsl::exec::bytecode {
+// Compiles a body of a user function to a register-based bytecode. Every
+// parameter and local variable gets a frame-relative slot at compile time, so
+// the virtual machine never has to look locals up by identifier index.
+class function_compiler
+{
+public:
+  std::unique_ptr<compiled_function> compile(
+    const sema::user_sema_function& function) const;
+};
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+namespace cmsl::exec::bytecode {
+// Operands meaning depends on the opcode. Registers and local slots are
+// frame-relative, constants are indexes into compiled_function pools.
+enum class opcode : std::uint8_t
+{
+  // a = dst register, b = constant index
+  load_bool,
+  load_int,
+  load_double,
+  load_string,
+  // a = dst register, b = instance index. Loads a shared instance of a
+  // literal, that must not be modified.
+  load_constant_instance,
+  // a = dst register, b = enum value, c = type index
+  load_enum_constant,
+
+  // a = dst register, b = local slot
+  load_local,
+  // a = dst register, b = identifier index
+  load_global,
+  load_member,
+  // Searches all the storages. Used for identifiers which storage sema
+  // didn't resolve.
+  load_identifier,
+  // a = dst register
+  load_this,
+
+  // a = dst register, b = first argument register, c = function index.
+  // Member calls take the object from register b - 1. Arguments count is
+  // taken from the function signature.
+  call,
+  call_member,
+  call_add_subdirectory,
+  // a = dst register, b = rhs register, c = builtin_function_kind. Lhs is
+  // taken from register b - 1. Evaluates a bool, int or double operator
+  // without calling the builtin function.
+  call_fundamental_operator,
+
+  // a = dst register, b = type index
+  create,
+  // a = dst register, b = object register, c = member index
+  member_access,
+  // a = object register, b = member index, c = value register
+  assign_member,
+  // a = dst register, b = src register
+  cast_to_reference,
+  cast_to_value,
+  // a = list register, b = value register
+  list_push_back,
+
+  // a = local slot, b = initialization register
+  declare_local,
+  // a = local slot, b = type index
+  declare_local_default,
+
+  // a = target instruction
+  jump,
+  // a = condition register, b = target instruction
+  jump_if_false,
+  // Same as jump_if_false, but also releases temporaries of the condition.
+  end_expression_jump_if_false,
+
+  // a = result register
+  ret,
+  ret_void,
+
+  // Releases temporaries created while evaluating a full expression.
+  end_full_expression,
+
+  // a = directory string index
+  add_subdirectory_prepare,
+  add_subdirectory_finalize,
+  add_subdirectory_with_old_script
+};
+
+struct instruction
+{
+  opcode op;
+  std::uint32_t a{ 0u };
+  std::uint32_t b{ 0u };
+  std::uint32_t c{ 0u };
+};
+}
@@ -0,0 +1,340 @@
+#include "exec/bytecode/virtual_machine.hpp"
+
+#include "exec/builtin_function_caller.hpp"
+#include "exec/bytecode/function_compiler.hpp"
+#include "exec/cross_translation_unit_static_variables_accessor.hpp"
+#include "exec/fundamental_operators.hpp"
+#include "exec/instance/enum_constant_value.hpp"
+#include "exec/instance/instance.hpp"
+#include "exec/instance/instance_factory.hpp"
+#include "exec/instance/instances_holder.hpp"
+#include "exec/instance/list_value.hpp"
+#include "exec/static_variables_initializer.hpp"
+#include "sema/builtin_sema_function.hpp"
+#include "sema/sema_nodes.hpp"
+#include "sema/user_sema_function.hpp"
+
+#include "cmake_facade.hpp"
+
+namespace cmsl::exec::bytecode {
+struct virtual_machine::frame
+{
+  explicit frame(const compiled_function& fun, inst::instance* this_instance,
+                 sema::builtin_types_accessor builtin_types,
+                 inst::instances_arena& arena)
+    : function{ fun }
+    , class_instance{ this_instance }
+    , locals(fun.locals_count)
+    , registers(fun.registers_count, nullptr)
+    , temporaries{ builtin_types, arena }
+  {
+  }
+
+  const compiled_function& function;
+  inst::instance* class_instance;
+  std::vector<std::unique_ptr<inst::instance>> locals;
+  std::vector<inst::instance*> registers;
+  inst::instances_holder temporaries;
+};
+
+virtual_machine::virtual_machine(
+  facade::cmake_facade& cmake_facade,
+  sema::builtin_types_accessor builtin_types,
+  cross_translation_unit_static_variables_accessor& static_variables_accessor)
+  : m_cmake_facade{ cmake_facade }
+  , m_builtin_types{ builtin_types }
+  , m_static_variables_accessor{ static_variables_accessor }
+{
+}
+
+virtual_machine::~virtual_machine() = default;
+
+void virtual_machine::initialize_static_variables(
+  const sema::translation_unit_node& node,
+  module_static_variables_initializer& module_statics_initializer)
+{
+  static_variables_initializer initializer{ *this, m_builtin_types,
+                                            m_cmake_facade,
+                                            module_statics_initializer };
+  node.visit(initializer);
+  module_statics_initializer.add_module_variables(
+    initializer.gather_instances());
+}
+
+std::unique_ptr<inst::instance> virtual_machine::call(
+  const sema::sema_function& fun, const std::vector<inst::instance*>& params,
+  inst::instances_holder_interface& instances)
+{
+  return call_function(fun, nullptr, params.data(), instances);
+}
+
+std::unique_ptr<inst::instance> virtual_machine::call_member(
+  inst::instance& class_instance, const sema::sema_function& fun,
+  const std::vector<inst::instance*>& params,
+  inst::instances_holder_interface& instances)
+{
+  return call_function(fun, &class_instance, params.data(), instances);
+}
+
+inst::instance* virtual_machine::lookup_identifier(unsigned index)
+{
+  if (auto found = lookup_global_identifier(index)) {
+    return found;
+  }
+
+  return lookup_member_identifier(index);
+}
+
+inst::instance* virtual_machine::lookup_global_identifier(unsigned index)
+{
+  return m_static_variables_accessor.access_variable(index);
+}
+
+inst::instance* virtual_machine::lookup_member_identifier(unsigned index)
+{
+  if (auto class_instance = get_class_instance()) {
+    return class_instance->find_member(index);
+  }
+
+  return nullptr;
+}
+
+inst::instance* virtual_machine::lookup_local_identifier(unsigned slot)
+{
+  return m_current_frame->locals[slot].get();
+}
+
+inst::instance* virtual_machine::get_class_instance()
+{
+  return m_current_frame != nullptr ? m_current_frame->class_instance
+                                    : nullptr;
+}
+
+const compiled_function& virtual_machine::get_compiled(
+  const sema::user_sema_function& function)
+{
+  auto found = m_compiled_functions.find(&function);
+  if (found == std::end(m_compiled_functions)) {
+    auto compiled = function_compiler{}.compile(function);
+    found = m_compiled_functions.emplace(&function, std::move(compiled)).first;
+  }
+
+  return *found->second;
+}
+
+std::unique_ptr<inst::instance> virtual_machine::call_function(
+  const sema::sema_function& fun, inst::instance* class_instance,
+  inst::instance* const* params, inst::instances_holder_interface& instances)
+{
+  if (fun.function_kind() == sema::sema_function_kind::user) {
+    const auto& user_function =
+      static_cast<const sema::user_sema_function&>(fun);
+    return run(get_compiled(user_function), class_instance, params,
+               instances);
+  }
+
+  const auto& builtin_function =
+    static_cast<const sema::builtin_sema_function&>(fun);
+  const auto params_count = fun.signature().params.size();
+  const auto params_vector =
+    std::vector<inst::instance*>(params, params + params_count);
+  builtin_function_caller caller{ m_cmake_facade, instances,
+                                  m_builtin_types };
+
+  if (class_instance == nullptr) {
+    return caller.call(builtin_function.kind(), params_vector);
+  }
+
+  return caller.call_member(*class_instance, builtin_function.kind(),
+                            params_vector);
+}
+
+std::unique_ptr<inst::instance> virtual_machine::run(
+  const compiled_function& function, inst::instance* class_instance,
+  inst::instance* const* params, inst::instances_holder_interface& instances)
+{
+  frame f{ function, class_instance, m_builtin_types, m_instances_arena };
+
+  const auto params_count = function.function.signature().params.size();
+  for (auto i = 0u; i < params_count; ++i) {
+    // Parameters occupy the first slots of the frame. Temporaries of the
+    // caller are moved in.
+    f.locals[i] = instances.gather_ownership_or_copy(params[i]);
+  }
+
+  const auto previous_frame = m_current_frame;
+  m_current_frame = &f;
+  auto result = execute(f);
+  m_current_frame = previous_frame;
+
+  return result;
+}
+
+std::unique_ptr<inst::instance> virtual_machine::execute(frame& f)
+{
+  const auto& fun = f.function;
+  const auto code = fun.code.data();
+  const auto code_size = fun.code.size();
+  const auto regs = f.registers.data();
+  auto& temporaries = f.temporaries;
+
+  const auto store_call_result =
+    [&temporaries, regs](unsigned dst,
+                         std::unique_ptr<inst::instance> result) {
+      regs[dst] = result.get();
+      temporaries.store(std::move(result));
+    };
+
+  auto pc = std::size_t{ 0u };
+  while (pc < code_size) {
+    const auto& instr = code[pc++];
+
+    switch (instr.op) {
+      case opcode::load_bool: {
+        regs[instr.a] = temporaries.create(fun.bools[instr.b]);
+      } break;
+      case opcode::load_int: {
+        regs[instr.a] = temporaries.create(fun.ints[instr.b]);
+      } break;
+      case opcode::load_double: {
+        regs[instr.a] = temporaries.create(fun.doubles[instr.b]);
+      } break;
+      case opcode::load_string: {
+        regs[instr.a] = temporaries.create(fun.strings[instr.b]);
+      } break;
+      case opcode::load_constant_instance: {
+        regs[instr.a] = fun.instances[instr.b].get();
+      } break;
+      case opcode::load_enum_constant: {
+        regs[instr.a] = temporaries.create(
+          *fun.types[instr.c], inst::enum_constant_value{ instr.b });
+      } break;
+
+      case opcode::load_local: {
+        regs[instr.a] = f.locals[instr.b].get();
+      } break;
+      case opcode::load_global: {
+        regs[instr.a] = lookup_global_identifier(instr.b);
+      } break;
+      case opcode::load_member: {
+        regs[instr.a] = lookup_member_identifier(instr.b);
+      } break;
+      case opcode::load_identifier: {
+        regs[instr.a] = lookup_identifier(instr.b);
+      } break;
+      case opcode::load_this: {
+        regs[instr.a] = f.class_instance;
+      } break;
+
+      case opcode::call: {
+        auto result = call_function(*fun.functions[instr.c], nullptr,
+                                    regs + instr.b, temporaries);
+        if (m_cmake_facade.did_fatal_error_occure()) {
+          return nullptr;
+        }
+        store_call_result(instr.a, std::move(result));
+      } break;
+      case opcode::call_member: {
+        auto result = call_function(*fun.functions[instr.c],
+                                    regs[instr.b - 1u], regs + instr.b,
+                                    temporaries);
+        if (m_cmake_facade.did_fatal_error_occure()) {
+          return nullptr;
+        }
+        store_call_result(instr.a, std::move(result));
+      } break;
+      case opcode::call_fundamental_operator: {
+        regs[instr.a] = call_fundamental_operator(
+          static_cast<sema::builtin_function_kind>(instr.c),
+          *regs[instr.b - 1u], *regs[instr.b], temporaries);
+      } break;
+      case opcode::call_add_subdirectory: {
+        auto result = call_function(*fun.functions[instr.c], nullptr,
+                                    regs + instr.b, temporaries);
+        if (m_cmake_facade.did_fatal_error_occure()) {
+          m_cmake_facade.go_directory_up();
+          return nullptr;
+        }
+        store_call_result(instr.a, std::move(result));
+      } break;
+
+      case opcode::create: {
+        regs[instr.a] = temporaries.create(*fun.types[instr.b]);
+      } break;
+      case opcode::member_access: {
+        regs[instr.a] = regs[instr.b]->find_member(instr.c);
+      } break;
+      case opcode::assign_member: {
+        regs[instr.a]->assign_member(instr.b, regs[instr.c]->copy());
+      } break;
+      case opcode::cast_to_reference: {
+        regs[instr.a] = temporaries.create_reference(*regs[instr.b]);
+      } break;
+      case opcode::cast_to_value: {
+        const auto evaluated = regs[instr.b];
+        const auto& referenced_type = evaluated->type().referenced_type();
+        regs[instr.a] =
+          temporaries.create(referenced_type, evaluated->value());
+      } break;
+      case opcode::list_push_back: {
+        auto owned_value = temporaries.gather_ownership_or_copy(regs[instr.b]);
+        auto accessor = regs[instr.a]->value_accessor();
+        accessor.access().get_list_ref().push_back(std::move(owned_value));
+      } break;
+
+      case opcode::declare_local: {
+        f.locals[instr.a] =
+          temporaries.gather_ownership_or_copy(regs[instr.b]);
+      } break;
+      case opcode::declare_local_default: {
+        f.locals[instr.a] =
+          inst::instance_factory2{}.create(*fun.types[instr.b]);
+      } break;
+
+      case opcode::jump: {
+        pc = instr.a;
+      } break;
+      case opcode::jump_if_false: {
+        if (!regs[instr.a]->value_cref().get_bool()) {
+          pc = instr.b;
+        }
+      } break;
+      case opcode::end_expression_jump_if_false: {
+        const auto condition = regs[instr.a]->value_cref().get_bool();
+        temporaries.clear();
+        if (!condition) {
+          pc = instr.b;
+        }
+      } break;
+
+      case opcode::ret: {
+        return temporaries.gather_ownership_or_copy(regs[instr.a]);
+      }
+      case opcode::ret_void: {
+        return inst::instance_factory2{}.create(true, m_builtin_types);
+      }
+
+      case opcode::end_full_expression: {
+        temporaries.clear();
+      } break;
+
+      case opcode::add_subdirectory_prepare: {
+        m_cmake_facade.prepare_for_add_subdirectory_with_cmakesl_script(
+          fun.strings[instr.a]);
+      } break;
+      case opcode::add_subdirectory_finalize: {
+        m_cmake_facade.finalize_after_add_subdirectory_with_cmakesl_script();
+      } break;
+      case opcode::add_subdirectory_with_old_script: {
+        m_cmake_facade.add_subdirectory_with_old_script(fun.strings[instr.a]);
+        if (m_cmake_facade.did_fatal_error_occure()) {
+          return nullptr;
+        }
+      } break;
+    }
+  }
+
+  // Function without a return statement.
+  return nullptr;
+}
+}
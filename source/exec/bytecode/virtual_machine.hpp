@@ -0,0 +1,93 @@
+#pragma once
+
+#include "exec/bytecode/compiled_function.hpp"
+#include "exec/function_caller.hpp"
+#include "exec/identifiers_context.hpp"
+#include "exec/instance/instances_arena.hpp"
+#include "sema/builtin_types_accessor.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace cmsl {
+namespace facade {
+class cmake_facade;
+}
+
+namespace sema {
+class translation_unit_node;
+class user_sema_function;
+}
+
+namespace exec {
+class cross_translation_unit_static_variables_accessor;
+class module_static_variables_initializer;
+
+namespace bytecode {
+// Executes user functions compiled by function_compiler. Functions are
+// compiled lazily, on their first call, and cached for the whole execution.
+class virtual_machine
+  : public identifiers_context
+  , public function_caller
+{
+public:
+  explicit virtual_machine(facade::cmake_facade& cmake_facade,
+                           sema::builtin_types_accessor builtin_types,
+                           cross_translation_unit_static_variables_accessor&
+                             static_variables_accessor);
+  ~virtual_machine();
+
+  void initialize_static_variables(
+    const sema::translation_unit_node& node,
+    module_static_variables_initializer& module_statics_initializer);
+
+  std::unique_ptr<inst::instance> call(
+    const sema::sema_function& fun, const std::vector<inst::instance*>& params,
+    inst::instances_holder_interface& instances) override;
+
+  std::unique_ptr<inst::instance> call_member(
+    inst::instance& class_instance, const sema::sema_function& fun,
+    const std::vector<inst::instance*>& params,
+    inst::instances_holder_interface& instances) override;
+
+  inst::instance* lookup_identifier(unsigned index) override;
+  inst::instance* lookup_local_identifier(unsigned slot) override;
+  inst::instance* lookup_global_identifier(unsigned index) override;
+  inst::instance* lookup_member_identifier(unsigned index) override;
+  inst::instance* get_class_instance() override;
+
+private:
+  struct frame;
+
+  const compiled_function& get_compiled(
+    const sema::user_sema_function& function);
+
+  std::unique_ptr<inst::instance> call_function(
+    const sema::sema_function& fun, inst::instance* class_instance,
+    inst::instance* const* params,
+    inst::instances_holder_interface& instances);
+
+  std::unique_ptr<inst::instance> run(
+    const compiled_function& function, inst::instance* class_instance,
+    inst::instance* const* params,
+    inst::instances_holder_interface& instances);
+
+  std::unique_ptr<inst::instance> execute(frame& f);
+
+private:
+  facade::cmake_facade& m_cmake_facade;
+  sema::builtin_types_accessor m_builtin_types;
+  cross_translation_unit_static_variables_accessor&
+    m_static_variables_accessor;
+  // Frames create their temporaries in this arena and reset them after each
+  // full expression.
+  inst::instances_arena m_instances_arena;
+  std::unordered_map<const sema::user_sema_function*,
+                     std::unique_ptr<compiled_function>>
+    m_compiled_functions;
+  frame* m_current_frame{ nullptr };
+};
+}
+}
+}
@@ -1,5 +1,4 @@
 #include "exec/compiled_source.hpp"
-#include "ast/ast_node.hpp"
 #include "sema/builtin_sema_context.hpp"
 #include "sema/builtin_token_provider.hpp"
 #include "sema/enum_values_context.hpp"
@@ -8,16 +7,18 @@
 #include "sema/sema_node.hpp"
 
 namespace cmsl::exec {
-compiled_source::compiled_source(std::unique_ptr<ast::ast_node> ast_tree,
+compiled_source::compiled_source(std::unique_ptr<nodes_arena> arena,
                                  const sema::sema_context& global_context,
                                  std::unique_ptr<sema::sema_node> sema_tree,
                                  source_view source,
-                                 sema::builtin_types_accessor builtin_types)
-  : m_ast_tree{ std::move(ast_tree) }
+                                 sema::builtin_types_accessor builtin_types,
+                                 memory_usage memory)
+  : m_arena{ std::move(arena) }
   , m_global_context{ std::move(global_context) }
   , m_sema_tree{ std::move(sema_tree) }
   , m_source{ source }
   , m_builtin_types{ builtin_types }
+  , m_memory{ memory }
 {
 }
 
@@ -45,4 +46,14 @@ sema::builtin_types_accessor compiled_source::builtin_types() const
 {
   return m_builtin_types;
 }
+
+source_view compiled_source::source() const
+{
+  return m_source;
+}
+
+const compiled_source::memory_usage& compiled_source::memory() const
+{
+  return m_memory;
+}
 }
@@ -1,15 +1,13 @@
 #pragma once
 
+#include "common/nodes_arena.hpp"
 #include "common/source_view.hpp"
 #include "sema/builtin_types_accessor.hpp"
 
+#include <cstddef>
 #include <memory>
 
 namespace cmsl {
-namespace ast {
-class ast_node;
-}
-
 namespace sema {
 class builtin_token_provider;
 class sema_node;
@@ -22,14 +20,29 @@ class enum_values_context;
 }
 
 namespace exec {
+// Sema tree of a translation unit. The AST and tokens are released right
+// after semantic analysis, sema nodes keep their own source ranges. Nodes are
+// allocated in the arena, which is freed in one go after the tree is
+// destroyed.
 class compiled_source
 {
 public:
-  explicit compiled_source(std::unique_ptr<ast::ast_node> ast_tree,
+  // Approximated by sizes of nodes and of the tokens vector. Memory owned by
+  // nodes, e.g. their vectors, is not counted.
+  struct memory_usage
+  {
+    // AST and tokens, released after semantic analysis.
+    std::size_t released_bytes{ 0u };
+    // Sema tree, kept as long as the compiled source.
+    std::size_t kept_bytes{ 0u };
+  };
+
+  explicit compiled_source(std::unique_ptr<nodes_arena> arena,
                            const sema::sema_context& global_context,
                            std::unique_ptr<sema::sema_node> sema_tree,
                            source_view source,
-                           sema::builtin_types_accessor builtin_types);
+                           sema::builtin_types_accessor builtin_types,
+                           memory_usage memory);
   ~compiled_source();
 
   const sema::sema_function* get_main() const;
@@ -39,12 +52,17 @@ public:
 
   sema::builtin_types_accessor builtin_types() const;
 
+  source_view source() const;
+
+  const memory_usage& memory() const;
+
 private:
-  std::unique_ptr<ast::ast_node> m_ast_tree;
+  std::unique_ptr<nodes_arena> m_arena;
   const sema::sema_context& m_global_context;
   std::unique_ptr<sema::sema_node> m_sema_tree;
   source_view m_source;
   sema::builtin_types_accessor m_builtin_types;
+  memory_usage m_memory;
 };
 }
 }
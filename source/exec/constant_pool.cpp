@@ -0,0 +1,46 @@
+#include "exec/constant_pool.hpp"
+
+#include "exec/instance/simple_unnamed_instance.hpp"
+#include "sema/sema_nodes.hpp"
+
+namespace cmsl::exec {
+namespace {
+template <typename Node, typename Value>
+std::unique_ptr<inst::instance> create(const Node& node, Value value)
+{
+  return std::make_unique<inst::simple_unnamed_instance>(
+    node.type(), inst::instance_value_variant{ std::move(value) });
+}
+}
+
+std::unique_ptr<inst::instance> constant_pool::create_constant(
+  const sema::expression_node& node)
+{
+  if (const auto literal = dynamic_cast<const sema::bool_value_node*>(&node)) {
+    return create(*literal, literal->value());
+  }
+  if (const auto literal = dynamic_cast<const sema::int_value_node*>(&node)) {
+    return create(*literal, literal->value());
+  }
+  if (const auto literal =
+        dynamic_cast<const sema::double_value_node*>(&node)) {
+    return create(*literal, literal->value());
+  }
+  if (const auto literal =
+        dynamic_cast<const sema::string_value_node*>(&node)) {
+    return create(*literal, std::string{ literal->value() });
+  }
+
+  return nullptr;
+}
+
+inst::instance* constant_pool::get(const sema::expression_node& node)
+{
+  auto& constant = m_constants[&node];
+  if (constant == nullptr) {
+    constant = create_constant(node);
+  }
+
+  return constant.get();
+}
+}
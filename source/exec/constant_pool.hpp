@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+namespace cmsl {
+namespace sema {
+class expression_node;
+}
+
+namespace exec {
+namespace inst {
+class instance;
+}
+
+// Instances of literals, created once and shared by all evaluations of a
+// literal. Scripts may modify temporaries, e.g. "abc".clear(), so constants
+// are used only where their values are read: as call parameters, which are
+// copied by callees if needed, and as operands of fundamental operators that
+// don't modify them. Everywhere else literals create temporaries.
+class constant_pool
+{
+public:
+  // Creates an instance of a bool, int, double or string literal. Returns
+  // null for any other expression.
+  static std::unique_ptr<inst::instance> create_constant(
+    const sema::expression_node& node);
+
+  // Returns null if the node is not a literal. Returned instance must not be
+  // modified.
+  inst::instance* get(const sema::expression_node& node);
+
+private:
+  std::unordered_map<const sema::expression_node*,
+                     std::unique_ptr<inst::instance>>
+    m_constants;
+};
+}
+}
@@ -34,8 +34,13 @@ void cross_translation_unit_static_variables::initialize_module(
   };
 
   module_sema_tree.visit(initializer);
-  auto instances = initializer.gather_instances();
-  std::move(std::begin(instances), std::end(instances),
+  add_module_variables(initializer.gather_instances());
+}
+
+void cross_translation_unit_static_variables::add_module_variables(
+  variables_t variables)
+{
+  std::move(std::begin(variables), std::end(variables),
             std::inserter(m_variables, std::end(m_variables)));
 }
 
@@ -42,7 +42,8 @@ public:
   ~cross_translation_unit_static_variables();
 
   void initialize_module(const sema::sema_node& module_sema_tree);
-  void initialize(cmsl::string_view import_path);
+  void initialize(cmsl::string_view import_path) override;
+  void add_module_variables(variables_t variables) override;
 
   void initialize_builtin_variables(
     const std::vector<sema::builtin_identifier_info>& builtin_variables_info,
@@ -61,7 +62,9 @@ private:
   module_sema_tree_provider& m_sema_tree_provider;
 
   std::unordered_set<std::string> m_already_initialized_modules;
-  std::unordered_map<unsigned, std::unique_ptr<inst::instance>> m_variables;
+  // Variables of all the modules and builtin ones. Identifier indexes are
+  // unique across modules, so they don't collide.
+  variables_t m_variables;
 };
 }
 }
\ No newline at end of file
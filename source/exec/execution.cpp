@@ -3,6 +3,151 @@
 #include "exec/static_variables_initializer.hpp"
 
 namespace cmsl::exec {
+class execution::statement_execution_visitor
+  : public sema::empty_sema_node_visitor
+{
+public:
+  explicit statement_execution_visitor(execution& e)
+    : m_execution{ e }
+  {
+  }
+
+  void visit(const sema::return_node& node) override
+  {
+    m_execution.m_function_return_value =
+      m_execution.execute_infix_expression(node);
+  }
+
+  void visit(const sema::implicit_return_node&) override
+  {
+    // Todo: introduce void type
+    m_execution.m_function_return_value =
+      inst::instance_factory2{}.create(true, m_execution.m_builtin_types);
+  }
+
+  void visit(const sema::variable_declaration_node& node) override
+  {
+    m_execution.execute_variable_declaration(node);
+  }
+
+  void visit(const sema::if_else_node& node) override
+  {
+    m_execution.execute_if_else_node(node);
+  }
+
+  void visit(const sema::while_node& node) override
+  {
+    m_execution.execute_while_node(node);
+  }
+
+  void visit(const sema::for_node& node) override
+  {
+    m_execution.execute_for_node(node);
+  }
+
+  void visit(const sema::break_node& node) override
+  {
+    m_execution.execute_break_node(node);
+  }
+
+  void visit(const sema::block_node& node) override
+  {
+    m_execution.execute_block(node);
+  }
+
+  void visit(const sema::add_subdirectory_with_old_script_node& node) override
+  {
+    m_execution.execute_add_subdirectory_with_old_script(node);
+  }
+
+  // Stand alone infix expressions.
+  void visit(const sema::bool_value_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::int_value_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::double_value_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::string_value_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::id_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::enum_constant_access_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::binary_operator_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::function_call_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::member_function_call_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::implicit_member_function_call_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::constructor_call_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::add_subdirectory_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::class_member_access_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::cast_to_reference_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::cast_to_value_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::initializer_list_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::ternary_operator_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::designated_initializers_node& node) override
+  {
+    execute_expression(node);
+  }
+  void visit(const sema::unary_operator_node& node) override
+  {
+    execute_expression(node);
+  }
+
+private:
+  void execute_expression(const sema::sema_node& node)
+  {
+    (void)m_execution.execute_infix_expression(node);
+  }
+
+private:
+  execution& m_execution;
+};
+
 execution::execution(
   facade::cmake_facade& cmake_facade,
   sema::builtin_types_accessor builtin_types,
@@ -24,18 +169,19 @@ std::unique_ptr<inst::instance> execution::call(
   //  }
 
   std::unique_ptr<inst::instance> result;
-  if (auto user_function =
-        dynamic_cast<const sema::user_sema_function*>(&fun)) {
-    enter_function_scope(fun, params);
-    execute_block(user_function->body());
+  if (fun.function_kind() == sema::sema_function_kind::user) {
+    const auto& user_function =
+      static_cast<const sema::user_sema_function&>(fun);
+    enter_function_scope(user_function, params, instances);
+    execute_block(user_function.body());
     result = std::move(m_function_return_value);
     leave_function_scope();
   } else {
-    auto builtin_function =
-      dynamic_cast<const sema::builtin_sema_function*>(&fun);
+    const auto& builtin_function =
+      static_cast<const sema::builtin_sema_function&>(fun);
     result =
       builtin_function_caller{ m_cmake_facade, instances, m_builtin_types }
-        .call(builtin_function->kind(), params);
+        .call(builtin_function.kind(), params);
   }
 
   return result;
@@ -46,31 +192,48 @@ std::unique_ptr<inst::instance> execution::call_member(
   const std::vector<inst::instance*>& params,
   inst::instances_holder_interface& instances)
 {
-  if (auto user_function =
-        dynamic_cast<const sema::user_sema_function*>(&fun)) {
-    enter_function_scope(fun, class_instance, params);
-    execute_block(user_function->body());
+  if (fun.function_kind() == sema::sema_function_kind::user) {
+    const auto& user_function =
+      static_cast<const sema::user_sema_function&>(fun);
+    enter_function_scope(user_function, class_instance, params, instances);
+    execute_block(user_function.body());
     leave_function_scope();
     return std::move(m_function_return_value);
   } else {
-    auto builtin_function =
-      dynamic_cast<const sema::builtin_sema_function*>(&fun);
+    const auto& builtin_function =
+      static_cast<const sema::builtin_sema_function&>(fun);
     return builtin_function_caller{ m_cmake_facade, instances,
                                     m_builtin_types }
-      .call_member(class_instance, builtin_function->kind(), params);
+      .call_member(class_instance, builtin_function.kind(), params);
   }
 }
 
 inst::instance* execution::lookup_identifier(unsigned index)
 {
-  if (auto found = m_global_variables.find(index);
-      found != std::cend(m_global_variables)) {
-    return found->second.get();
-  } else if (auto found = m_static_variables_accessor.access_variable(index)) {
+  if (auto found = lookup_global_identifier(index)) {
     return found;
-  } else {
-    return m_callstack.top().exec_ctx.get_variable(index);
   }
+
+  return lookup_member_identifier(index);
+}
+
+inst::instance* execution::lookup_global_identifier(unsigned index)
+{
+  return m_static_variables_accessor.access_variable(index);
+}
+
+inst::instance* execution::lookup_member_identifier(unsigned index)
+{
+  if (auto class_instance = get_class_instance()) {
+    return class_instance->find_member(index);
+  }
+
+  return nullptr;
+}
+
+inst::instance* execution::lookup_local_identifier(unsigned slot)
+{
+  return m_callstack.top().exec_ctx.get_variable(slot);
 }
 
 inst::instance* execution::get_class_instance()
@@ -94,52 +257,21 @@ void execution::execute_variable_declaration(
   const sema::variable_declaration_node& node)
 {
   auto& exec_ctx = m_callstack.top().exec_ctx;
-  inst::instances_holder instances{ m_builtin_types };
   std::unique_ptr<inst::instance> created_instance;
 
   if (auto initialization = node.initialization()) {
     created_instance = execute_infix_expression(node.type(), *initialization);
   } else {
-    // Todo: create variable without instances holder
-    auto variable_instance_ptr = instances.create(node.type());
-    created_instance = instances.gather_ownership(variable_instance_ptr);
+    created_instance = inst::instance_factory2{}.create(node.type());
   }
 
-  exec_ctx.add_variable(node.index(), std::move(created_instance));
+  exec_ctx.add_variable(*node.slot(), std::move(created_instance));
 }
 
 void execution::execute_node(const sema::sema_node& node)
 {
-  // Todo: consider introducing a visitor for such execution, instead of
-  // dynamic casts.
-  if (dynamic_cast<const sema::return_node*>(&node) != nullptr) {
-    m_function_return_value = execute_infix_expression(node);
-  } else if (dynamic_cast<const sema::implicit_return_node*>(&node) !=
-             nullptr) {
-
-    inst::instances_holder instances{ m_builtin_types };
-    auto void_val = instances.create_void();
-    m_function_return_value = instances.gather_ownership(void_val);
-  } else if (auto var_decl =
-               dynamic_cast<const sema::variable_declaration_node*>(&node)) {
-    execute_variable_declaration(*var_decl);
-  } else if (auto if_else = dynamic_cast<const sema::if_else_node*>(&node)) {
-    execute_if_else_node(*if_else);
-  } else if (auto while_ = dynamic_cast<const sema::while_node*>(&node)) {
-    execute_while_node(*while_);
-  } else if (auto for_ = dynamic_cast<const sema::for_node*>(&node)) {
-    execute_for_node(*for_);
-  } else if (auto break_ = dynamic_cast<const sema::break_node*>(&node)) {
-    execute_break_node(*break_);
-  } else if (auto block = dynamic_cast<const sema::block_node*>(&node)) {
-    execute_block(*block);
-  } else if (auto add_subdirectory_old = dynamic_cast<
-               const sema::add_subdirectory_with_old_script_node*>(&node)) {
-    execute_add_subdirectory_with_old_script(*add_subdirectory_old);
-  } else {
-    // A stand alone infix expression.
-    (void)execute_infix_expression(node);
-  }
+  statement_execution_visitor visitor{ *this };
+  node.visit(visitor);
 }
 
 bool execution::returning_from_function() const
@@ -154,36 +286,37 @@ const sema::sema_context& execution::current_context() const
 }
 
 void execution::enter_function_scope(
-  const sema::sema_function& fun, const std::vector<inst::instance*>& params)
+  const sema::user_sema_function& fun,
+  const std::vector<inst::instance*>& params,
+  inst::instances_holder_interface& instances)
 {
-  m_callstack.push(callstack_frame{ fun });
-  auto guard = m_callstack.top().exec_ctx.enter_scope();
-  // Scope is explicitly left in leave_function_scope() method.
-  guard.dismiss();
-  auto& exec_ctx = m_callstack.top().exec_ctx;
-  const auto& declared_params = fun.signature().params;
-
-  for (auto i = 0u; i < params.size(); ++i) {
-    auto param = params[i]->copy();
-    exec_ctx.add_variable(declared_params[i].index, std::move(param));
-  }
+  m_callstack.push(
+    callstack_frame{ fun, execution_context{ fun.locals_count() } });
+  enter_params_scope(params, instances);
 }
 
 void execution::enter_function_scope(
-  const sema::sema_function& fun, inst::instance& class_instance,
-  const std::vector<inst::instance*>& params)
+  const sema::user_sema_function& fun, inst::instance& class_instance,
+  const std::vector<inst::instance*>& params,
+  inst::instances_holder_interface& instances)
+{
+  m_callstack.push(callstack_frame{
+    fun, execution_context{ fun.locals_count(), &class_instance } });
+  enter_params_scope(params, instances);
+}
+
+void execution::enter_params_scope(const std::vector<inst::instance*>& params,
+                                   inst::instances_holder_interface& instances)
 {
-  m_callstack.push(callstack_frame{ fun });
-  auto guard =
-    m_callstack.top().exec_ctx.enter_member_function_scope(&class_instance);
+  auto& exec_ctx = m_callstack.top().exec_ctx;
+  auto guard = exec_ctx.enter_scope();
   // Scope is explicitly left in leave_function_scope() method.
   guard.dismiss();
-  auto& exec_ctx = m_callstack.top().exec_ctx;
-  const auto& declared_params = fun.signature().params;
 
+  // Parameters occupy the first slots of the frame. Temporaries passed by the
+  // caller are not used after the call, so they are moved in.
   for (auto i = 0u; i < params.size(); ++i) {
-    auto param = params[i]->copy();
-    exec_ctx.add_variable(declared_params[i].index, std::move(param));
+    exec_ctx.add_variable(i, instances.gather_ownership_or_copy(params[i]));
   }
 }
 
@@ -201,25 +334,29 @@ std::unique_ptr<inst::instance> execution::execute_infix_expression(
   if (m_cmake_facade.did_fatal_error_occure()) {
     return nullptr;
   }
-  return visitor.result->copy(); // Todo: it'd be good to move instead of copy.
+
+  // The full expression ends here, so a temporary result can be moved out.
+  return ctx.instances.gather_ownership_or_copy(visitor.result);
 }
 
 std::unique_ptr<inst::instance> execution::execute_infix_expression(
   const sema::sema_node& node)
 {
-  inst::instances_holder instances{ m_builtin_types };
+  inst::instances_holder instances{ m_builtin_types, m_instances_arena };
   expression_evaluation_context ctx{ *this, instances, *this, m_cmake_facade };
+  ctx.constants = &m_constants;
   return execute_infix_expression(std::move(ctx), node);
 }
 
 std::unique_ptr<inst::instance> execution::execute_infix_expression(
   const sema::sema_type& expected_type, const sema::sema_node& node)
 {
-  inst::instances_holder instances{ m_builtin_types };
+  inst::instances_holder instances{ m_builtin_types, m_instances_arena };
   expression_evaluation_context::expected_types_t types;
   types.push(expected_type);
   expression_evaluation_context ctx{ *this, instances, *this, m_cmake_facade,
                                      std::move(types) };
+  ctx.constants = &m_constants;
   return execute_infix_expression(std::move(ctx), node);
 }
 
@@ -261,13 +398,8 @@ void execution::execute_for_node(const sema::for_node& node)
 {
   auto guard = m_callstack.top().exec_ctx.enter_scope();
 
-  if (node.init()) {
-    if (auto var_decl =
-          dynamic_cast<const sema::variable_declaration_node*>(node.init())) {
-      execute_variable_declaration(*var_decl);
-    } else {
-      execute_infix_expression(*node.init());
-    }
+  if (const auto init = node.init()) {
+    execute_node(*init);
   }
 
   const auto should_continue = [&] {
@@ -308,9 +440,8 @@ void execution::initialize_static_variables(
                                             m_cmake_facade,
                                             module_statics_initializer };
   node.visit(initializer);
-  auto instances = initializer.gather_instances();
-  std::move(std::begin(instances), std::end(instances),
-            std::inserter(m_global_variables, std::end(m_global_variables)));
+  module_statics_initializer.add_module_variables(
+    initializer.gather_instances());
 }
 
 void execution::execute_add_subdirectory_with_old_script(
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "exec/builtin_function_caller.hpp"
+#include "exec/constant_pool.hpp"
 #include "exec/expression_evaluation_context.hpp"
 #include "exec/expression_evaluation_visitor.hpp"
 #include "exec/function_caller.hpp"
 #include "exec/identifiers_context.hpp"
 #include "exec/instance/instance.hpp"
 #include "exec/instance/instance_factory.hpp"
+#include "exec/instance/instances_arena.hpp"
 #include "exec/instance/instances_holder.hpp"
 #include "sema/builtin_sema_function.hpp"
 #include "sema/builtin_types_accessor.hpp"
@@ -16,6 +18,8 @@
 
 #include "cmake_facade.hpp"
 
+#include <stack>
+
 namespace cmsl::exec {
 class module_sema_tree_provider;
 class module_static_variables_initializer;
@@ -49,9 +53,15 @@ public:
     inst::instances_holder_interface& instances) override;
 
   inst::instance* lookup_identifier(unsigned index) override;
+  inst::instance* lookup_local_identifier(unsigned slot) override;
+  inst::instance* lookup_global_identifier(unsigned index) override;
+  inst::instance* lookup_member_identifier(unsigned index) override;
   inst::instance* get_class_instance() override;
 
 private:
+  // Dispatches statements to the execute_* methods.
+  class statement_execution_visitor;
+
   void execute_block(const sema::block_node& block);
   void execute_variable_declaration(
     const sema::variable_declaration_node& node);
@@ -67,11 +77,15 @@ private:
 
   const sema::sema_context& current_context() const;
 
-  void enter_function_scope(const sema::sema_function& fun,
-                            const std::vector<inst::instance*>& params);
-  void enter_function_scope(const sema::sema_function& fun,
+  void enter_function_scope(const sema::user_sema_function& fun,
+                            const std::vector<inst::instance*>& params,
+                            inst::instances_holder_interface& instances);
+  void enter_function_scope(const sema::user_sema_function& fun,
                             inst::instance& class_instance,
-                            const std::vector<inst::instance*>& params);
+                            const std::vector<inst::instance*>& params,
+                            inst::instances_holder_interface& instances);
+  void enter_params_scope(const std::vector<inst::instance*>& params,
+                          inst::instances_holder_interface& instances);
   void leave_function_scope();
 
   std::unique_ptr<inst::instance> execute_infix_expression(
@@ -87,17 +101,19 @@ private:
   struct callstack_frame
   {
     const sema::sema_function& fun;
-    execution_context exec_ctx{};
+    execution_context exec_ctx;
   };
 
   facade::cmake_facade& m_cmake_facade;
   sema::builtin_types_accessor m_builtin_types;
   cross_translation_unit_static_variables_accessor&
     m_static_variables_accessor;
+  // Temporaries of all the statements are created in this arena. Memory is
+  // reused after each statement.
+  inst::instances_arena m_instances_arena;
+  constant_pool m_constants;
   std::unique_ptr<inst::instance> m_function_return_value;
   std::stack<callstack_frame> m_callstack;
-  std::unordered_map<unsigned, std::unique_ptr<inst::instance>>
-    m_global_variables;
   bool m_breaking_from_loop{ false };
 
   std::optional<std::vector<inst::instance*>>
@@ -1,64 +1,59 @@
 #include "exec/execution_context.hpp"
 
 #include "common/assert.hpp"
-#include "exec/instance/instance_reference.hpp"
+
+#include <algorithm>
 
 namespace cmsl::exec {
-void execution_context::add_variable(unsigned index,
-                                     std::unique_ptr<instance_t> inst)
+execution_context::execution_context(unsigned slots_count,
+                                     instance_t* class_instance)
+  : m_slots(slots_count)
+  , m_class_instance{ class_instance }
 {
-  current_scope().add_variable(index, std::move(inst));
 }
 
-execution_context::instance_t* execution_context::get_variable(unsigned index)
+void execution_context::add_variable(unsigned slot,
+                                     std::unique_ptr<instance_t> inst)
 {
-  return current_scope().get_variable(index);
+  CMSL_ASSERT_MSG(slot < m_slots.size(), "Slot out of frame");
+  m_slots[slot] = std::move(inst);
+  m_top = std::max(m_top, slot + 1u);
 }
 
-bool execution_context::variable_exists(unsigned index) const
+execution_context::instance_t* execution_context::get_variable(unsigned slot)
 {
-  return current_scope().variable_exists(index);
+  return m_slots[slot].get();
 }
 
-execution_context::scope_leaving_guard execution_context::enter_scope()
+bool execution_context::variable_exists(unsigned slot) const
 {
-  auto current = m_scopes.empty() ? nullptr : &current_scope();
-  m_scopes.push(scope_context{ current });
-  return scope_leaving_guard{ m_scopes };
+  return slot < m_top && m_slots[slot] != nullptr;
 }
 
-void execution_context::leave_scope()
+execution_context::scope_leaving_guard execution_context::enter_scope()
 {
-  m_scopes.pop();
+  m_scope_begins.push_back(m_top);
+  return scope_leaving_guard{ *this };
 }
 
-scope_context& execution_context::current_scope()
+void execution_context::leave_scope()
 {
-  if (m_scopes.empty()) {
+  if (m_scope_begins.empty()) {
     CMSL_UNREACHABLE("No scope");
   }
-  return m_scopes.top();
-}
 
-const scope_context& execution_context::current_scope() const
-{
-  if (m_scopes.empty()) {
-    CMSL_UNREACHABLE("No scope");
-  }
-  return m_scopes.top();
-}
+  const auto begin = m_scope_begins.back();
+  m_scope_begins.pop_back();
 
-execution_context::scope_leaving_guard
-execution_context::enter_member_function_scope(instance_t* class_instance)
-{
-  m_scopes.push(scope_context{ class_instance });
-  add_variable(k_this_index,
-               std::make_unique<inst::instance_reference>(*class_instance));
-  return scope_leaving_guard{ m_scopes };
+  // Variables declared in the scope die with it.
+  for (auto slot = begin; slot < m_top; ++slot) {
+    m_slots[slot].reset();
+  }
+  m_top = begin;
 }
 
 execution_context::instance_t* execution_context::get_this()
 {
-  return get_variable(k_this_index);
+  return m_class_instance;
 }
 }
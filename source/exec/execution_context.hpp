@@ -1,55 +1,60 @@
 #pragma once
 
-#include "exec/scope_context.hpp"
+#include "exec/instance/instance.hpp"
 
-#include <stack>
+#include <memory>
+#include <vector>
 
 namespace cmsl::exec {
+// Frame of a function call. Parameters and local variables live in a flat
+// array of slots assigned during semantic analysis, so a variable access is a
+// plain index. Entering and leaving a scope only moves the top of the slots
+// stack.
 class execution_context
 {
 private:
   using instance_t = inst::instance;
-  static constexpr unsigned k_this_index = static_cast<unsigned>(-1);
 
 public:
   class scope_leaving_guard
   {
   public:
-    explicit scope_leaving_guard(std::stack<scope_context>& scopes)
-      : m_scopes{ scopes }
+    explicit scope_leaving_guard(execution_context& ctx)
+      : m_ctx{ ctx }
     {
     }
 
     ~scope_leaving_guard()
     {
       if (!m_dismissed) {
-        m_scopes.pop();
+        m_ctx.leave_scope();
       }
     }
 
     void dismiss() { m_dismissed = true; }
 
   private:
-    std::stack<scope_context>& m_scopes;
+    execution_context& m_ctx;
     bool m_dismissed{ false };
   };
 
-  void add_variable(unsigned index, std::unique_ptr<instance_t> inst);
-  instance_t* get_variable(unsigned index);
+  explicit execution_context(unsigned slots_count,
+                             instance_t* class_instance = nullptr);
+
+  void add_variable(unsigned slot, std::unique_ptr<instance_t> inst);
+  instance_t* get_variable(unsigned slot);
   instance_t* get_this();
 
-  bool variable_exists(unsigned index) const;
+  bool variable_exists(unsigned slot) const;
 
   [[nodiscard]] scope_leaving_guard enter_scope();
-  [[nodiscard]] scope_leaving_guard enter_member_function_scope(
-    instance_t* class_instance);
   void leave_scope();
 
 private:
-  scope_context& current_scope();
-  const scope_context& current_scope() const;
-
-private:
-  std::stack<scope_context> m_scopes;
+  std::vector<std::unique_ptr<instance_t>> m_slots;
+  // Top of the slots stack at the moment of entering each of the scopes.
+  std::vector<unsigned> m_scope_begins;
+  unsigned m_top{ 0u };
+  instance_t* m_class_instance;
 };
 }
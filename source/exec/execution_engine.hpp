@@ -0,0 +1,12 @@
+#pragma once
+
+namespace cmsl::exec {
+enum class execution_engine
+{
+  // Walks sema tree directly.
+  tree_walker,
+  // Compiles user functions to bytecode and executes it on a register
+  // virtual machine.
+  bytecode_vm
+};
+}
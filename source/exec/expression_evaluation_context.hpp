@@ -12,6 +12,7 @@ class sema_type;
 }
 
 namespace exec {
+class constant_pool;
 class function_caller;
 class identifiers_context;
 
@@ -29,6 +30,9 @@ struct expression_evaluation_context
   using expected_types_t =
     std::stack<std::reference_wrapper<const sema::sema_type>>;
   expected_types_t expected_types;
+  // Literals evaluated as read only values are taken from here. If null,
+  // they always create temporaries.
+  constant_pool* constants{ nullptr };
 };
 }
 }
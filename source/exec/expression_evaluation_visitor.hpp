@@ -2,17 +2,21 @@
 
 #include "cmake_facade.hpp"
 #include "common/assert.hpp"
+#include "exec/constant_pool.hpp"
 #include "exec/execution_context.hpp"
 #include "exec/expression_evaluation_context.hpp"
 #include "exec/function_caller.hpp"
+#include "exec/fundamental_operators.hpp"
 #include "exec/identifiers_context.hpp"
 #include "exec/instance/instance.hpp"
 #include "exec/instance/instances_holder.hpp"
+#include "sema/builtin_sema_function.hpp"
 #include "sema/sema_context.hpp"
 #include "sema/sema_node_visitor.hpp"
 #include "sema/sema_nodes.hpp"
 
 #include <algorithm>
+#include <optional>
 
 namespace cmsl::exec {
 class expression_evaluation_visitor : public sema::empty_sema_node_visitor
@@ -25,21 +29,41 @@ public:
 
   void visit(const sema::bool_value_node& node) override
   {
+    if (const auto constant = find_constant(node)) {
+      result = constant;
+      return;
+    }
+
     result = m_ctx.instances.create(node.value());
   }
 
   void visit(const sema::int_value_node& node) override
   {
+    if (const auto constant = find_constant(node)) {
+      result = constant;
+      return;
+    }
+
     result = m_ctx.instances.create(node.value());
   }
 
   void visit(const sema::double_value_node& node) override
   {
+    if (const auto constant = find_constant(node)) {
+      result = constant;
+      return;
+    }
+
     result = m_ctx.instances.create(node.value());
   }
 
   void visit(const sema::string_value_node& node) override
   {
+    if (const auto constant = find_constant(node)) {
+      result = constant;
+      return;
+    }
+
     result = m_ctx.instances.create(std::string{ node.value() });
   }
 
@@ -51,22 +75,52 @@ public:
 
   void visit(const sema::id_node& node) override
   {
-    result = m_ctx.ids_context.lookup_identifier(node.index());
+    if (const auto slot = node.slot()) {
+      result = m_ctx.ids_context.lookup_local_identifier(*slot);
+      return;
+    }
+
+    switch (node.storage()) {
+      case sema::identifier_storage::global:
+      case sema::identifier_storage::builtin:
+        result = m_ctx.ids_context.lookup_global_identifier(node.index());
+        break;
+      case sema::identifier_storage::member:
+        result = m_ctx.ids_context.lookup_member_identifier(node.index());
+        break;
+      default:
+        result = m_ctx.ids_context.lookup_identifier(node.index());
+        break;
+    }
   }
 
   void visit(const sema::binary_operator_node& node) override
   {
-    auto lhs_result = evaluate_child(node.lhs());
+    const auto& operator_function = node.operator_function();
+    const auto fundamental_kind =
+      sema::fundamental_operator_kind(operator_function);
+
+    // Lhs of an operator that modifies it can't be a shared constant.
+    const auto lhs_read_only = fundamental_kind &&
+      !sema::is_fundamental_assignment(*fundamental_kind) &&
+      !sema::assigned_value_operator(*fundamental_kind);
+    auto lhs_result = lhs_read_only ? evaluate_read_only_child(node.lhs())
+                                    : evaluate_child(node.lhs());
     if (m_ctx.cmake_facade.did_fatal_error_occure()) {
       return;
     }
 
-    auto rhs_result = evaluate_child(node.rhs());
+    // Rhs is a parameter of the operator function.
+    auto rhs_result = evaluate_read_only_child(node.rhs());
     if (m_ctx.cmake_facade.did_fatal_error_occure()) {
       return;
     }
 
-    const auto& operator_function = node.operator_function();
+    if (fundamental_kind) {
+      result = call_fundamental_operator(*fundamental_kind, *lhs_result,
+                                         *rhs_result, m_ctx.instances);
+      return;
+    }
 
     // Todo: use small vector.
     std::vector<inst::instance*> params;
@@ -311,6 +365,26 @@ private:
     return c.result;
   }
 
+  // Evaluates an expression which value is only read, so a literal can give
+  // its shared constant instead of a new temporary.
+  template <typename T>
+  inst::instance* evaluate_read_only_child(const T& child)
+  {
+    auto c = clone();
+    c.m_read_only = true;
+    child.visit(c);
+    return c.result;
+  }
+
+  inst::instance* find_constant(const sema::expression_node& node)
+  {
+    if (!m_read_only || m_ctx.constants == nullptr) {
+      return nullptr;
+    }
+
+    return m_ctx.constants->get(node);
+  }
+
   std::vector<inst::instance*> evaluate_call_parameters(
     const sema::sema_function& function,
     const sema::call_node::param_expressions_t& params)
@@ -320,7 +394,7 @@ private:
     for (auto i = 0u; i < params.size(); ++i) {
       const auto& expected_type = function.signature().params[i].ty;
       auto guard = set_expected_type(expected_type);
-      auto param = evaluate_child(*params[i]);
+      auto param = evaluate_read_only_child(*params[i]);
 
       if (m_ctx.cmake_facade.did_fatal_error_occure()) {
         return {};
@@ -424,5 +498,7 @@ private:
 
 private:
   expression_evaluation_context& m_ctx;
+  // Set when the result is only read.
+  bool m_read_only{ false };
 };
 }
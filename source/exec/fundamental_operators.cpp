@@ -0,0 +1,97 @@
+#include "exec/fundamental_operators.hpp"
+
+#include "common/assert.hpp"
+#include "exec/instance/instance.hpp"
+#include "exec/instance/instance_value_variant.hpp"
+#include "exec/instance/instances_holder_interface.hpp"
+#include "sema/builtin_function_kind.hpp"
+
+namespace cmsl::exec {
+namespace {
+void assign(inst::instance& instance, sema::fundamental_value value)
+{
+  auto accessor = instance.value_accessor();
+  switch (value.which()) {
+    case sema::fundamental_value::kind::bool_:
+      accessor.access().set_bool(value.get_bool());
+      break;
+    case sema::fundamental_value::kind::int_:
+      accessor.access().set_int(value.get_int());
+      break;
+    case sema::fundamental_value::kind::double_:
+      accessor.access().set_double(value.get_double());
+      break;
+  }
+}
+}
+
+std::optional<sema::fundamental_value> read_fundamental_value(
+  const inst::instance& instance)
+{
+  const auto& value = instance.value_cref();
+  switch (value.which()) {
+    case inst::instance_value_alternative::bool_:
+      return sema::fundamental_value{ value.get_bool() };
+    case inst::instance_value_alternative::int_:
+      return sema::fundamental_value{ value.get_int() };
+    case inst::instance_value_alternative::double_:
+      return sema::fundamental_value{ value.get_double() };
+    default:
+      return std::nullopt;
+  }
+}
+
+inst::instance_value_variant to_instance_value(sema::fundamental_value value)
+{
+  switch (value.which()) {
+    case sema::fundamental_value::kind::bool_:
+      return value.get_bool();
+    case sema::fundamental_value::kind::int_:
+      return value.get_int();
+    case sema::fundamental_value::kind::double_:
+      return value.get_double();
+  }
+
+  CMSL_UNREACHABLE("Unknown fundamental value kind");
+  return inst::instance_value_variant{};
+}
+
+inst::instance* call_fundamental_operator(
+  sema::builtin_function_kind function, inst::instance& lhs,
+  const inst::instance& rhs, inst::instances_holder_interface& instances)
+{
+  const auto rhs_value = read_fundamental_value(rhs);
+  if (!rhs_value) {
+    CMSL_UNREACHABLE("Fundamental operator called with a non fundamental "
+                     "operand");
+    return nullptr;
+  }
+
+  if (sema::is_fundamental_assignment(function)) {
+    assign(lhs, *rhs_value);
+    return instances.create_reference(lhs);
+  }
+
+  const auto lhs_value = read_fundamental_value(lhs);
+  if (!lhs_value) {
+    CMSL_UNREACHABLE("Fundamental operator called with a non fundamental "
+                     "operand");
+    return nullptr;
+  }
+
+  if (const auto assigned = sema::assigned_value_operator(function)) {
+    assign(lhs, *sema::evaluate_fundamental_operator(*assigned, *lhs_value,
+                                                     *rhs_value));
+    return instances.create_reference(lhs);
+  }
+
+  const auto result =
+    sema::evaluate_fundamental_operator(function, *lhs_value, *rhs_value);
+  if (!result) {
+    CMSL_UNREACHABLE("Calling a function that is not a fundamental operator");
+    return nullptr;
+  }
+
+  return instances.create(to_instance_value(*result));
+}
+}
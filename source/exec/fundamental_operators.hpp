@@ -0,0 +1,27 @@
+#pragma once
+
+#include "sema/fundamental_value.hpp"
+
+#include <optional>
+
+namespace cmsl::exec {
+namespace inst {
+class instance;
+class instance_value_variant;
+class instances_holder_interface;
+}
+
+// Returns nullopt if the instance is not of a fundamental type.
+std::optional<sema::fundamental_value> read_fundamental_value(
+  const inst::instance& instance);
+
+inst::instance_value_variant to_instance_value(sema::fundamental_value value);
+
+// Calls a fundamental operator, see sema::is_fundamental_operator(), without
+// going through builtin_function_caller. Such a call needs no parameters
+// vector and its result stays in the temporaries arena instead of being
+// moved to the heap. Assignments modify lhs and return a reference to it.
+inst::instance* call_fundamental_operator(
+  sema::builtin_function_kind function, inst::instance& lhs,
+  const inst::instance& rhs, inst::instances_holder_interface& instances);
+}
@@ -1,21 +1,27 @@
 #include "exec/global_executor.hpp"
 
 #include "common/assert.hpp"
+#include "exec/bytecode/virtual_machine.hpp"
 #include "exec/compiled_source.hpp"
 #include "exec/execution.hpp"
+#include "exec/module_cache.hpp"
+#include "exec/modules_prefetcher.hpp"
 #include "exec/source_compiler.hpp"
+#include "exec/source_parser.hpp"
 #include "sema/builtin_sema_context.hpp"
 #include "sema/builtin_token_provider.hpp"
 #include "sema/enum_values_context.hpp"
 #include "sema/functions_context.hpp"
 #include "sema/identifiers_context.hpp"
 #include "sema/qualified_contextes_refs.hpp"
+#include "sema/sema_tree_writer.hpp"
 #include "sema/types_context.hpp"
 #include "sema/user_sema_function.hpp"
 
 #include "cmake_facade.hpp"
 
 #include <errors/error.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iterator>
 
@@ -33,7 +39,8 @@ global_executor::directory_guard::~directory_guard()
 }
 
 global_executor::global_executor(const std::string& root_path,
-                                 facade::cmake_facade& cmake_facade)
+                                 facade::cmake_facade& cmake_facade,
+                                 execution_engine engine)
   : m_root_path{ root_path }
   , m_cmake_facade{ cmake_facade }
   , m_errors_observer{ &m_cmake_facade }
@@ -43,12 +50,24 @@ global_executor::global_executor(const std::string& root_path,
   , m_builtin_context{ create_builtin_context() }
   , m_static_variables{ m_cmake_facade, m_builtin_context->builtin_types(),
                         *this }
+  , m_module_cache{ create_module_cache() }
+  , m_engine{ engine }
 {
   m_cmake_facade.go_into_subdirectory(m_root_path);
 }
 
 global_executor::~global_executor() = default;
 
+void global_executor::set_parsing_threads_count(unsigned count)
+{
+  if (count > 1u) {
+    m_modules_prefetcher = std::make_unique<modules_prefetcher>(
+      m_strings_container, m_root_path, count);
+  } else {
+    m_modules_prefetcher.reset();
+  }
+}
+
 int global_executor::execute(std::string source)
 {
   const auto compiled =
@@ -72,6 +91,25 @@ int global_executor::execute(std::string source)
   return result->value_cref().get_int();
 }
 
+std::vector<global_executor::module_memory_usage>
+global_executor::memory_report() const
+{
+  std::vector<module_memory_usage> report;
+  report.reserve(m_compiled_sources.size());
+
+  for (const auto& [path, compiled] : m_compiled_sources) {
+    const auto& memory = compiled->memory();
+    report.push_back(
+      module_memory_usage{ path, memory.released_bytes, memory.kept_bytes });
+  }
+
+  std::sort(std::begin(report), std::end(report),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.path < rhs.path;
+            });
+  return report;
+}
+
 sema::add_subdirectory_semantic_handler::add_subdirectory_result_t
 global_executor::handle_add_subdirectory(
   cmsl::string_view name,
@@ -101,7 +139,9 @@ global_executor::handle_add_subdirectory(
     return no_script_found{};
   }
 
-  const auto compiled = compile_file(std::move(cmakesl_script_path));
+  const auto compiled = compile_file(cmakesl_script_path);
+  // Sema tree of the parent refers to main function of the subdirectory.
+  add_dependency(cmakesl_script_path);
   if (!compiled) {
     raise_unsuccessful_compilation_error(script_path_creator());
     return compilation_failed{};
@@ -122,6 +162,7 @@ std::unique_ptr<sema::qualified_contextes> global_executor::handle_import(
   cmsl::string_view path)
 {
   auto import_path = build_full_import_path(path);
+  add_dependency(import_path);
 
   if (const auto found = m_exported_qualified_contextes.find(import_path);
       found != std::cend(m_exported_qualified_contextes)) {
@@ -129,30 +170,23 @@ std::unique_ptr<sema::qualified_contextes> global_executor::handle_import(
     return std::make_unique<sema::qualified_contextes>(ctxs.clone());
   }
 
-  const auto src_view = load_source(std::move(import_path));
-  if (!src_view) {
-    //     Todo: file not found
-    return nullptr;
-  }
-
-  auto contexts = m_builtin_qualified_contexts.clone();
-  auto compiler = create_compiler(contexts);
-  auto compiled = compiler.compile(*src_view);
+  auto contexts = m_builtin_qualified_contexts.create_overlay();
+  auto compiled = compile_module_file(std::move(import_path), contexts);
   if (!compiled) {
-    // Todo: compilation failed
+    // Todo: file not found or compilation failed
     return nullptr;
   }
 
   m_static_variables.initialize_module(compiled->sema_tree());
 
   const auto& sema_tree = compiled->sema_tree();
+  const auto module_path = compiled->source().path();
 
   auto exported_stuff = contexts.collect_exported_stuff();
 
-  m_exported_qualified_contextes.emplace(src_view->path(),
-                                         exported_stuff.clone());
-  m_sema_trees.emplace(src_view->path(), sema_tree);
-  m_compiled_sources.emplace(src_view->path(), std::move(compiled));
+  m_exported_qualified_contextes.emplace(module_path, exported_stuff.clone());
+  m_sema_trees.emplace(module_path, sema_tree);
+  m_compiled_sources.emplace(module_path, std::move(compiled));
 
   return std::make_unique<sema::qualified_contextes>(
     std::move(exported_stuff));
@@ -198,6 +232,19 @@ global_executor::create_builtin_context()
     m_factories, m_errors_observer, *m_builtin_tokens, refs);
 }
 
+std::unique_ptr<module_cache> global_executor::create_module_cache() const
+{
+  // Scripts executed outside of CMake have no build directory.
+  const auto binary_dir = m_cmake_facade.get_current_binary_dir();
+  if (binary_dir.empty()) {
+    return nullptr;
+  }
+
+  auto cache_dir = binary_dir + "/CMakeSLFiles";
+  m_cmake_facade.make_directory(cache_dir);
+  return std::make_unique<module_cache>(std::move(cache_dir));
+}
+
 const sema::sema_node& global_executor::get_sema_tree(
   cmsl::string_view import_path) const
 {
@@ -227,16 +274,15 @@ source_compiler global_executor::create_compiler(
 
 cmsl::string_view global_executor::store_path(std::string path)
 {
-  auto view = cmsl::string_view{ path };
-  m_paths.emplace_back(std::move(path));
-  return view;
+  // A view of a short path would point into the moved from string.
+  return m_paths.emplace_back(std::move(path));
 }
 
-cmsl::string_view global_executor::store_source(std::string source)
+source_view global_executor::store_source(cmsl::string_view path,
+                                          std::string source)
 {
-  auto view = cmsl::string_view{ source };
-  m_sources.emplace_back(std::move(source));
-  return view;
+  const auto& stored = m_sources.emplace_back(std::move(source));
+  return source_view{ m_source_infos.emplace_back(path, stored) };
 }
 
 std::optional<source_view> global_executor::load_source(std::string path)
@@ -249,8 +295,7 @@ std::optional<source_view> global_executor::load_source(std::string path)
   }
 
   std::string source(std::istreambuf_iterator<char>{ file }, {});
-  const auto source_content_view = store_source(std::move(source));
-  return source_view{ path_view, source_content_view };
+  return store_source(path_view, std::move(source));
 }
 
 bool global_executor::file_exists(const std::string& path) const
@@ -265,42 +310,68 @@ const compiled_source* global_executor::compile_file(std::string path)
     return found->second.get();
   }
 
-  const auto src_view = load_source(std::move(path));
-  CMSL_ASSERT(src_view);
-
-  auto contexts = m_builtin_qualified_contexts.clone();
-  auto compiler = create_compiler(contexts);
-  auto compiled = compiler.compile(*src_view);
+  auto contexts = m_builtin_qualified_contexts.create_overlay();
+  auto compiled = compile_module_file(path, contexts);
   if (!compiled) {
-    raise_unsuccessful_compilation_error(src_view->path());
+    raise_unsuccessful_compilation_error(path);
     return nullptr;
   }
   const auto& sema_tree = compiled->sema_tree();
-  m_sema_trees.emplace(src_view->path(), sema_tree);
+  const auto module_path = compiled->source().path();
+  m_sema_trees.emplace(module_path, sema_tree);
 
   const auto main_function = compiled->get_main();
   if (!main_function) {
-    raise_no_main_function_error(src_view->path());
+    raise_no_main_function_error(module_path);
     return nullptr;
   }
 
   const auto compiled_ptr = compiled.get();
-  m_compiled_sources.emplace(src_view->path(), std::move(compiled));
+  m_compiled_sources.emplace(module_path, std::move(compiled));
 
   return compiled_ptr;
 }
 
+std::unique_ptr<compiled_source> global_executor::compile_module_file(
+  std::string path, sema::qualified_contextes& contexts)
+{
+  if (m_modules_prefetcher) {
+    if (auto prefetched = m_modules_prefetcher->find(path)) {
+      // Errors are reported at the same point as if the module was parsed
+      // now.
+      prefetched->deferred_errors.forward_deferred_errors(m_errors_observer);
+      if (!prefetched->parsed) {
+        return nullptr;
+      }
+
+      const auto source = prefetched->source;
+      return compile_or_load(
+        source, contexts, [source, &prefetched](auto& compiler, auto* out) {
+          return compiler.compile(source, std::move(*prefetched->parsed),
+                                  out);
+        });
+    }
+  }
+
+  const auto src_view = load_source(std::move(path));
+  if (!src_view) {
+    return nullptr;
+  }
+
+  return compile_or_load(*src_view, contexts,
+                         [src_view](auto& compiler, auto* out) {
+                           return compiler.compile(*src_view, out);
+                         });
+}
+
 const compiled_source* global_executor::compile_source(std::string source,
                                                        std::string path)
 {
-  auto contexts = m_builtin_qualified_contexts.clone();
-  auto compiler = create_compiler(contexts);
+  auto contexts = m_builtin_qualified_contexts.create_overlay();
 
   const auto source_path_view = store_path(std::move(path));
-  const auto src_view = source_view{ source_path_view, source };
-
-  m_sources.emplace_back(std::move(source));
-  auto compiled = compiler.compile(src_view);
+  const auto src_view = store_source(source_path_view, std::move(source));
+  auto compiled = compile_root_source(src_view, contexts);
   if (!compiled) {
     raise_unsuccessful_compilation_error(source_path_view);
     return nullptr;
@@ -321,6 +392,103 @@ const compiled_source* global_executor::compile_source(std::string source,
   return compiled_ptr;
 }
 
+std::unique_ptr<compiled_source> global_executor::compile_root_source(
+  source_view source, sema::qualified_contextes& contexts)
+{
+  // Nothing is prefetched if the root script is loaded from the cache.
+  // Modules that have changed are parsed when they're imported then.
+  return compile_or_load(
+    source, contexts,
+    [this, source](auto& compiler,
+                   auto* out) -> std::unique_ptr<compiled_source> {
+      if (!m_modules_prefetcher) {
+        return compiler.compile(source, out);
+      }
+
+      source_parser parser{ m_errors_observer, m_strings_container };
+      auto parsed = parser.parse(source);
+      if (!parsed) {
+        return nullptr;
+      }
+
+      // Semantic analysis of the root script runs while the scripts it
+      // refers to are being parsed.
+      m_modules_prefetcher->prefetch_referenced(
+        parsed->tokens, m_cmake_facade.current_directory());
+      return compiler.compile(source, std::move(*parsed), out);
+    });
+}
+
+std::unique_ptr<compiled_source> global_executor::compile_or_load(
+  source_view source, sema::qualified_contextes& contexts,
+  const compile_t& compile)
+{
+  if (!m_module_cache) {
+    auto compiler = create_compiler(contexts);
+    return compile(compiler, nullptr);
+  }
+
+  const auto path = std::string{ source.path() };
+  m_dependencies_stack.emplace_back();
+
+  std::unique_ptr<compiled_source> compiled;
+  if (auto cached = m_module_cache->load(source)) {
+    const auto names = store_source(source.path(), std::move(cached->names));
+    auto compiler = create_compiler(contexts);
+    compiled = compiler.load(source, names, cached->nodes);
+    if (!compiled) {
+      // Some entries may have been registered before loading failed.
+      contexts = m_builtin_qualified_contexts.create_overlay();
+      m_dependencies_stack.back().clear();
+    }
+  }
+
+  if (!compiled) {
+    const auto errors_count = m_errors_observer.notified_count();
+    std::optional<sema::serialized_sema_tree> serialized;
+    auto compiler = create_compiler(contexts);
+    compiled = compile(compiler, &serialized);
+
+    // A module is stored only if it compiles cleanly, so that its warnings
+    // are reported again on the next run.
+    if (compiled && serialized &&
+        errors_count == m_errors_observer.notified_count()) {
+      auto& dependencies = m_dependencies_stack.back();
+      std::sort(std::begin(dependencies), std::end(dependencies));
+      dependencies.erase(
+        std::unique(std::begin(dependencies), std::end(dependencies)),
+        std::end(dependencies));
+      m_module_cache->store(source, dependencies, *serialized);
+    }
+  }
+
+  auto dependencies = std::move(m_dependencies_stack.back());
+  m_dependencies_stack.pop_back();
+  m_module_dependencies[path] = dependencies;
+  for (const auto& dependency : dependencies) {
+    add_dependency(dependency);
+  }
+
+  return compiled;
+}
+
+void global_executor::add_dependency(const std::string& path)
+{
+  if (m_dependencies_stack.empty()) {
+    return;
+  }
+
+  auto& dependencies = m_dependencies_stack.back();
+  dependencies.push_back(path);
+
+  // A module depends also on the modules that its dependencies depend on.
+  const auto found = m_module_dependencies.find(path);
+  if (found != std::cend(m_module_dependencies)) {
+    dependencies.insert(std::end(dependencies), std::cbegin(found->second),
+                        std::cend(found->second));
+  }
+}
+
 std::unique_ptr<inst::instance> global_executor::execute(
   const compiled_source& compiled)
 {
@@ -330,15 +498,23 @@ std::unique_ptr<inst::instance> global_executor::execute(
 
   const auto translation_unit =
     dynamic_cast<const sema::translation_unit_node*>(&compiled.sema_tree());
-  m_execution->initialize_static_variables(*translation_unit,
-                                           m_static_variables);
 
   inst::instances_holder instances{ builtin_types };
 
   const auto main_function = compiled.get_main();
   const auto casted =
     dynamic_cast<const sema::user_sema_function*>(main_function);
-  auto main_result = m_execution->call(*casted, {}, instances);
+
+  std::unique_ptr<inst::instance> main_result;
+  if (m_engine == execution_engine::bytecode_vm) {
+    m_virtual_machine->initialize_static_variables(*translation_unit,
+                                                   m_static_variables);
+    main_result = m_virtual_machine->call(*casted, {}, instances);
+  } else {
+    m_execution->initialize_static_variables(*translation_unit,
+                                             m_static_variables);
+    main_result = m_execution->call(*casted, {}, instances);
+  }
 
   if (m_cmake_facade.did_fatal_error_occure()) {
     return nullptr;
@@ -350,6 +526,14 @@ std::unique_ptr<inst::instance> global_executor::execute(
 void global_executor::initialize_execution_if_need(
   const sema::builtin_types_accessor& builtin_types)
 {
+  if (m_engine == execution_engine::bytecode_vm) {
+    if (!m_virtual_machine) {
+      m_virtual_machine = std::make_unique<bytecode::virtual_machine>(
+        m_cmake_facade, builtin_types, m_static_variables);
+    }
+    return;
+  }
+
   if (m_execution) {
     return;
   }
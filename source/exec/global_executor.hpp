@@ -1,9 +1,11 @@
 #pragma once
 
+#include "common/source_view.hpp"
 #include "common/strings_container_impl.hpp"
 #include "errors/errors_observer.hpp"
 #include "exec/builtin_identifiers_observer.hpp"
 #include "exec/cross_translation_unit_static_variables.hpp"
+#include "exec/execution_engine.hpp"
 #include "exec/module_sema_tree_provider.hpp"
 #include "sema/add_subdirectory_semantic_handler.hpp"
 #include "sema/factories.hpp"
@@ -11,7 +13,10 @@
 #include "sema/import_handler.hpp"
 #include "sema/qualified_contextes.hpp"
 
+#include <deque>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace cmsl {
@@ -21,12 +26,19 @@ class cmake_facade;
 
 namespace sema {
 class builtin_sema_context;
+struct serialized_sema_tree;
 }
 
 namespace exec {
 class compiled_source;
 class source_compiler;
 class execution;
+class module_cache;
+class modules_prefetcher;
+
+namespace bytecode {
+class virtual_machine;
+}
 
 class global_executor
   : public sema::add_subdirectory_semantic_handler
@@ -34,12 +46,31 @@ class global_executor
   , public module_sema_tree_provider
 {
 public:
-  explicit global_executor(const std::string& root_path,
-                           facade::cmake_facade& cmake_facade);
+  // See compiled_source::memory_usage.
+  struct module_memory_usage
+  {
+    cmsl::string_view path;
+    std::size_t released_bytes;
+    std::size_t kept_bytes;
+  };
+
+  // Scripts are executed on the bytecode virtual machine by default. The tree
+  // walker stays available, to check the engines against each other.
+  explicit global_executor(
+    const std::string& root_path, facade::cmake_facade& cmake_facade,
+    execution_engine engine = execution_engine::bytecode_vm);
   ~global_executor();
 
+  // When threads count is greater than one, scripts that are reachable from
+  // the root one are lexed and parsed ahead of time, concurrently. Semantic
+  // analysis and execution stay serial. Needs to be set before execute().
+  void set_parsing_threads_count(unsigned count);
+
   int execute(std::string source);
 
+  // Memory of every module compiled so far, sorted by path.
+  std::vector<module_memory_usage> memory_report() const;
+
   add_subdirectory_result_t handle_add_subdirectory(
     cmsl::string_view name,
     const std::vector<std::unique_ptr<sema::expression_node>>& params)
@@ -57,19 +88,33 @@ private:
 
   sema::qualified_contextes create_qualified_contextes() const;
   std::unique_ptr<sema::builtin_sema_context> create_builtin_context();
+  std::unique_ptr<module_cache> create_module_cache() const;
 
   std::string build_full_import_path(cmsl::string_view import_path) const;
 
   source_compiler create_compiler(sema::qualified_contextes& ctxs);
 
   std::optional<source_view> load_source(std::string path);
-  cmsl::string_view store_source(std::string path);
+  source_view store_source(cmsl::string_view path, std::string source);
   cmsl::string_view store_path(std::string path);
 
   bool file_exists(const std::string& path) const;
 
   const compiled_source* compile_file(std::string path);
+  std::unique_ptr<compiled_source> compile_module_file(
+    std::string path, sema::qualified_contextes& contexts);
   const compiled_source* compile_source(std::string source, std::string path);
+  std::unique_ptr<compiled_source> compile_root_source(
+    source_view source, sema::qualified_contextes& contexts);
+
+  using compile_t = std::function<std::unique_ptr<compiled_source>(
+    source_compiler&, std::optional<sema::serialized_sema_tree>*)>;
+  // Loads the source from the module cache. On a miss, compiles it with the
+  // given function and stores it in the cache.
+  std::unique_ptr<compiled_source> compile_or_load(
+    source_view source, sema::qualified_contextes& contexts,
+    const compile_t& compile);
+  void add_dependency(const std::string& path);
 
   std::unique_ptr<inst::instance> execute(const compiled_source& compiled);
 
@@ -93,7 +138,8 @@ private:
   errors::errors_observer m_errors_observer;
   strings_container_impl m_strings_container;
   // Contextes are going to be initialized with builtin stuff at builtin
-  // context creation.
+  // context creation. After that they're not modified, and contextes of every
+  // compiled module overlay them.
   sema::qualified_contextes m_builtin_qualified_contexts;
   builtin_identifiers_observer m_builtin_identifiers_observer;
 
@@ -104,8 +150,24 @@ private:
 
   cross_translation_unit_static_variables m_static_variables;
 
-  std::vector<std::string> m_sources;
-  std::vector<std::string> m_paths;
+  // Null if there is no build directory to store the cache in.
+  std::unique_ptr<module_cache> m_module_cache;
+  // Paths of the modules that the modules being compiled depend on. Top of
+  // the stack belongs to the innermost one.
+  std::vector<std::vector<std::string>> m_dependencies_stack;
+  // Dependencies of every module compiled or loaded so far, including the
+  // indirect ones.
+  std::unordered_map<std::string, std::vector<std::string>>
+    m_module_dependencies;
+
+  // Deques, so that views of the stored strings stay valid.
+  std::deque<std::string> m_sources;
+  std::deque<std::string> m_paths;
+  // Line tables of the sources, for their views and tokens.
+  std::deque<source_info> m_source_infos;
+  // Owns sources of prefetched modules, so it has to outlive compiled
+  // sources.
+  std::unique_ptr<modules_prefetcher> m_modules_prefetcher;
   std::unordered_map<cmsl::string_view, std::unique_ptr<compiled_source>>
     m_compiled_sources;
   std::unordered_map<cmsl::string_view,
@@ -115,7 +177,9 @@ private:
   std::unordered_map<cmsl::string_view, sema::qualified_contextes>
     m_exported_qualified_contextes;
 
+  execution_engine m_engine;
   std::unique_ptr<execution> m_execution;
+  std::unique_ptr<bytecode::virtual_machine> m_virtual_machine;
   std::vector<std::string> m_directories;
 };
 }
@@ -11,7 +11,16 @@ class identifiers_context
 {
 public:
   virtual ~identifiers_context() = default;
+  // Searches every storage. Used when sema didn't resolve where the
+  // identifier lives.
   virtual inst::instance* lookup_identifier(unsigned index) = 0;
+  // Looks up a parameter or a local variable of the current function by its
+  // frame slot.
+  virtual inst::instance* lookup_local_identifier(unsigned slot) = 0;
+  // Looks up a variable of a module or a builtin one.
+  virtual inst::instance* lookup_global_identifier(unsigned index) = 0;
+  // Looks up a member of the current class instance.
+  virtual inst::instance* lookup_member_identifier(unsigned index) = 0;
   virtual inst::instance* get_class_instance() = 0;
 };
 }
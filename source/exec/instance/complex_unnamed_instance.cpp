@@ -95,6 +95,12 @@ std::unique_ptr<instance> complex_unnamed_instance::copy() const
                                                     copy_members());
 }
 
+std::unique_ptr<instance> complex_unnamed_instance::move()
+{
+  return std::make_unique<complex_unnamed_instance>(m_sema_type,
+                                                    std::move(m_members));
+}
+
 complex_unnamed_instance::instance_members_t
 complex_unnamed_instance::copy_members() const
 {
@@ -31,6 +31,10 @@ public:
   virtual ~instance() = default;
 
   virtual std::unique_ptr<instance> copy() const = 0;
+  // Creates an instance that takes over the value of this one. Used to move
+  // temporaries that are about to be destroyed, this instance is left in a
+  // valid but unspecified state.
+  virtual std::unique_ptr<instance> move() = 0;
 
   virtual instance_value_variant value() const = 0;
   virtual instance_value_accessor value_accessor() = 0;
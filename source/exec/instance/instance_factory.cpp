@@ -14,37 +14,7 @@ std::unique_ptr<instance> instance_factory2::create(
   instance_value_variant&& value,
   const sema::builtin_types_accessor& builtin_types) const
 {
-  const auto type_getter = [&value,
-                            &builtin_types]() -> const sema::sema_type& {
-    switch (value.which()) {
-      // Todo: cache types, don't find it over every time.
-      case instance_value_variant::which_t::bool_: {
-        return builtin_types.bool_;
-      }
-      case instance_value_variant::which_t::int_: {
-        return builtin_types.int_;
-      }
-      case instance_value_variant::which_t::double_: {
-        return builtin_types.double_;
-      }
-      case instance_value_variant::which_t::string: {
-        return builtin_types.string;
-      }
-      case instance_value_variant::which_t::library: {
-        return builtin_types.cmake->library;
-      }
-      case instance_value_variant::which_t::executable: {
-        return builtin_types.cmake->executable;
-      }
-      case instance_value_variant::which_t::option: {
-        return builtin_types.cmake->option;
-      }
-      default:
-        CMSL_UNREACHABLE("Unknown type requested");
-    }
-  };
-
-  const auto& type = type_getter();
+  const auto& type = type_of(value, builtin_types);
   return std::make_unique<simple_unnamed_instance>(type, std::move(value));
 }
 
@@ -76,4 +46,36 @@ std::unique_ptr<instance> instance_factory2::create_observable(
 {
   return std::make_unique<observable_instance>(type, std::move(observer));
 }
+
+const sema::sema_type& instance_factory2::type_of(
+  const instance_value_variant& value,
+  const sema::builtin_types_accessor& builtin_types) const
+{
+  switch (value.which()) {
+    // Todo: cache types, don't find it over every time.
+    case instance_value_variant::which_t::bool_: {
+      return builtin_types.bool_;
+    }
+    case instance_value_variant::which_t::int_: {
+      return builtin_types.int_;
+    }
+    case instance_value_variant::which_t::double_: {
+      return builtin_types.double_;
+    }
+    case instance_value_variant::which_t::string: {
+      return builtin_types.string;
+    }
+    case instance_value_variant::which_t::library: {
+      return builtin_types.cmake->library;
+    }
+    case instance_value_variant::which_t::executable: {
+      return builtin_types.cmake->executable;
+    }
+    case instance_value_variant::which_t::option: {
+      return builtin_types.cmake->option;
+    }
+    default:
+      CMSL_UNREACHABLE("Unknown type requested");
+  }
+}
 }
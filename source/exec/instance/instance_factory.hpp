@@ -40,6 +40,11 @@ public:
 
   std::unique_ptr<instance> create(const sema::sema_type& type,
                                    instance_value_variant&& value) const;
+
+  // Type of an instance created from a value without an explicit type.
+  const sema::sema_type& type_of(
+    const instance_value_variant& value,
+    const sema::builtin_types_accessor& builtin_types) const;
 };
 }
 }
@@ -44,6 +44,12 @@ std::unique_ptr<instance> instance_reference::copy() const
   return std::make_unique<instance_reference>(m_instance);
 }
 
+std::unique_ptr<instance> instance_reference::move()
+{
+  // There is nothing to take over, the referenced instance is not owned.
+  return copy();
+}
+
 instance* instance_reference::find_member(unsigned index)
 {
   return m_instance.find_member(index);
@@ -0,0 +1,169 @@
+#include "exec/instance/instances_arena.hpp"
+
+#include "exec/instance/instance.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace cmsl::exec::inst {
+instances_arena::~instances_arena()
+{
+  while (m_free_blocks != nullptr) {
+    const auto next = m_free_blocks->next;
+    delete m_free_blocks;
+    m_free_blocks = next;
+  }
+}
+
+instances_arena::block* instances_arena::acquire_block()
+{
+  if (m_free_blocks == nullptr) {
+    ++m_stats.blocks_allocated;
+    return new block;
+  }
+
+  ++m_stats.blocks_recycled;
+  const auto acquired = m_free_blocks;
+  m_free_blocks = acquired->next;
+  acquired->next = nullptr;
+  return acquired;
+}
+
+void instances_arena::release_blocks(block* blocks)
+{
+  while (blocks != nullptr) {
+    const auto next = blocks->next;
+    blocks->next = m_free_blocks;
+    m_free_blocks = blocks;
+    blocks = next;
+  }
+}
+
+instances_arena::buckets_t instances_arena::acquire_buckets()
+{
+  if (m_free_buckets.empty()) {
+    return {};
+  }
+
+  auto buckets = std::move(m_free_buckets.back());
+  m_free_buckets.pop_back();
+  return buckets;
+}
+
+void instances_arena::release_buckets(buckets_t buckets)
+{
+  if (buckets.capacity() > 0u) {
+    buckets.clear();
+    m_free_buckets.emplace_back(std::move(buckets));
+  }
+}
+
+arena_region::arena_region(instances_arena& arena)
+  : m_arena{ arena }
+  , m_buckets{ arena.acquire_buckets() }
+{
+}
+
+arena_region::~arena_region()
+{
+  reset();
+  m_arena.release_buckets(std::move(m_buckets));
+}
+
+bool arena_region::owns(const instance* instance_ptr) const
+{
+  const auto found = find_entry(instance_ptr);
+  return found != nullptr && !found->released;
+}
+
+bool arena_region::release(const instance* instance_ptr)
+{
+  const auto found = find_entry(instance_ptr);
+  if (found == nullptr || found->released) {
+    return false;
+  }
+
+  found->released = true;
+  return true;
+}
+
+void arena_region::reset()
+{
+  // Destroy in the reverse order of creation, the same way a vector of
+  // unique_ptrs would do.
+  for (auto e = m_last_entry; e != nullptr; e = e->previous) {
+    e->object->~instance();
+  }
+  m_last_entry = nullptr;
+  std::fill(std::begin(m_buckets), std::end(m_buckets), nullptr);
+  m_entries_count = 0u;
+
+  m_arena.release_blocks(m_blocks);
+  m_blocks = nullptr;
+  m_used = 0u;
+}
+
+unsigned char* arena_region::allocate(std::size_t size)
+{
+  size = align(size);
+  if (m_blocks == nullptr || m_used + size > instances_arena::k_block_size) {
+    const auto new_block = m_arena.acquire_block();
+    new_block->next = m_blocks;
+    m_blocks = new_block;
+    m_used = 0u;
+  }
+
+  const auto memory = m_blocks->data + m_used;
+  m_used += size;
+  return memory;
+}
+
+arena_region::entry* arena_region::find_entry(
+  const instance* instance_ptr) const
+{
+  if (m_entries_count == 0u) {
+    return nullptr;
+  }
+
+  for (auto e = m_buckets[bucket_of(instance_ptr)]; e != nullptr;
+       e = e->next_in_bucket) {
+    if (e->object == instance_ptr) {
+      return e;
+    }
+  }
+
+  return nullptr;
+}
+
+void arena_region::index_entry(entry* e)
+{
+  ++m_entries_count;
+  if (m_entries_count > m_buckets.size()) {
+    // Rehashing links all the entries, including the new one.
+    rehash(std::max(m_buckets.size() * 2u, k_min_buckets_count));
+    return;
+  }
+
+  auto& bucket = m_buckets[bucket_of(e->object)];
+  e->next_in_bucket = bucket;
+  bucket = e;
+}
+
+void arena_region::rehash(std::size_t buckets_count)
+{
+  m_buckets.assign(buckets_count, nullptr);
+  for (auto e = m_last_entry; e != nullptr; e = e->previous) {
+    auto& bucket = m_buckets[bucket_of(e->object)];
+    e->next_in_bucket = bucket;
+    bucket = e;
+  }
+}
+
+std::size_t arena_region::bucket_of(const instance* instance_ptr) const
+{
+  // Instances are aligned to max_align_t, so the lowest bits of their
+  // addresses are always the same.
+  const auto address = reinterpret_cast<std::uintptr_t>(instance_ptr);
+  return (address / alignof(std::max_align_t)) & (m_buckets.size() - 1u);
+}
+}
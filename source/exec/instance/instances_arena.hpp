@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cmsl::exec::inst {
+class instance;
+
+// Memory for instances created during full expression execution. Memory is
+// handed to arena_regions in fixed size blocks. Blocks are recycled, not
+// freed, so once the arena is warmed up, evaluation of a statement doesn't
+// touch the heap for its temporaries.
+class instances_arena
+{
+public:
+  struct statistics
+  {
+    // Instances created in regions of this arena.
+    std::size_t instances_created{ 0u };
+    // Blocks that had to be allocated on the heap. All the other block
+    // requests were served by recycled blocks.
+    std::size_t blocks_allocated{ 0u };
+    std::size_t blocks_recycled{ 0u };
+  };
+
+  instances_arena() = default;
+  ~instances_arena();
+
+  instances_arena(const instances_arena&) = delete;
+  instances_arena& operator=(const instances_arena&) = delete;
+
+  const statistics& stats() const { return m_stats; }
+
+private:
+  friend class arena_region;
+
+  static constexpr auto k_block_size = std::size_t{ 4096u };
+
+  struct block
+  {
+    block* next{ nullptr };
+    alignas(std::max_align_t) unsigned char data[k_block_size];
+  };
+
+  // Header of an instance created in a region. It's placed right before the
+  // instance.
+  struct entry
+  {
+    entry* previous;
+    // Next entry in the same bucket of the region's index.
+    entry* next_in_bucket;
+    instance* object;
+    bool released;
+  };
+
+  using buckets_t = std::vector<entry*>;
+
+  block* acquire_block();
+  void release_blocks(block* blocks);
+
+  // Bucket arrays of regions' indices are recycled the same way as blocks.
+  buckets_t acquire_buckets();
+  void release_buckets(buckets_t buckets);
+
+private:
+  block* m_free_blocks{ nullptr };
+  std::vector<buckets_t> m_free_buckets;
+  statistics m_stats;
+};
+
+// Monotonic allocation area in an instances_arena. Instances are bump
+// allocated and all of them are destroyed at once, when the region is reset
+// or destroyed. A region must not outlive its arena. Entries are indexed by
+// their instances in an intrusive hash table, so owns() and release() don't
+// depend on the number of instances in the region.
+class arena_region
+{
+public:
+  explicit arena_region(instances_arena& arena);
+  ~arena_region();
+
+  arena_region(const arena_region&) = delete;
+  arena_region& operator=(const arena_region&) = delete;
+
+  template <typename T, typename... Args>
+  T* create(Args&&... args)
+  {
+    static_assert(std::is_base_of_v<instance, T>);
+    constexpr auto object_offset = align(sizeof(entry));
+    static_assert(object_offset + sizeof(T) <= instances_arena::k_block_size,
+                  "Instance doesn't fit in an arena block");
+
+    auto memory = allocate(object_offset + sizeof(T));
+    auto object = new (memory + object_offset) T(std::forward<Args>(args)...);
+    m_last_entry = new (memory) entry{ m_last_entry, nullptr, object, false };
+    index_entry(m_last_entry);
+    ++m_arena.m_stats.instances_created;
+    return object;
+  }
+
+  bool owns(const instance* instance_ptr) const;
+
+  // Gives up ownership of an instance. The instance stays alive till the
+  // region is reset, so its value can be moved out of the arena.
+  bool release(const instance* instance_ptr);
+
+  // Destroys all the instances and gives blocks back to the arena.
+  void reset();
+
+private:
+  using entry = instances_arena::entry;
+
+  static constexpr auto k_min_buckets_count = std::size_t{ 16u };
+
+  static constexpr std::size_t align(std::size_t size)
+  {
+    constexpr auto alignment = alignof(std::max_align_t);
+    return (size + alignment - 1u) / alignment * alignment;
+  }
+
+  unsigned char* allocate(std::size_t size);
+  entry* find_entry(const instance* instance_ptr) const;
+  void index_entry(entry* e);
+  void rehash(std::size_t buckets_count);
+  std::size_t bucket_of(const instance* instance_ptr) const;
+
+private:
+  instances_arena& m_arena;
+  instances_arena::block* m_blocks{ nullptr };
+  std::size_t m_used{ 0u };
+  entry* m_last_entry{ nullptr };
+  // Count of buckets is a power of two. There are at least as many buckets
+  // as entries.
+  instances_arena::buckets_t m_buckets;
+  std::size_t m_entries_count{ 0u };
+};
+}
@@ -1,64 +1,85 @@
 #include "instances_holder.hpp"
+#include "exec/instance/complex_unnamed_instance.hpp"
 #include "exec/instance/instance.hpp"
+#include "exec/instance/instance_reference.hpp"
+#include "exec/instance/simple_unnamed_instance.hpp"
 #include "instance_factory.hpp"
+#include "sema/sema_type.hpp"
 
 #include "common/assert.hpp"
 
-#include <algorithm>
-
 namespace cmsl::exec::inst {
 instances_holder::instances_holder(sema::builtin_types_accessor builtin_types)
   : m_builtin_types{ builtin_types }
 {
 }
 
+instances_holder::instances_holder(sema::builtin_types_accessor builtin_types,
+                                   instances_arena& arena)
+  : m_builtin_types{ builtin_types }
+{
+  m_region.emplace(arena);
+}
+
+template <typename T, typename... Args>
+inst::instance* instances_holder::make(Args&&... args)
+{
+  if (m_region) {
+    return m_region->create<T>(std::forward<Args>(args)...);
+  }
+
+  auto instance = std::make_unique<T>(std::forward<Args>(args)...);
+  auto ptr = instance.get();
+  m_instances.emplace(ptr, std::move(instance));
+  return ptr;
+}
+
 std::unique_ptr<instance> instances_holder::gather_ownership(
   inst::instance* instance_ptr)
 {
-  auto found = std::find_if(
-    std::begin(m_instances), std::end(m_instances),
-    [instance_ptr](const auto& i) { return i.get() == instance_ptr; });
+  if (m_region && m_region->release(instance_ptr)) {
+    // Arena memory can't be handed over, so the value is moved to a new
+    // instance. The moved-from one is destroyed when the region is reset.
+    return instance_ptr->move();
+  }
 
+  auto found = m_instances.find(instance_ptr);
   if (found == std::end(m_instances)) {
     CMSL_UNREACHABLE("Gathering instance that doesn't belong to this "
                      "instances holder");
     return nullptr;
   }
 
-  auto ret = std::move(*found);
+  auto ret = std::move(found->second);
   m_instances.erase(found);
   return ret;
 }
 
 void instances_holder::store(std::unique_ptr<instance> i)
 {
-  m_instances.emplace_back(std::move(i));
+  const auto ptr = i.get();
+  m_instances.emplace(ptr, std::move(i));
 }
 
 inst::instance* instances_holder::create(instance_value_variant value)
 {
-  auto instance =
-    instance_factory2{}.create(std::move(value), m_builtin_types);
-  auto ptr = instance.get();
-  m_instances.emplace_back(std::move(instance));
-  return ptr;
+  const auto& type = instance_factory2{}.type_of(value, m_builtin_types);
+  return make<simple_unnamed_instance>(type, std::move(value));
 }
 
 inst::instance* instances_holder::create_reference(
   inst::instance& referenced_instance)
 {
-  auto instance = instance_factory2{}.create_reference(referenced_instance);
-  auto ptr = instance.get();
-  m_instances.emplace_back(std::move(instance));
-  return ptr;
+  return make<instance_reference>(referenced_instance);
 }
 
 inst::instance* instances_holder::create(const sema::sema_type& type)
 {
-  auto instance = instance_factory2{}.create(type);
-  auto ptr = instance.get();
-  m_instances.emplace_back(std::move(instance));
-  return ptr;
+  if (type.is_complex() || !type.is_builtin()) {
+    return make<complex_unnamed_instance>(type);
+  } else {
+    return make<simple_unnamed_instance>(type);
+  }
 }
 
 inst::instance* instances_holder::create_observable(
@@ -71,7 +92,7 @@ inst::instance* instances_holder::create_observable(
   auto instance =
     instance_factory2{}.create_observable(type, std::move(observer));
   auto ptr = instance.get();
-  m_instances.emplace_back(std::move(instance));
+  m_instances.emplace(ptr, std::move(instance));
   return ptr;
 }
 
@@ -83,18 +104,33 @@ inst::instance* instances_holder::create_void()
 inst::instance* instances_holder::create(const sema::sema_type& type,
                                          instance_value_variant value)
 {
-  auto instance = instance_factory2{}.create(type, std::move(value));
-  auto ptr = instance.get();
-  m_instances.emplace_back(std::move(instance));
-  return ptr;
+  return make<simple_unnamed_instance>(type, std::move(value));
 }
 
 bool instances_holder::owns(inst::instance* instance_ptr) const
 {
-  const auto found = std::find_if(
-    std::cbegin(m_instances), std::cend(m_instances),
-    [instance_ptr](const auto& i) { return i.get() == instance_ptr; });
+  if (m_region && m_region->owns(instance_ptr)) {
+    return true;
+  }
+
+  return m_instances.find(instance_ptr) != std::cend(m_instances);
+}
 
-  return found != std::cend(m_instances);
+std::unique_ptr<instance> instances_holder::gather_ownership_or_copy(
+  inst::instance* instance_ptr)
+{
+  if (owns(instance_ptr)) {
+    return gather_ownership(instance_ptr);
+  }
+
+  return instance_ptr->copy();
+}
+
+void instances_holder::clear()
+{
+  m_instances.clear();
+  if (m_region) {
+    m_region->reset();
+  }
 }
 }
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "exec/instance/instance_value_observer.hpp"
+#include "exec/instance/instances_arena.hpp"
 #include "exec/instance/instances_holder_interface.hpp"
 #include "sema/builtin_types_accessor.hpp"
 
 #include <memory>
-#include <vector>
+#include <optional>
+#include <unordered_map>
 
 namespace cmsl {
 namespace sema {
@@ -24,12 +26,18 @@ class instances_holder : public instances_holder_interface
 {
 public:
   explicit instances_holder(sema::builtin_types_accessor builtin_types);
+  // Instances are created in a region of the arena, instead of being heap
+  // allocated one by one.
+  explicit instances_holder(sema::builtin_types_accessor builtin_types,
+                            instances_arena& arena);
 
   void store(std::unique_ptr<instance> i) override;
 
   std::unique_ptr<instance> gather_ownership(
     inst::instance* instance_ptr) override;
   bool owns(inst::instance* instance_ptr) const override;
+  std::unique_ptr<instance> gather_ownership_or_copy(
+    inst::instance* instance_ptr) override;
 
   inst::instance* create(instance_value_variant value) override;
   inst::instance* create_reference(
@@ -41,9 +49,21 @@ public:
                          instance_value_variant value) override;
   inst::instance* create_void() override;
 
+  // Destroys all held instances.
+  void clear();
+
+private:
+  template <typename T, typename... Args>
+  inst::instance* make(Args&&... args);
+
 private:
   sema::builtin_types_accessor m_builtin_types;
-  std::vector<std::unique_ptr<inst::instance>> m_instances;
+  // Heap allocated instances, by their addresses. Call parameters are
+  // checked for ownership one by one, and most of them are variables that
+  // aren't held here, so it must not be a scan.
+  std::unordered_map<const inst::instance*, std::unique_ptr<inst::instance>>
+    m_instances;
+  std::optional<arena_region> m_region;
 };
 }
 }
@@ -27,6 +27,9 @@ public:
   virtual std::unique_ptr<instance> gather_ownership(
     inst::instance* instance_ptr) = 0;
   virtual bool owns(inst::instance* instance_ptr) const = 0;
+  // Takes over an instance if it's held by this holder, copies it otherwise.
+  virtual std::unique_ptr<instance> gather_ownership_or_copy(
+    inst::instance* instance_ptr) = 0;
 
   virtual inst::instance* create(instance_value_variant value) = 0;
   virtual inst::instance* create_reference(
@@ -1,26 +1,326 @@
 #include "exec/instance/list_value.hpp"
 
+#include "common/assert.hpp"
 #include "exec/instance/instance.hpp"
-#include "list_value.hpp"
+#include "exec/instance/instance_reference.hpp"
+#include "sema/sema_type.hpp"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
 
 namespace cmsl::exec::inst {
-list_value& list_value::operator=(list_value&&) = default;
-list_value::list_value(list_value&&) = default;
+namespace {
+const instance_value_variant& value_of(const instance_value_variant& element)
+{
+  return element;
+}
+
+const instance_value_variant& value_of(
+  const std::unique_ptr<instance>& element)
+{
+  return element->value_cref();
+}
+
+instance_value_variant copy_of(const instance_value_variant& element)
+{
+  return element;
+}
+
+std::unique_ptr<instance> copy_of(const std::unique_ptr<instance>& element)
+{
+  return element->copy();
+}
+
+instance_value_variant make_element(const std::vector<instance_value_variant>&,
+                                    const instance& element)
+{
+  return element.value();
+}
+
+std::unique_ptr<instance> make_element(
+  const std::deque<std::unique_ptr<instance>>&, const instance& element)
+{
+  return element.copy();
+}
+
+template <typename Container, typename Iterator>
+Container copy_elements(Iterator from, Iterator to)
+{
+  Container copied;
+  std::transform(from, to, std::back_inserter(copied),
+                 [](const auto& element) { return copy_of(element); });
+  return copied;
+}
+
+const auto values_less = [](const auto& lhs, const auto& rhs) {
+  return value_of(lhs) < value_of(rhs);
+};
+
+// Lists are indexed only when they are long enough for a hash lookup to
+// be faster than a scan, and after a repeated lookup, so a single find()
+// doesn't pay for building the index.
+constexpr int_t k_min_indexed_size{ 16 };
+constexpr unsigned k_lookups_before_indexing{ 2u };
+
+// Returns nullopt for values that can't be hashed, e.g. of a project.
+std::optional<std::size_t> hash_of(const instance_value_variant& value)
+{
+  switch (value.which()) {
+    case instance_value_alternative::bool_:
+      return std::hash<bool>{}(value.get_bool());
+    case instance_value_alternative::int_:
+      return std::hash<int_t>{}(value.get_int());
+    case instance_value_alternative::double_:
+      return std::hash<double>{}(value.get_double());
+    case instance_value_alternative::enum_:
+      return std::hash<unsigned>{}(value.get_enum_constant().value);
+    case instance_value_alternative::string:
+      return std::hash<std::string>{}(value.get_string_cref());
+    default:
+      return std::nullopt;
+  }
+}
+
+// Moves elements of the range that don't match over the first count
+// matching ones. Returns end of the kept elements.
+template <typename Iterator, typename Predicate>
+Iterator remove_matching(Iterator first, Iterator last, int_t count,
+                         Predicate&& matches)
+{
+  auto kept_end = first;
+  for (; first != last; ++first) {
+    if (count != 0 && matches(*first)) {
+      --count;
+      continue;
+    }
+
+    if (kept_end != first) {
+      *kept_end = std::move(*first);
+    }
+    ++kept_end;
+  }
+
+  return kept_end;
+}
+}
+
+// Maps hashes of the values to positions of the elements holding them, in
+// ascending order.
+class list_value::hash_index
+{
+public:
+  // Returns null if any of the values can't be hashed.
+  static std::unique_ptr<hash_index> build(const values_t& values)
+  {
+    auto index = std::make_unique<hash_index>();
+    index->m_positions.reserve(values.size());
+    for (auto i = 0u; i < values.size(); ++i) {
+      if (!index->add(values[i], static_cast<int_t>(i))) {
+        return nullptr;
+      }
+    }
+
+    return index;
+  }
+
+  bool add(const instance_value_variant& value, int_t position)
+  {
+    const auto hash = hash_of(value);
+    if (!hash) {
+      return false;
+    }
+
+    m_positions[*hash].emplace_back(position);
+    return true;
+  }
+
+  const std::vector<int_t>* positions_of(std::size_t hash) const
+  {
+    const auto found = m_positions.find(hash);
+    return found == std::cend(m_positions) ? nullptr : &found->second;
+  }
+
+private:
+  std::unordered_map<std::size_t, std::vector<int_t>> m_positions;
+};
+
+// Refers to an element that is stored by value. The element is looked up on
+// every access, so the reference stays valid when the storage of the list
+// grows. The list keeps the index up to date and detaches the reference when
+// the element goes away.
+class list_value::element_reference : public instance
+{
+public:
+  explicit element_reference(list_value& list, int_t index)
+    : m_list{ &list }
+    , m_index{ index }
+    , m_type{ *list.m_element_type }
+  {
+    m_list->m_references.emplace_back(this);
+  }
+
+  // A reference that has been detached already.
+  explicit element_reference(const sema::sema_type& type,
+                             instance_value_variant detached_value)
+    : m_list{ nullptr }
+    , m_index{ 0 }
+    , m_type{ type }
+    , m_detached_value{ std::move(detached_value) }
+  {
+  }
+
+  ~element_reference() override
+  {
+    if (m_list != nullptr) {
+      m_list->unregister_reference(*this);
+    }
+  }
+
+  instance_value_variant value() const override { return value_cref(); }
+
+  instance_value_accessor value_accessor() override
+  {
+    return instance_value_accessor{ type(), value_ref() };
+  }
+
+  const instance_value_variant& value_cref() const override
+  {
+    return m_list != nullptr ? m_list->value_at(m_index) : *m_detached_value;
+  }
+
+  void assign(instance_value_variant val) override
+  {
+    value_ref() = std::move(val);
+  }
+
+  void assign(std::unique_ptr<instance> val) override
+  {
+    value_ref() = val->value();
+  }
+
+  void assign_member(unsigned, std::unique_ptr<instance>) override
+  {
+    CMSL_UNREACHABLE("Assigning a member of a list element of builtin type");
+  }
+
+  std::unique_ptr<instance> copy() const override
+  {
+    if (m_list == nullptr) {
+      return std::make_unique<element_reference>(m_type, *m_detached_value);
+    }
+
+    return std::make_unique<element_reference>(*m_list, m_index);
+  }
+
+  std::unique_ptr<instance> move() override
+  {
+    // There is nothing to take over, the element is owned by the list.
+    return copy();
+  }
+
+  instance* find_member(unsigned) override { return nullptr; }
+  const instance* find_cmember(unsigned) const override { return nullptr; }
+
+  sema::single_scope_function_lookup_result_t find_function(
+    lexer::token name) const override
+  {
+    return type().find_member_function(name);
+  }
+
+  const sema::sema_type& type() const override { return m_type; }
+
+  int_t index() const { return m_index; }
+
+  void rebind(list_value& list) { m_list = &list; }
+  void move_to(int_t index) { m_index = index; }
+
+  // Called by the list, before the element is erased or moved.
+  void detach()
+  {
+    m_detached_value = m_list->value_at(m_index);
+    m_list = nullptr;
+  }
+
+private:
+  instance_value_variant& value_ref()
+  {
+    return m_list != nullptr ? m_list->value_ref_at(m_index)
+                             : *m_detached_value;
+  }
+
+private:
+  list_value* m_list;
+  int_t m_index;
+  const sema::sema_type& m_type;
+  std::optional<instance_value_variant> m_detached_value;
+};
+
+list_value::list_value(const sema::sema_type& element_type)
+  : m_element_type{ &element_type }
+{
+  if (element_type.is_complex() || !element_type.is_builtin()) {
+    m_elements = instances_t{};
+  }
+}
+
+list_value::list_value(list_value&& other) noexcept
+  : m_elements{ std::move(other.m_elements) }
+  , m_element_type{ other.m_element_type }
+  , m_references{ std::move(other.m_references) }
+  , m_index{ std::move(other.m_index) }
+  , m_lookups_since_change{ other.m_lookups_since_change }
+{
+  other.m_references.clear();
+  for (const auto reference : m_references) {
+    reference->rebind(*this);
+  }
+}
+
+list_value& list_value::operator=(list_value&& other) noexcept
+{
+  if (this == &other) {
+    return *this;
+  }
+
+  detach_references();
+  m_elements = std::move(other.m_elements);
+  m_element_type = other.m_element_type;
+  m_references = std::move(other.m_references);
+  other.m_references.clear();
+  for (const auto reference : m_references) {
+    reference->rebind(*this);
+  }
+  m_index = std::move(other.m_index);
+  m_lookups_since_change = other.m_lookups_since_change;
+  return *this;
+}
 
 list_value::~list_value()
 {
+  detach_references();
 }
 
-list_value::list_value(container_t values)
-  : m_list{ std::move(values) }
+list_value::list_value(elements_t elements,
+                       const sema::sema_type& element_type)
+  : m_elements{ std::move(elements) }
+  , m_element_type{ &element_type }
 {
 }
 
 list_value::list_value(const list_value& other)
+  : m_element_type{ other.m_element_type }
 {
-  append_with_copy(other);
+  m_elements = std::visit(
+    [](const auto& elements) -> elements_t {
+      using container_t = std::decay_t<decltype(elements)>;
+      return copy_elements<container_t>(std::cbegin(elements),
+                                        std::cend(elements));
+    },
+    other.m_elements);
 }
 
 list_value& list_value::operator=(const list_value& other)
@@ -29,20 +329,21 @@ list_value& list_value::operator=(const list_value& other)
     return *this;
   }
 
-  m_list.clear();
-  append_with_copy(other);
-
+  *this = list_value{ other };
   return *this;
 }
 
 bool list_value::operator==(const list_value& other) const
 {
-  const auto pred = [](const auto& lhs_instance, const auto& rhs_instance) {
-    return lhs_instance->value_cref() == rhs_instance->value_cref();
-  };
-
-  return std::equal(std::cbegin(m_list), std::cend(m_list),
-                    std::cbegin(other.m_list), std::cend(other.m_list), pred);
+  return std::visit(
+    [](const auto& lhs, const auto& rhs) {
+      return std::equal(
+        std::cbegin(lhs), std::cend(lhs), std::cbegin(rhs), std::cend(rhs),
+        [](const auto& lhs_element, const auto& rhs_element) {
+          return value_of(lhs_element) == value_of(rhs_element);
+        });
+    },
+    m_elements, other.m_elements);
 }
 
 bool list_value::operator!=(const list_value& other) const
@@ -52,12 +353,13 @@ bool list_value::operator!=(const list_value& other) const
 
 bool list_value::operator<(const list_value& other) const
 {
-  const auto pred = [](const auto& lhs_instance, const auto& rhs_instance) {
-    return lhs_instance->value_cref() < rhs_instance->value_cref();
-  };
-
-  return std::lexicographical_compare(cbegin(), cend(), other.cbegin(),
-                                      other.cend(), pred);
+  return std::visit(
+    [](const auto& lhs, const auto& rhs) {
+      return std::lexicographical_compare(std::cbegin(lhs), std::cend(lhs),
+                                          std::cbegin(rhs), std::cend(rhs),
+                                          values_less);
+    },
+    m_elements, other.m_elements);
 }
 
 bool list_value::operator<=(const list_value& other) const
@@ -75,103 +377,172 @@ bool list_value::operator>=(const list_value& other) const
   return *this == other || *this > other;
 }
 
-void list_value::append_with_copy(const list_value& other)
+void list_value::push_back(const instance& element)
 {
-  append_with_copy_to(other, m_list);
-}
-
-void list_value::append_with_copy_to(const list_value& other,
-                                     container_t& container) const
-{
-  std::transform(std::cbegin(other.m_list), std::cend(other.m_list),
-                 std::back_inserter(container),
-                 [](const auto& element) { return element->copy(); });
+  insert(size(), element);
 }
 
 void list_value::push_back(list_value::element_t element)
 {
-  m_list.emplace_back(std::move(element));
+  if (auto instances = std::get_if<instances_t>(&m_elements)) {
+    instances->emplace_back(std::move(element));
+    return;
+  }
+
+  push_back(*element);
 }
 
 void list_value::push_back(const list_value& other)
 {
-  append_with_copy(other);
+  insert(size(), other);
 }
 
-void list_value::push_front(element_t element)
+void list_value::push_front(const instance& element)
 {
-  m_list.emplace(std::begin(m_list), std::move(element));
+  insert(0, element);
 }
 
 void list_value::push_front(const list_value& other)
 {
-  auto copied = copy(other);
-  m_list.insert(std::begin(m_list),
-                std::make_move_iterator(std::begin(copied)),
-                std::make_move_iterator(std::end(copied)));
+  insert(0, other);
 }
 
 void list_value::pop_back()
 {
-  m_list.pop_back();
+  references_erased(size() - 1, 1);
+  invalidate_index();
+  std::visit([](auto& elements) { elements.pop_back(); }, m_elements);
 }
 
 void list_value::pop_front()
 {
-  m_list.pop_front();
+  references_erased(0, 1);
+  invalidate_index();
+  std::visit([](auto& elements) { elements.erase(std::begin(elements)); },
+             m_elements);
 }
 
-instance& list_value::at(int_t index)
+std::unique_ptr<instance> list_value::reference_at(int_t index)
 {
-  auto& instance_ptr = m_list.at(static_cast<unsigned>(index));
-  return *instance_ptr;
+  if (auto instances = std::get_if<instances_t>(&m_elements)) {
+    // Lists of instances are not indexed, there is nothing to invalidate.
+    auto& instance_ptr = instances->at(static_cast<unsigned>(index));
+    return std::make_unique<instance_reference>(*instance_ptr);
+  }
+
+  return std::make_unique<element_reference>(*this, index);
 }
 
-const instance& list_value::at(int_t index) const
+const instance_value_variant& list_value::value_at(int_t index) const
 {
-  auto& instance_ptr = m_list.at(static_cast<unsigned>(index));
-  return *instance_ptr;
+  return std::visit(
+    [index](const auto& elements) -> const instance_value_variant& {
+      return value_of(elements.at(static_cast<unsigned>(index)));
+    },
+    m_elements);
 }
 
-instance& list_value::front()
+instance_value_variant& list_value::value_ref_at(int_t index)
 {
-  auto& instance_ptr = m_list.front();
-  return *instance_ptr;
+  // The value is going to be modified.
+  invalidate_index();
+  return std::get<values_t>(m_elements).at(static_cast<unsigned>(index));
 }
 
-instance& list_value::back()
+const list_value::hash_index* list_value::lookup_index() const
 {
-  auto& instance_ptr = m_list.back();
-  return *instance_ptr;
+  if (m_index != nullptr) {
+    return m_index.get();
+  }
+
+  const auto values = std::get_if<values_t>(&m_elements);
+  if (values == nullptr || size() < k_min_indexed_size ||
+      ++m_lookups_since_change < k_lookups_before_indexing) {
+    return nullptr;
+  }
+
+  m_index = hash_index::build(*values);
+  return m_index.get();
 }
 
-void list_value::insert(int_t pos, element_t element)
+void list_value::index_appended(int_t from)
 {
-  const auto where = place(pos);
-  m_list.emplace(where, std::move(element));
+  if (m_index == nullptr) {
+    return;
+  }
+
+  for (auto i = from; i < size(); ++i) {
+    if (!m_index->add(value_at(i), i)) {
+      invalidate_index();
+      return;
+    }
+  }
 }
 
-void list_value::insert(int_t pos, const list_value& other)
+void list_value::invalidate_index()
 {
-  auto copied = copy(other);
-  const auto where = place(pos);
-  m_list.insert(where, std::make_move_iterator(std::begin(copied)),
-                std::make_move_iterator(std::end(copied)));
+  m_index.reset();
+  m_lookups_since_change = 0u;
 }
 
-list_value::container_t list_value::copy(const list_value& other) const
+void list_value::insert(int_t pos, const instance& element)
 {
-  container_t copied;
-  append_with_copy_to(other, copied);
-  return copied;
+  const auto appended = pos == size();
+  std::visit(
+    [pos, &element](auto& elements) {
+      elements.emplace(std::next(std::begin(elements), pos),
+                       make_element(elements, element));
+    },
+    m_elements);
+
+  references_inserted(pos, 1);
+  if (appended) {
+    index_appended(pos);
+  } else {
+    invalidate_index();
+  }
+}
+
+void list_value::insert(int_t pos, const list_value& other)
+{
+  if (other.empty()) {
+    return;
+  }
+
+  const auto inserted_count = other.size();
+  const auto appended = pos == size();
+  std::visit(
+    [pos, &other](auto& elements) {
+      using container_t = std::decay_t<decltype(elements)>;
+      const auto& other_elements = std::get<container_t>(other.m_elements);
+      // Copied first, as other may be this list.
+      auto copied = copy_elements<container_t>(std::cbegin(other_elements),
+                                               std::cend(other_elements));
+      elements.insert(std::next(std::begin(elements), pos),
+                      std::make_move_iterator(std::begin(copied)),
+                      std::make_move_iterator(std::end(copied)));
+    },
+    m_elements);
+
+  references_inserted(pos, inserted_count);
+  if (appended) {
+    index_appended(pos);
+  } else {
+    invalidate_index();
+  }
 }
 
 void list_value::erase(int_t pos, int_t count)
 {
   count = interpret_special_value(count, 1);
-  const auto where = place(pos);
-  const auto end = place(pos + count);
-  m_list.erase(where, end);
+  references_erased(pos, count);
+  invalidate_index();
+  std::visit(
+    [pos, count](auto& elements) {
+      const auto where = std::next(std::begin(elements), pos);
+      elements.erase(where, std::next(where, count));
+    },
+    m_elements);
 }
 
 int_t list_value::interpret_special_value(int_t value,
@@ -180,154 +551,305 @@ int_t list_value::interpret_special_value(int_t value,
   return value == k_special_value ? special_value : value;
 }
 
-list_value::container_t::const_iterator list_value::place(int_t pos) const
-{
-  return std::next(cbegin(), pos);
-}
-
 int_t list_value::remove(const instance& value, int_t count)
 {
-  return remove_impl(value, count, [](const auto i) { return i; });
+  return remove_impl(value, count, /*from_back=*/false);
 }
 
 int_t list_value::remove_last(const instance& value, int_t count)
 {
-  return remove_impl(value, count, [&list = m_list](const auto i) {
-    return list.size() - 1 - i;
-  });
+  return remove_impl(value, count, /*from_back=*/true);
 }
 
-template <typename IndexCalculator>
 int_t list_value::remove_impl(const instance& value, int_t count,
-                              IndexCalculator&& indexCalculator)
-{
-  int_t erased_counter{ 0 };
-  count = interpret_special_value(count, m_list.size());
-  auto i{ 0u };
-  while (i < m_list.size() && count != 0) {
-    const auto check_index = indexCalculator(i);
-    if (m_list[check_index]->value_cref() != value.value_cref()) {
-      ++i;
-      continue;
-    }
-
-    erase(check_index);
-    --count;
-    ++erased_counter;
+                              bool from_back)
+{
+  count = interpret_special_value(count, size());
+  // Lookup is cheap when the list is indexed, so lists that don't hold the
+  // value are left untouched, with their index.
+  if (count == 0 || !contains(value)) {
+    return 0;
   }
 
-  return erased_counter;
+  detach_references();
+  invalidate_index();
+  const auto& removed_value = value.value_cref();
+  return std::visit(
+    [count, from_back, &removed_value](auto& elements) -> int_t {
+      const auto matches = [&removed_value](const auto& element) {
+        return value_of(element) == removed_value;
+      };
+
+      auto first = std::begin(elements);
+      if (from_back) {
+        // Start from the count-th matching element from the back, so all
+        // the matching ones after it are removed.
+        auto left = count;
+        auto it = std::end(elements);
+        while (it != first && left != 0) {
+          --it;
+          if (matches(*it)) {
+            --left;
+          }
+        }
+        first = it;
+      }
+
+      const auto kept_end =
+        remove_matching(first, std::end(elements), count, matches);
+      const auto erased_count = std::distance(kept_end, std::end(elements));
+      elements.erase(kept_end, std::end(elements));
+      return static_cast<int_t>(erased_count);
+    },
+    m_elements);
 }
 
 void list_value::clear()
 {
-  m_list.clear();
+  detach_references();
+  invalidate_index();
+  std::visit([](auto& elements) { elements.clear(); }, m_elements);
 }
 
 void list_value::resize(int_t new_size, const instance* fill)
 {
-  const auto old_size = size();
-  m_list.resize(static_cast<unsigned>(new_size));
-
-  if (old_size < new_size) {
-    std::generate(std::next(begin(), old_size), end(),
-                  [fill] { return fill->copy(); });
+  if (new_size < size()) {
+    references_erased(new_size, size() - new_size);
   }
+
+  invalidate_index();
+
+  std::visit(
+    [new_size, fill](auto& elements) {
+      const auto old_size = static_cast<int_t>(elements.size());
+      if (new_size <= old_size) {
+        elements.erase(std::next(std::begin(elements), new_size),
+                       std::end(elements));
+        return;
+      }
+
+      for (auto i = old_size; i < new_size; ++i) {
+        elements.emplace_back(make_element(elements, *fill));
+      }
+    },
+    m_elements);
 }
 
 void list_value::sort()
 {
-  const auto pred = [](const auto& lhs, const auto& rhs) {
-    return lhs->value_cref() < rhs->value_cref();
-  };
-
-  std::sort(begin(), end(), pred);
+  detach_references();
+  invalidate_index();
+  std::visit(
+    [](auto& elements) {
+      std::sort(std::begin(elements), std::end(elements), values_less);
+    },
+    m_elements);
 }
 
 void list_value::reverse()
 {
-  std::reverse(begin(), end());
+  references_reversed();
+  invalidate_index();
+  std::visit(
+    [](auto& elements) {
+      std::reverse(std::begin(elements), std::end(elements));
+    },
+    m_elements);
 }
 
 int_t list_value::min() const
 {
-  const auto pred = [](const auto& lhs, const auto& rhs) {
-    return lhs->value_cref() < rhs->value_cref();
-  };
-  const auto min_it = std::min_element(cbegin(), cend(), pred);
-  if (min_it == cend()) {
-    return -1;
-  }
+  return std::visit(
+    [](const auto& elements) -> int_t {
+      const auto min_it = std::min_element(std::cbegin(elements),
+                                           std::cend(elements), values_less);
+      if (min_it == std::cend(elements)) {
+        return -1;
+      }
 
-  const auto index = std::distance(cbegin(), min_it);
-  return static_cast<int_t>(index);
+      return std::distance(std::cbegin(elements), min_it);
+    },
+    m_elements);
 }
 
 int_t list_value::max() const
 {
-  const auto pred = [](const auto& lhs, const auto& rhs) {
-    return lhs->value_cref() < rhs->value_cref();
-  };
-  const auto max_it = std::max_element(cbegin(), cend(), pred);
-  if (max_it == cend()) {
-    return -1;
-  }
+  return std::visit(
+    [](const auto& elements) -> int_t {
+      const auto max_it = std::max_element(std::cbegin(elements),
+                                           std::cend(elements), values_less);
+      if (max_it == std::cend(elements)) {
+        return -1;
+      }
 
-  const auto index = std::distance(cbegin(), max_it);
-  return static_cast<int_t>(index);
+      return std::distance(std::cbegin(elements), max_it);
+    },
+    m_elements);
 }
 
-list_value::container_t::iterator list_value::begin()
+list_value list_value::sublist(int_t pos, int_t count) const
 {
-  return std::begin(m_list);
+  count = interpret_special_value(count, size() - pos);
+  auto copied = std::visit(
+    [pos, count](const auto& elements) -> elements_t {
+      using container_t = std::decay_t<decltype(elements)>;
+      const auto from = std::next(std::cbegin(elements), pos);
+      return copy_elements<container_t>(from, std::next(from, count));
+    },
+    m_elements);
+
+  return list_value{ std::move(copied), *m_element_type };
 }
 
-list_value::container_t::iterator list_value::end()
+int_t list_value::size() const
 {
-  return std::end(m_list);
+  return std::visit(
+    [](const auto& elements) { return static_cast<int_t>(elements.size()); },
+    m_elements);
 }
 
-list_value::container_t::const_iterator list_value::cbegin() const
+bool list_value::empty() const
 {
-  return std::cbegin(m_list);
+  return size() == 0;
 }
 
-list_value::container_t::const_iterator list_value::cend() const
+int_t list_value::find(const instance& value, int_t pos) const
 {
-  return std::cend(m_list);
-}
+  pos = interpret_special_value(pos, 0);
+  const auto& found_value = value.value_cref();
+  const auto hash = hash_of(found_value);
+  if (const auto index = hash ? lookup_index() : nullptr) {
+    const auto positions = index->positions_of(*hash);
+    if (positions == nullptr) {
+      return -1;
+    }
 
-list_value list_value::sublist(int_t pos, int_t count) const
+    const auto start =
+      std::lower_bound(std::cbegin(*positions), std::cend(*positions), pos);
+    const auto found =
+      std::find_if(start, std::cend(*positions), [&](const auto position) {
+        return value_at(position) == found_value;
+      });
+    return found == std::cend(*positions) ? -1 : *found;
+  }
+
+  return std::visit(
+    [pos, &found_value](const auto& elements) -> int_t {
+      const auto start = std::next(std::cbegin(elements), pos);
+      const auto found =
+        std::find_if(start, std::cend(elements), [&](const auto& element) {
+          return value_of(element) == found_value;
+        });
+
+      return found == std::cend(elements)
+        ? -1
+        : std::distance(std::cbegin(elements), found);
+    },
+    m_elements);
+}
+
+bool list_value::contains(const instance& value) const
+{
+  return find(value) != -1;
+}
+
+int_t list_value::unique()
+{
+  detach_references();
+  invalidate_index();
+  return std::visit(
+    [](auto& elements) -> int_t {
+      // Positions of the kept elements, by hashes of their values.
+      std::unordered_map<std::size_t, std::vector<std::size_t>> kept;
+      auto kept_end = std::begin(elements);
+      for (auto it = std::begin(elements); it != std::end(elements); ++it) {
+        const auto& value = value_of(*it);
+        const auto is_equal = [&value](const auto& element) {
+          return value_of(element) == value;
+        };
+
+        const auto kept_count = static_cast<std::size_t>(
+          std::distance(std::begin(elements), kept_end));
+        bool duplicated;
+        if (const auto hash = hash_of(value)) {
+          auto& positions = kept[*hash];
+          duplicated = std::any_of(
+            std::cbegin(positions), std::cend(positions),
+            [&](const auto position) { return is_equal(elements[position]); });
+          if (!duplicated) {
+            positions.emplace_back(kept_count);
+          }
+        } else {
+          duplicated = std::any_of(std::begin(elements), kept_end, is_equal);
+        }
+
+        if (duplicated) {
+          continue;
+        }
+
+        if (kept_end != it) {
+          *kept_end = std::move(*it);
+        }
+        ++kept_end;
+      }
+
+      const auto removed_count = std::distance(kept_end, std::end(elements));
+      elements.erase(kept_end, std::end(elements));
+      return static_cast<int_t>(removed_count);
+    },
+    m_elements);
+}
+
+void list_value::unregister_reference(const element_reference& reference)
 {
-  count = interpret_special_value(count, m_list.size() - pos);
-  const auto from = place(pos);
-  const auto to = place(pos + count);
-  container_t copied;
-  std::transform(from, to, std::back_inserter(copied),
-                 [](const auto& element) { return element->copy(); });
+  const auto found =
+    std::find(std::cbegin(m_references), std::cend(m_references), &reference);
+  CMSL_ASSERT(found != std::cend(m_references));
+  m_references.erase(found);
+}
 
-  return list_value{ std::move(copied) };
+void list_value::references_inserted(int_t pos, int_t count)
+{
+  for (const auto reference : m_references) {
+    if (reference->index() >= pos) {
+      reference->move_to(reference->index() + count);
+    }
+  }
 }
 
-int_t list_value::size() const
+void list_value::references_erased(int_t pos, int_t count)
 {
-  return static_cast<int_t>(m_list.size());
+  // References are few and short-lived, usually there are none.
+  auto kept_end = std::begin(m_references);
+  for (const auto reference : m_references) {
+    const auto index = reference->index();
+    if (index >= pos && index < pos + count) {
+      reference->detach();
+      continue;
+    }
+
+    if (index >= pos + count) {
+      reference->move_to(index - count);
+    }
+    *kept_end++ = reference;
+  }
+
+  m_references.erase(kept_end, std::end(m_references));
 }
 
-bool list_value::empty() const
+void list_value::references_reversed()
 {
-  return m_list.empty();
+  for (const auto reference : m_references) {
+    reference->move_to(size() - 1 - reference->index());
+  }
 }
 
-int_t list_value::find(const instance& value, int_t pos) const
+void list_value::detach_references()
 {
-  pos = interpret_special_value(pos, 0);
-  const auto start = place(pos);
-  const auto found =
-    std::find_if(start, cend(), [&value](const auto& element) {
-      return element->value_cref() == value.value_cref();
-    });
+  for (const auto reference : m_references) {
+    reference->detach();
+  }
 
-  return found == cend() ? -1 : std::distance(cbegin(), found);
+  m_references.clear();
 }
 }
@@ -4,24 +4,43 @@
 
 #include <deque>
 #include <memory>
+#include <variant>
+#include <vector>
 
-namespace cmsl::exec::inst {
-class instance;
+namespace cmsl {
+namespace sema {
+class sema_type;
+}
 
+namespace exec::inst {
+class instance;
+class instance_value_variant;
+
+// Elements of builtin types, e.g. of list<string>, are stored by value in a
+// contiguous vector. Only elements of user types, which have members, are
+// stored as separate instances. Which storage is used is decided by the
+// element type, that comes from the sema type of the list.
+//
+// Lookups in a list of values, e.g. find() or contains(), build a hash index
+// of the elements when they are repeated. The index is kept up to date while
+// elements are appended and dropped on any other modification.
 class list_value
 {
 private:
   using element_t = std::unique_ptr<instance>;
-  using container_t = std::deque<element_t>;
+  using instances_t = std::deque<element_t>;
+  using values_t = std::vector<instance_value_variant>;
+  using elements_t = std::variant<values_t, instances_t>;
 
   static constexpr int_t k_special_value{ -1 };
 
 public:
-  list_value() = default;
-  explicit list_value(container_t values);
+  explicit list_value(const sema::sema_type& element_type);
 
-  list_value(list_value&&);
-  list_value& operator=(list_value&&);
+  // Noexcept, so that a vector of lists moves them when it grows. References
+  // to elements of a moved list follow it.
+  list_value(list_value&& other) noexcept;
+  list_value& operator=(list_value&& other) noexcept;
 
   list_value(const list_value& other);
   list_value& operator=(const list_value& other);
@@ -35,19 +54,25 @@ public:
   bool operator>(const list_value& other) const;
   bool operator>=(const list_value& other) const;
 
+  // Elements are copied, except of the ones passed with ownership.
+  void push_back(const instance& element);
   void push_back(element_t element);
   void push_back(const list_value& other);
-  void push_front(element_t element);
+  void push_front(const instance& element);
   void push_front(const list_value& other);
   void pop_back();
   void pop_front();
 
-  instance& at(int_t index);
-  const instance& at(int_t index) const;
-  instance& front();
-  instance& back();
+  // Returns an instance that refers to the element at index. A reference to
+  // an element stored by value keeps referring to the same element when
+  // other elements are inserted or erased, e.g. by a function called later
+  // in the same expression. When the element itself is erased, or the list
+  // is reordered or destroyed, the reference is detached and keeps a copy
+  // of the last value of the element.
+  std::unique_ptr<instance> reference_at(int_t index);
+  const instance_value_variant& value_at(int_t index) const;
 
-  void insert(int_t pos, element_t element);
+  void insert(int_t pos, const instance& element);
   void insert(int_t pos, const list_value& other);
 
   void erase(int_t pos, int_t count = k_special_value);
@@ -69,28 +94,46 @@ public:
   bool empty() const;
 
   int_t find(const instance& value, int_t pos = k_special_value) const;
+  bool contains(const instance& value) const;
+
+  // Removes all but the first occurrence of every value. Returns count of the
+  // removed elements.
+  int_t unique();
   // Todo: implement when instance factory is available here.
   // list_value find_all(const instance& value, int_t pos = k_special_value);
 
 private:
-  void append_with_copy(const list_value& other);
-  void append_with_copy_to(const list_value& other,
-                           container_t& container) const;
+  class element_reference;
+  class hash_index;
+
+  explicit list_value(elements_t elements,
+                      const sema::sema_type& element_type);
+
+  instance_value_variant& value_ref_at(int_t index);
+
+  // Returns the index if it's worth to use it, null otherwise.
+  const hash_index* lookup_index() const;
+  void index_appended(int_t from);
+  void invalidate_index();
 
-  container_t copy(const list_value& other) const;
   int_t interpret_special_value(int_t value, int_t special_value) const;
-  container_t::const_iterator place(int_t pos) const;
 
-  template <typename IndexCalculator>
-  int_t remove_impl(const instance& value, int_t count,
-                    IndexCalculator&& indexCalculator);
+  int_t remove_impl(const instance& value, int_t count, bool from_back);
 
-  container_t::iterator begin();
-  container_t::iterator end();
-  container_t::const_iterator cbegin() const;
-  container_t::const_iterator cend() const;
+  void unregister_reference(const element_reference& reference);
+  // Keep references pointing at their elements.
+  void references_inserted(int_t pos, int_t count);
+  void references_erased(int_t pos, int_t count);
+  void references_reversed();
+  void detach_references();
 
 private:
-  container_t m_list;
+  elements_t m_elements;
+  const sema::sema_type* m_element_type;
+  // Alive references to elements stored by value.
+  std::vector<element_reference*> m_references;
+  mutable std::unique_ptr<hash_index> m_index;
+  mutable unsigned m_lookups_since_change{ 0u };
 };
 }
+}
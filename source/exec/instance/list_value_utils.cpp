@@ -1,5 +1,5 @@
 #include "exec/instance/list_value_utils.hpp"
-#include "exec/instance/instance.hpp"
+#include "exec/instance/instance_value_variant.hpp"
 #include "exec/instance/list_value.hpp"
 
 namespace cmsl::exec::inst {
@@ -15,8 +15,7 @@ std::vector<std::string> list_value_utils::strings(
   collected.reserve(m_list.size());
 
   for (auto i = 0u; i < m_list.size(); ++i) {
-    const auto& instance = m_list.at(i);
-    const auto& source = instance.value_cref().get_string_cref();
+    const auto& source = m_list.value_at(i).get_string_cref();
     const auto full_source_path = prefix + source;
     collected.emplace_back(full_source_path);
   }
@@ -51,6 +51,12 @@ std::unique_ptr<instance> observable_instance::copy() const
     type(), instance_value_variant{ value_cref() }, m_observer);
 }
 
+std::unique_ptr<instance> observable_instance::move()
+{
+  // Observed value can't be stolen without notifying the observer.
+  return copy();
+}
+
 instance* observable_instance::find_member(unsigned index)
 {
   return m_instance.find_member(index);
@@ -26,6 +26,7 @@ public:
   void assign_member(unsigned index, std::unique_ptr<instance> val) override;
 
   std::unique_ptr<instance> copy() const override;
+  std::unique_ptr<instance> move() override;
 
   instance* find_member(unsigned index) override;
   const instance* find_cmember(unsigned index) const override;
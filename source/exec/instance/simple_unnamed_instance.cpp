@@ -3,6 +3,7 @@
 #include "common/assert.hpp"
 #include "exec/instance/instance_value_accessor.hpp"
 #include "exec/instance/instance_value_variant.hpp"
+#include "sema/homogeneous_generic_type.hpp"
 #include "sema/sema_type.hpp"
 
 namespace cmsl::exec::inst {
@@ -34,7 +35,9 @@ instance_value_variant simple_unnamed_instance::create_init_data() const
   } else if (name == "version") {
     return version_value{ 0u };
   } else if (starts_with(name, "list")) {
-    return list_value{};
+    const auto& list_type =
+      static_cast<const sema::homogeneous_generic_type&>(m_sema_type);
+    return list_value{ list_type.value_type() };
   } else if (name == "project") {
     return project_value{ "" };
   } else if (name == "option") {
@@ -97,6 +100,12 @@ std::unique_ptr<instance> simple_unnamed_instance::copy() const
   return std::make_unique<simple_unnamed_instance>(m_sema_type, value());
 }
 
+std::unique_ptr<instance> simple_unnamed_instance::move()
+{
+  return std::make_unique<simple_unnamed_instance>(m_sema_type,
+                                                   std::move(m_data));
+}
+
 sema::single_scope_function_lookup_result_t
 simple_unnamed_instance::find_function(lexer::token name) const
 {
@@ -0,0 +1,140 @@
+#include "exec/module_cache.hpp"
+
+#include "sema/sema_tree_format.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace cmsl::exec {
+namespace {
+constexpr cmsl::string_view k_magic = "CMSLSEMA";
+
+std::optional<std::string> read_file(const std::string& path)
+{
+  std::ifstream file{ path, std::ios::binary };
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  return std::string(std::istreambuf_iterator<char>{ file }, {});
+}
+
+void write_source_key(sema::sema_tree_format::output& out,
+                      cmsl::string_view source)
+{
+  out.write_u64(module_cache::hash(source));
+  out.write_u64(source.size());
+}
+
+bool read_source_key(sema::sema_tree_format::input& in,
+                     cmsl::string_view source)
+{
+  const auto source_hash = in.read_u64();
+  const auto source_size = in.read_u64();
+  return !in.failed() && source_size == source.size() &&
+    source_hash == module_cache::hash(source);
+}
+}
+
+module_cache::module_cache(std::string cache_dir)
+  : m_cache_dir{ std::move(cache_dir) }
+{
+}
+
+std::optional<sema::serialized_sema_tree> module_cache::load(
+  const source_view& source) const
+{
+  const auto entry = read_file(entry_path(source.path()));
+  if (!entry) {
+    return std::nullopt;
+  }
+
+  sema::sema_tree_format::input in{ *entry };
+  if (in.read_string() != k_magic ||
+      in.read_u32() != sema::sema_tree_format::k_version ||
+      !read_source_key(in, source.source())) {
+    return std::nullopt;
+  }
+
+  // Sema tree depends on what the imported modules export, so it's stale
+  // when any of them has changed.
+  const auto dependencies_count = in.read_u32();
+  for (auto i = 0u; i < dependencies_count && !in.failed(); ++i) {
+    const auto dependency =
+      read_file(std::string{ in.read_string() }).value_or(std::string{});
+    if (!read_source_key(in, dependency)) {
+      return std::nullopt;
+    }
+  }
+
+  sema::serialized_sema_tree tree;
+  tree.names = std::string{ in.read_string() };
+  tree.nodes = std::string{ in.read_string() };
+  if (in.failed() || !in.at_end()) {
+    return std::nullopt;
+  }
+
+  return tree;
+}
+
+void module_cache::store(const source_view& source,
+                         const std::vector<std::string>& dependencies,
+                         const sema::serialized_sema_tree& tree) const
+{
+  sema::sema_tree_format::output out;
+  out.write_string(k_magic);
+  out.write_u32(sema::sema_tree_format::k_version);
+  write_source_key(out, source.source());
+
+  out.write_u32(static_cast<std::uint32_t>(dependencies.size()));
+  for (const auto& dependency : dependencies) {
+    const auto dependency_source = read_file(dependency);
+    if (!dependency_source) {
+      return;
+    }
+
+    out.write_string(dependency);
+    write_source_key(out, *dependency_source);
+  }
+
+  out.write_string(tree.names);
+  out.write_string(tree.nodes);
+
+  std::ofstream file{ entry_path(source.path()),
+                      std::ios::binary | std::ios::trunc };
+  if (!file.is_open()) {
+    // Cache is only an optimization. Nothing bad happens if it can't be
+    // written.
+    return;
+  }
+
+  const auto data = out.take();
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+std::uint64_t module_cache::hash(cmsl::string_view data)
+{
+  auto result = std::uint64_t{ 14695981039346656037u };
+  for (const auto c : data) {
+    result ^= static_cast<unsigned char>(c);
+    result *= std::uint64_t{ 1099511628211u };
+  }
+
+  return result;
+}
+
+std::string module_cache::entry_path(cmsl::string_view module_path) const
+{
+  // Paths may contain characters that are not allowed in a file name, so the
+  // entry is named after the path hash.
+  constexpr auto hex_digits = "0123456789abcdef";
+  auto path_hash = hash(module_path);
+  std::string name(16u, '0');
+  for (auto it = std::rbegin(name); it != std::rend(name); ++it) {
+    *it = hex_digits[path_hash & 0xfu];
+    path_hash >>= 4u;
+  }
+
+  return m_cache_dir + '/' + name + ".sema";
+}
+}
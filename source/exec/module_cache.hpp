@@ -0,0 +1,40 @@
+#pragma once
+
+#include "common/source_view.hpp"
+#include "sema/sema_tree_writer.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace cmsl::exec {
+// On-disk cache of analysed modules, stored in the build directory. An entry
+// keeps the serialized sema tree of a module, so re-configuring with
+// unchanged scripts doesn't lex, parse nor analyse them again. It's found by
+// the module path and is valid only if it was created from exactly the same
+// source and the same sources of the modules it imports, also indirectly.
+// Cache files that can't be read or are stale are treated as misses.
+class module_cache
+{
+public:
+  explicit module_cache(std::string cache_dir);
+
+  std::optional<sema::serialized_sema_tree> load(
+    const source_view& source) const;
+
+  // Dependencies are paths of the imported modules.
+  void store(const source_view& source,
+             const std::vector<std::string>& dependencies,
+             const sema::serialized_sema_tree& tree) const;
+
+  // FNV-1a. Unlike std::hash, it's stable between runs.
+  static std::uint64_t hash(cmsl::string_view data);
+
+private:
+  std::string entry_path(cmsl::string_view module_path) const;
+
+private:
+  std::string m_cache_dir;
+};
+}
@@ -2,12 +2,27 @@
 
 #include "common/string.hpp"
 
+#include <memory>
+#include <unordered_map>
+
 namespace cmsl::exec {
+namespace inst {
+class instance;
+}
+
 class module_static_variables_initializer
 {
 public:
+  using variables_t =
+    std::unordered_map<unsigned, std::unique_ptr<inst::instance>>;
+
   virtual ~module_static_variables_initializer() = default;
 
   virtual void initialize(cmsl::string_view import_path) = 0;
+
+  // Takes variables of a module that is executed, e.g. the root one or one
+  // added with add_subdirectory(). They're stored together with variables
+  // of imported modules, so all of them are accessed the same way.
+  virtual void add_module_variables(variables_t variables) = 0;
 };
-}
\ No newline at end of file
+}
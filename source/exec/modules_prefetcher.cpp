@@ -0,0 +1,166 @@
+#include "exec/modules_prefetcher.hpp"
+
+#include <fstream>
+#include <iterator>
+
+namespace cmsl::exec {
+namespace {
+std::optional<std::string> string_literal_value(const lexer::token& token)
+{
+  if (token.get_type() != lexer::token_type::string) {
+    return std::nullopt;
+  }
+
+  // Remove "". Escaped paths are not worth prefetching.
+  const auto str = token.str();
+  const auto value = str.substr(1u, str.size() - 2u);
+  if (value.find('\\') != cmsl::string_view::npos) {
+    return std::nullopt;
+  }
+
+  return std::string{ value };
+}
+
+std::string directory_of(const std::string& path)
+{
+  const auto slash = path.rfind('/');
+  return slash == std::string::npos ? std::string{} : path.substr(0u, slash);
+}
+}
+
+modules_prefetcher::modules_prefetcher(strings_container& strings_container,
+                                       std::string imports_root_dir,
+                                       unsigned threads_count)
+  : m_strings_container{ strings_container }
+  , m_imports_root_dir{ std::move(imports_root_dir) }
+{
+  for (auto i = 0u; i < threads_count; ++i) {
+    m_threads.emplace_back([this] { work(); });
+  }
+}
+
+modules_prefetcher::~modules_prefetcher()
+{
+  {
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_stopping = true;
+  }
+  m_work_available.notify_all();
+
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+void modules_prefetcher::prefetch_referenced(
+  const lexer::token_container_t& tokens, const std::string& dir)
+{
+  for (auto i = 0u; i + 1u < tokens.size(); ++i) {
+    const auto& token = tokens[i];
+    const auto type = token.get_type();
+
+    if (type == lexer::token_type::kw_import) {
+      if (const auto path = string_literal_value(tokens[i + 1u])) {
+        schedule(m_imports_root_dir + '/' + *path);
+      }
+    } else if (type == lexer::token_type::identifier &&
+               token.str() == "add_subdirectory" && i + 2u < tokens.size() &&
+               tokens[i + 1u].get_type() == lexer::token_type::open_paren) {
+      if (const auto name = string_literal_value(tokens[i + 2u])) {
+        schedule(dir + '/' + *name + "/CMakeLists.cmsl");
+      }
+    }
+  }
+}
+
+std::unique_ptr<modules_prefetcher::prefetched_module>
+modules_prefetcher::find(const std::string& path)
+{
+  std::unique_lock<std::mutex> lock{ m_mutex };
+  const auto found = m_entries.find(path);
+  if (found == std::end(m_entries)) {
+    return nullptr;
+  }
+
+  auto& e = found->second;
+  m_entry_done.wait(lock, [&e] { return e.done; });
+  return std::move(e.module);
+}
+
+void modules_prefetcher::schedule(std::string path)
+{
+  {
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    if (m_entries.find(path) != std::end(m_entries)) {
+      return;
+    }
+
+    auto path_ptr = std::make_unique<std::string>(path);
+    auto& e = m_entries[std::move(path)];
+    e.path = std::move(path_ptr);
+    m_queue.push_back(&e);
+  }
+
+  m_work_available.notify_one();
+}
+
+void modules_prefetcher::work()
+{
+  while (true) {
+    entry* e{ nullptr };
+    {
+      std::unique_lock<std::mutex> lock{ m_mutex };
+      m_work_available.wait(lock,
+                            [this] { return m_stopping || !m_queue.empty(); });
+      if (m_stopping) {
+        return;
+      }
+
+      e = m_queue.front();
+      m_queue.pop_front();
+    }
+
+    prefetch(*e);
+
+    {
+      std::lock_guard<std::mutex> lock{ m_mutex };
+      e->done = true;
+    }
+    m_entry_done.notify_all();
+  }
+}
+
+void modules_prefetcher::prefetch(entry& e)
+{
+  auto content = load(*e.path);
+  if (!content) {
+    // Not an error. Maybe there is an old style script in the directory, or
+    // a script that is not going to be used at all.
+    return;
+  }
+
+  e.content = std::make_unique<std::string>(std::move(*content));
+  e.info = std::make_unique<source_info>(*e.path, *e.content);
+  e.module = std::make_unique<prefetched_module>(source_view{ *e.info });
+
+  source_parser parser{ e.module->deferred_errors, m_strings_container };
+  e.module->parsed = parser.parse(e.module->source);
+
+  // Referenced scripts are scheduled before this one is done. Thanks to that,
+  // when a script is found, scripts that it references are already known.
+  if (e.module->parsed) {
+    prefetch_referenced(e.module->parsed->tokens, directory_of(*e.path));
+  }
+}
+
+std::optional<std::string> modules_prefetcher::load(
+  const std::string& path) const
+{
+  std::ifstream file{ path };
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  return std::string(std::istreambuf_iterator<char>{ file }, {});
+}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "common/source_view.hpp"
+#include "errors/errors_observer.hpp"
+#include "exec/source_parser.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cmsl {
+class strings_container;
+
+namespace exec {
+
+// Finds scripts that are reachable from a root script through
+// add_subdirectory() calls and imports, and lexes and parses them on a pool of
+// threads. Only lexing and parsing are done ahead of time. Semantic analysis
+// and execution stay serial, so they take parsed scripts, in the order of
+// the root script, with find().
+//
+// Reachable scripts are found by scanning tokens for `add_subdirectory("...")`
+// and `import "...";`. It may find a script that is never compiled, e.g. one
+// added in a branch that is not taken. That's why errors of parsing are
+// deferred and reported only when a script is found.
+class modules_prefetcher
+{
+public:
+  struct prefetched_module
+  {
+    explicit prefetched_module(source_view s)
+      : source{ s }
+    {
+    }
+
+    source_view source;
+    // Empty if parsing failed.
+    std::optional<parsed_source> parsed;
+    errors::errors_observer deferred_errors{
+      errors::errors_observer::defer_errors
+    };
+  };
+
+  explicit modules_prefetcher(strings_container& strings_container,
+                              std::string imports_root_dir,
+                              unsigned threads_count);
+  ~modules_prefetcher();
+
+  // Schedules scripts referenced by tokens of a script from the given
+  // directory.
+  void prefetch_referenced(const lexer::token_container_t& tokens,
+                           const std::string& dir);
+
+  // Waits till the script at given path is parsed. Returns null if the script
+  // has not been scheduled, so it needs to be compiled the regular way. A
+  // script can be found only once.
+  std::unique_ptr<prefetched_module> find(const std::string& path);
+
+private:
+  struct entry
+  {
+    std::unique_ptr<std::string> path;
+    std::unique_ptr<std::string> content;
+    std::unique_ptr<source_info> info;
+    std::unique_ptr<prefetched_module> module;
+    bool done{ false };
+  };
+
+  void schedule(std::string path);
+  void work();
+  void prefetch(entry& e);
+  std::optional<std::string> load(const std::string& path) const;
+
+private:
+  strings_container& m_strings_container;
+  std::string m_imports_root_dir;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_entry_done;
+  std::deque<entry*> m_queue;
+  // Every scheduled path has an entry, so no path is scheduled twice.
+  std::unordered_map<std::string, entry> m_entries;
+  bool m_stopping{ false };
+
+  std::vector<std::thread> m_threads;
+};
+}
+}
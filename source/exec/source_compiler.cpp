@@ -1,9 +1,8 @@
 #include "exec/source_compiler.hpp"
 #include "ast/ast_node.hpp"
-#include "ast/parser.hpp"
 #include "common/source_view.hpp"
 #include "exec/compiled_source.hpp"
-#include "lexer/lexer.hpp"
+#include "exec/source_parser.hpp"
 #include "sema/builtin_sema_context.hpp"
 #include "sema/builtin_token_provider.hpp"
 #include "sema/enum_values_context.hpp"
@@ -13,6 +12,8 @@
 #include "sema/qualified_contextes_refs.hpp"
 #include "sema/sema_builder.hpp"
 #include "sema/sema_node.hpp"
+#include "sema/sema_tree_reader.hpp"
+#include "sema/sema_tree_writer.hpp"
 #include "sema/types_context.hpp"
 
 namespace cmsl::exec {
@@ -36,16 +37,27 @@ source_compiler::source_compiler(
 {
 }
 
-std::unique_ptr<compiled_source> source_compiler::compile(source_view source)
+std::unique_ptr<compiled_source> source_compiler::compile(
+  source_view source, std::optional<sema::serialized_sema_tree>* serialized)
 {
-  lexer::lexer lex{ m_errors_observer, source };
-  const auto tokens = lex.lex();
-  ast::parser parser{ m_errors_observer, m_strings_container, source, tokens };
-  auto ast_tree = parser.parse_translation_unit();
-  if (!ast_tree) {
+  source_parser parser{ m_errors_observer, m_strings_container };
+  auto parsed = parser.parse(source);
+  if (!parsed) {
     return nullptr;
   }
 
+  return compile(source, std::move(*parsed), serialized);
+}
+
+std::unique_ptr<compiled_source> source_compiler::compile(
+  source_view source, parsed_source parsed,
+  std::optional<sema::serialized_sema_tree>* serialized)
+{
+  auto& ast_tree = parsed.ast_tree;
+  // The sema tree gets its own arena, so that the AST arena can be freed
+  // together with the AST, when parsed source goes out of scope.
+  auto sema_arena = std::make_unique<nodes_arena>();
+  nodes_arena::scope arena_scope{ *sema_arena };
   const auto builtin_types = m_builtin_context.builtin_types();
 
   auto& global_context =
@@ -58,13 +70,57 @@ std::unique_ptr<compiled_source> source_compiler::compile(source_view source)
                                    m_imports_handler,
                                    m_builtin_tokens,
                                    builtin_types };
+  sema_builder.enable_constant_folding();
   auto sema_tree = sema_builder.build(*ast_tree);
   if (!sema_tree) {
     return nullptr;
   }
 
-  return std::make_unique<compiled_source>(std::move(ast_tree), global_context,
+  if (serialized != nullptr) {
+    sema::sema_tree_writer writer{ source, m_qualified_contextes };
+    *serialized = writer.write(*sema_tree);
+  }
+
+  compiled_source::memory_usage memory;
+  memory.released_bytes = parsed.arena->stats().bytes_allocated +
+    parsed.tokens.capacity() * sizeof(lexer::token);
+  memory.kept_bytes = sema_arena->stats().bytes_allocated;
+
+  return std::make_unique<compiled_source>(std::move(sema_arena),
+                                           global_context,
+                                           std::move(sema_tree), source,
+                                           builtin_types, memory);
+}
+
+std::unique_ptr<compiled_source> source_compiler::load(
+  source_view source, source_view names, cmsl::string_view nodes)
+{
+  auto sema_arena = std::make_unique<nodes_arena>();
+  nodes_arena::scope arena_scope{ *sema_arena };
+  const auto builtin_types = m_builtin_context.builtin_types();
+
+  auto& global_context =
+    m_factories_provider.context_factory().create("", &m_builtin_context);
+  sema::sema_tree_reader reader{ global_context,
+                                 m_qualified_contextes,
+                                 m_factories_provider,
+                                 m_add_subdirectory_handler,
+                                 m_imports_handler,
+                                 m_builtin_tokens,
+                                 builtin_types };
+  auto sema_tree = reader.read(source, names, nodes);
+  if (!sema_tree) {
+    return nullptr;
+  }
+
+  // Nothing was lexed nor parsed, so there is no memory to release.
+  compiled_source::memory_usage memory;
+  memory.released_bytes = 0u;
+  memory.kept_bytes = sema_arena->stats().bytes_allocated;
+
+  return std::make_unique<compiled_source>(std::move(sema_arena),
+                                           global_context,
                                            std::move(sema_tree), source,
-                                           builtin_types);
+                                           builtin_types, memory);
 }
 }
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "common/string.hpp"
 #include "sema/qualified_contextes_refs.hpp"
 
 #include <memory>
+#include <optional>
 
 namespace cmsl {
 class source_view;
@@ -19,10 +21,12 @@ class builtin_token_provider;
 class factories_provider;
 class import_handler;
 struct qualified_contextes_refs;
+struct serialized_sema_tree;
 }
 
 namespace exec {
 class compiled_source;
+struct parsed_source;
 
 class source_compiler
 {
@@ -37,7 +41,23 @@ public:
     sema::builtin_token_provider& builtin_tokens,
     strings_container& strings_container);
 
-  std::unique_ptr<compiled_source> compile(source_view source);
+  // If serialized is not null, it's set to the serialized sema tree of the
+  // compiled source. It's left empty if the tree can't be serialized.
+  std::unique_ptr<compiled_source> compile(
+    source_view source,
+    std::optional<sema::serialized_sema_tree>* serialized = nullptr);
+
+  // Compiles a source that has already been parsed.
+  std::unique_ptr<compiled_source> compile(
+    source_view source, parsed_source parsed,
+    std::optional<sema::serialized_sema_tree>* serialized = nullptr);
+
+  // Loads a source from its serialized sema tree, without lexing, parsing and
+  // analysing it. Names must outlive the loaded source, the same way the
+  // source does.
+  std::unique_ptr<compiled_source> load(source_view source,
+                                        source_view names,
+                                        cmsl::string_view nodes);
 
 private:
   errors::errors_observer& m_errors_observer;
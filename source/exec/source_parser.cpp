@@ -0,0 +1,31 @@
+#include "exec/source_parser.hpp"
+#include "ast/ast_node.hpp"
+#include "ast/parser.hpp"
+#include "lexer/lexer.hpp"
+
+namespace cmsl::exec {
+source_parser::source_parser(errors::errors_observer& errors_observer,
+                             strings_container& strings_container)
+  : m_errors_observer{ errors_observer }
+  , m_strings_container{ strings_container }
+{
+}
+
+std::optional<parsed_source> source_parser::parse(source_view source)
+{
+  parsed_source result;
+
+  lexer::lexer lex{ m_errors_observer, source };
+  result.tokens = lex.lex();
+
+  nodes_arena::scope arena_scope{ *result.arena };
+  ast::parser parser{ m_errors_observer, m_strings_container, source,
+                      result.tokens };
+  result.ast_tree = parser.parse_translation_unit();
+  if (!result.ast_tree) {
+    return std::nullopt;
+  }
+
+  return result;
+}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ast/ast_node.hpp"
+#include "common/nodes_arena.hpp"
+#include "common/source_view.hpp"
+#include "lexer/token.hpp"
+
+#include <memory>
+#include <optional>
+
+namespace cmsl {
+class strings_container;
+
+namespace errors {
+class errors_observer;
+}
+
+namespace exec {
+struct parsed_source
+{
+  lexer::token_container_t tokens;
+  // Owns memory of the AST nodes, so it's declared before the AST.
+  std::unique_ptr<nodes_arena> arena{ std::make_unique<nodes_arena>() };
+  std::unique_ptr<ast::ast_node> ast_tree;
+};
+
+// Lexes and parses a source. It doesn't
+// touch any semantic analysis state, so many sources can be parsed
+// concurrently, as long as each parser has its own errors observer.
+class source_parser
+{
+public:
+  explicit source_parser(errors::errors_observer& errors_observer,
+                         strings_container& strings_container);
+
+  std::optional<parsed_source> parse(source_view source);
+
+private:
+  errors::errors_observer& m_errors_observer;
+  strings_container& m_strings_container;
+};
+}
+}
@@ -36,6 +36,23 @@ public:
     return found == std::cend(m_instances) ? nullptr : found->second.get();
   }
 
+  // Static variables are initialized outside of any function, there are no
+  // local variables.
+  inst::instance* lookup_local_identifier(unsigned) override
+  {
+    return nullptr;
+  }
+
+  inst::instance* lookup_global_identifier(unsigned index) override
+  {
+    return lookup_identifier(index);
+  }
+
+  inst::instance* lookup_member_identifier(unsigned) override
+  {
+    return nullptr;
+  }
+
   inst::instance* get_class_instance() override { return nullptr; }
 
   void visit(const sema::variable_declaration_node& node) override
@@ -50,11 +67,7 @@ public:
       expression_evaluation_visitor visitor{ ctx };
       initialization->visit(visitor);
 
-      if (instances.owns(visitor.result)) {
-        created_instance = instances.gather_ownership(visitor.result);
-      } else {
-        created_instance = visitor.result->copy();
-      }
+      created_instance = instances.gather_ownership_or_copy(visitor.result);
     } else {
       auto variable_instance_ptr = instances.create(node.type());
       created_instance = instances.gather_ownership(variable_instance_ptr);
@@ -88,8 +101,7 @@ public:
     m_module_variables_initializer.initialize(node.pretty_file_path());
   }
 
-  std::unordered_map<unsigned, std::unique_ptr<inst::instance>>
-  gather_instances()
+  module_static_variables_initializer::variables_t gather_instances()
   {
     return std::move(m_instances);
   }
@@ -99,6 +111,6 @@ private:
   facade::cmake_facade& m_cmake_facade;
   const sema::builtin_types_accessor& m_builtin_types;
   module_static_variables_initializer& m_module_variables_initializer;
-  std::unordered_map<unsigned, std::unique_ptr<inst::instance>> m_instances;
+  module_static_variables_initializer::variables_t m_instances;
 };
 }
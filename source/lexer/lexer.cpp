@@ -3,23 +3,218 @@
 #include "errors/error.hpp"
 #include "errors/errors_observer.hpp"
 
+#include <array>
 #include <cassert>
-#include <cctype>
 
 namespace cmsl::lexer {
+namespace {
+// Class of a character that a token starts with.
+enum class char_class : unsigned char
+{
+  other,
+  whitespace,
+  digit,
+  identifier,
+  dot,
+  colon,
+  equal,
+  quote,
+  one_char_token,
+  arithmetical
+};
+
+struct char_info
+{
+  char_class cls{ char_class::other };
+
+  // Token types of one char and arithmetical tokens. E.g. for '+': single is
+  // +, op_equal is += and twice is ++.
+  token_type single{ token_type::undef };
+  token_type op_equal{ token_type::undef };
+  token_type twice{ token_type::undef };
+
+  bool has_twice() const { return twice != token_type::undef; }
+};
+
+using char_table_t = std::array<char_info, 256u>;
+
+constexpr void add_one_char_token(char_table_t& table, char c, token_type type)
+{
+  table[static_cast<unsigned char>(c)] =
+    char_info{ char_class::one_char_token, type };
+}
+
+constexpr void add_arithmetical_token(
+  char_table_t& table, char c, token_type single, token_type op_equal,
+  token_type twice = token_type::undef)
+{
+  table[static_cast<unsigned char>(c)] =
+    char_info{ char_class::arithmetical, single, op_equal, twice };
+}
+
+constexpr char_table_t create_char_table()
+{
+  char_table_t table{};
+
+  for (auto c : { ' ', '\t', '\n', '\r' }) {
+    table[static_cast<unsigned char>(c)].cls = char_class::whitespace;
+  }
+  for (auto c = '0'; c <= '9'; ++c) {
+    table[static_cast<unsigned char>(c)].cls = char_class::digit;
+  }
+  for (auto c = 'a'; c <= 'z'; ++c) {
+    table[static_cast<unsigned char>(c)].cls = char_class::identifier;
+  }
+  for (auto c = 'A'; c <= 'Z'; ++c) {
+    table[static_cast<unsigned char>(c)].cls = char_class::identifier;
+  }
+  table[static_cast<unsigned char>('_')].cls = char_class::identifier;
+  table[static_cast<unsigned char>('.')].cls = char_class::dot;
+  table[static_cast<unsigned char>(':')].cls = char_class::colon;
+  table[static_cast<unsigned char>('=')].cls = char_class::equal;
+  table[static_cast<unsigned char>('"')].cls = char_class::quote;
+
+  add_one_char_token(table, '(', token_type::open_paren);
+  add_one_char_token(table, ')', token_type::close_paren);
+  add_one_char_token(table, '{', token_type::open_brace);
+  add_one_char_token(table, '}', token_type::close_brace);
+  add_one_char_token(table, '[', token_type::open_square);
+  add_one_char_token(table, ']', token_type::close_square);
+  add_one_char_token(table, ';', token_type::semicolon);
+  add_one_char_token(table, '?', token_type::question);
+  add_one_char_token(table, ',', token_type::comma);
+
+  add_arithmetical_token(table, '-', token_type::minus, token_type::minusequal,
+                         token_type::minusminus);
+  add_arithmetical_token(table, '+', token_type::plus, token_type::plusequal,
+                         token_type::plusplus);
+  add_arithmetical_token(table, '&', token_type::amp, token_type::ampequal,
+                         token_type::ampamp);
+  add_arithmetical_token(table, '|', token_type::pipe, token_type::pipeequal,
+                         token_type::pipepipe);
+  add_arithmetical_token(table, '/', token_type::slash,
+                         token_type::slashequal);
+  add_arithmetical_token(table, '*', token_type::star, token_type::starequal);
+  add_arithmetical_token(table, '%', token_type::percent,
+                         token_type::percentequal);
+  add_arithmetical_token(table, '!', token_type::exclaim,
+                         token_type::exclaimequal);
+  add_arithmetical_token(table, '^', token_type::xor_, token_type::xorequal);
+  add_arithmetical_token(table, '<', token_type::less, token_type::lessequal);
+  add_arithmetical_token(table, '>', token_type::greater,
+                         token_type::greaterequal);
+
+  return table;
+}
+
+constexpr auto k_char_table = create_char_table();
+
+const char_info& info_of(char c)
+{
+  return k_char_table[static_cast<unsigned char>(c)];
+}
+
+bool is_identifier_char(char c)
+{
+  // At this point we know that identifier won't start with a digit.
+  const auto cls = info_of(c).cls;
+  return cls == char_class::identifier || cls == char_class::digit;
+}
+
+struct keyword
+{
+  cmsl::string_view name;
+  token_type type{ token_type::undef };
+};
+
+constexpr keyword k_keywords[] = {
+  { "void", token_type::kw_void },
+  { "int", token_type::kw_int },
+  { "double", token_type::kw_double },
+  { "bool", token_type::kw_bool },
+  { "true", token_type::kw_true },
+  { "false", token_type::kw_false },
+  { "string", token_type::kw_string },
+  { "version", token_type::kw_version },
+  { "list", token_type::kw_list },
+  { "extern", token_type::kw_extern },
+  { "library", token_type::kw_library },
+  { "executable", token_type::kw_executable },
+  { "project", token_type::kw_project },
+  { "option", token_type::kw_option },
+  { "return", token_type::kw_return },
+  { "class", token_type::kw_class },
+  { "enum", token_type::kw_enum },
+  { "if", token_type::kw_if },
+  { "else", token_type::kw_else },
+  { "while", token_type::kw_while },
+  { "auto", token_type::kw_auto },
+  { "for", token_type::kw_for },
+  { "break", token_type::kw_break },
+  { "namespace", token_type::kw_namespace },
+  { "import", token_type::kw_import },
+  { "export", token_type::kw_export },
+};
+
+constexpr auto k_keywords_table_size = 64u;
+using keywords_table_t = std::array<keyword, k_keywords_table_size>;
+
+// Multipliers are picked so that no two keywords have the same hash. It's
+// checked at compile time below, so a new keyword that collides fails the
+// build and needs new multipliers.
+constexpr unsigned keyword_hash(cmsl::string_view name)
+{
+  const auto first = static_cast<unsigned char>(name.front());
+  const auto last = static_cast<unsigned char>(name.back());
+  return (name.size() * 10u + first + last * 19u) % k_keywords_table_size;
+}
+
+constexpr keywords_table_t create_keywords_table()
+{
+  keywords_table_t table{};
+  for (const auto& kw : k_keywords) {
+    table[keyword_hash(kw.name)] = kw;
+  }
+  return table;
+}
+
+constexpr auto k_keywords_table = create_keywords_table();
+
+constexpr bool is_keyword_hash_perfect()
+{
+  for (const auto& kw : k_keywords) {
+    if (k_keywords_table[keyword_hash(kw.name)].name != kw.name) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(is_keyword_hash_perfect(), "Keywords hashes collide");
+
+// Scripts in this repository have about five chars per token, including
+// whitespaces and comments. Slightly underestimated, so that tokens vector
+// rarely needs to grow.
+constexpr auto k_chars_per_token_estimate = 4u;
+
+token_type keyword_or_identifier(cmsl::string_view value)
+{
+  const auto& kw = k_keywords_table[keyword_hash(value)];
+  return kw.name == value ? kw.type : token_type::identifier;
+}
+}
+
 lexer::lexer(errors::errors_observer& err_observer, source_t source)
   : m_err_observer{ err_observer }
   , m_source{ source }
   , m_source_loc{ m_source.source() }
-  , m_aritmetical_token_definitions{ create_arithmetical_token_definitions() }
-  , m_one_char_tokens{ create_one_char_tokens() }
-  , m_keyword_tokens{ create_keyword_tokens() }
 {
 }
 
 std::vector<token> lexer::lex()
 {
   auto tokens = std::vector<token>{};
+  tokens.reserve(m_source.source().size() / k_chars_per_token_estimate);
 
   while (!is_end()) {
     const auto t = get_next_token();
@@ -55,10 +250,59 @@ char lexer::next() const
 token lexer::get_next_token()
 {
   consume_whitespaces();
-  const auto begin_loc = m_source_loc.location();
+  const auto begin = m_source_loc.location().absolute;
   const auto token_type = get_next_token_type();
-  const auto end_loc = m_source_loc.location();
-  return token{ token_type, source_range{ begin_loc, end_loc }, m_source };
+  const auto end = m_source_loc.location().absolute;
+  if (end - begin > token::k_max_length) {
+    const auto range =
+      source_range{ m_source.location(begin), m_source_loc.location() };
+    notify_error(range, "Token is too long, tokens can have at most 16 MiB");
+    return token::undef();
+  }
+
+  if (token_type == token_type::identifier) {
+    const auto spelling = m_source.source().substr(begin, end - begin);
+    const auto symbol = intern(spelling);
+    if (!symbol) {
+      const auto range =
+        source_range{ m_source.location(begin), m_source_loc.location() };
+      notify_error(range, "Too many different identifiers");
+      return token::undef();
+    }
+
+    return token::identifier(m_source, begin, *symbol);
+  }
+
+  return token{ token_type, m_source, begin, end - begin };
+}
+
+std::optional<symbol_t> lexer::intern(cmsl::string_view spelling)
+{
+  if (const auto found = m_symbols.find(spelling); found != m_symbols.end()) {
+    return found->second;
+  }
+
+  const auto symbol = symbol_table::instance().try_intern(spelling);
+  if (symbol) {
+    m_symbols.emplace(spelling, *symbol);
+  }
+
+  return symbol;
+}
+
+void lexer::notify_error(const source_range& range, std::string message)
+{
+  errors::error err;
+  err.type = errors::error_type::error;
+  err.source_path = m_source.path();
+  err.range = range;
+  err.message = std::move(message);
+
+  const auto line_info = m_source.line(range.begin.line);
+  err.line_snippet = line_info.line;
+  err.line_start_pos = line_info.start_pos;
+
+  m_err_observer.notify_error(std::move(err));
 }
 
 token_type lexer::get_next_token_type()
@@ -70,46 +314,44 @@ token_type lexer::get_next_token_type()
 
   const auto curr = current();
 
-  if (std::isdigit(curr)) {
-    return get_numeric_token_type();
-  }
-  if (curr == '.') {
-    if (has_next() && std::isdigit(next())) // .123
-    {
+  switch (info_of(curr).cls) {
+    case char_class::digit:
       return get_numeric_token_type();
-    } else {
+    case char_class::dot: {
+      if (has_next() && info_of(next()).cls == char_class::digit) // .123
+      {
+        return get_numeric_token_type();
+      }
+
       consume_char();
       return token_type::dot;
     }
-  }
-  if (curr == ':') {
-    if (next() == ':') {
-      return get_scope_operator();
+    case char_class::colon: {
+      if (has_next() && next() == ':') {
+        return get_scope_operator();
+      }
+
+      consume_char();
+      return token_type::colon;
     }
+    case char_class::equal:
+      return get_equal_token_type();
+    case char_class::quote:
+      return get_string_token_type();
+    case char_class::one_char_token:
+      return get_one_char_token_type(curr);
+    case char_class::arithmetical: {
+      if (comment_starts()) {
+        return get_comment();
+      }
 
-    consume_char();
-    return token_type::colon;
-  }
-  if (comment_starts()) {
-    return get_comment();
-  }
-  if (curr == '=') {
-    return get_equal_token_type();
-  }
-  if (curr == '"') {
-    return get_string_token_type();
-  }
-  if (is_one_char_token(curr)) {
-    return get_one_char_token_type(curr);
-  }
-  if (is_arithmetical_operator(curr)) {
-    return get_arithmetical_token_type(curr);
-  }
-  if (std::isalpha(curr) || curr == '_') {
-    return get_identifier_or_keyword_token_type();
+      return get_arithmetical_token_type(curr);
+    }
+    case char_class::identifier:
+      return get_identifier_or_keyword_token_type();
+    default:
+      return token_type::undef;
   }
-
-  return token_type::undef;
 }
 
 token_type lexer::get_numeric_token_type()
@@ -134,7 +376,7 @@ token_type lexer::get_numeric_token_type()
 
 void lexer::consume_integer()
 {
-  while (!is_end() && std::isdigit(current())) {
+  while (!is_end() && info_of(current()).cls == char_class::digit) {
     consume_char();
   }
 }
@@ -148,34 +390,20 @@ void lexer::consume_char()
 void lexer::consume_whitespaces()
 {
   assert(!is_end());
-  while (!is_end() && is_whitespace(current())) {
+  while (!is_end() && info_of(current()).cls == char_class::whitespace) {
     consume_char();
   }
 }
 
 token_type lexer::get_identifier_or_keyword_token_type()
 {
-  std::string token_val;
+  const auto begin = m_source_loc.location().absolute;
   while (!is_end() && is_identifier_char(current())) {
-    token_val += current();
     consume_char();
   }
 
-  auto found = m_keyword_tokens.find(token_val);
-
-  if (found != m_keyword_tokens.end()) {
-    return found->second;
-  }
-
-  return found != m_keyword_tokens.end() ? found->second
-                                         : token_type::identifier;
-}
-
-bool lexer::is_identifier_char(char c) const
-{
-  // At this point we know that identifier won't start with a digit, so we can
-  // use isalnum()
-  return std::isalnum(c) || c == '_';
+  const auto end = m_source_loc.location().absolute;
+  return keyword_or_identifier(m_source.source().substr(begin, end - begin));
 }
 
 token_type lexer::get_equal_token_type()
@@ -213,18 +441,8 @@ token_type lexer::get_string_token_type()
 
   if (is_end()) {
     const auto current_loc = m_source_loc.location();
-
-    errors::error err;
-    err.type = errors::error_type::error;
-    err.source_path = m_source.path();
-    err.range = source_range{ current_loc, current_loc };
-    err.message = "Unexpected end of source in a middle of string";
-
-    const auto line_info = m_source.line(current_loc.line);
-    err.line_snippet = line_info.line;
-    err.line_start_pos = line_info.start_pos;
-
-    m_err_observer.notify_error(std::move(err));
+    notify_error(source_range{ current_loc, current_loc },
+                 "Unexpected end of source in a middle of string");
     return token_type::undef;
   }
 
@@ -239,10 +457,8 @@ token_type lexer::get_arithmetical_token_type(char operator_char)
   // current() == operator_char, go to next char
   consume_char();
 
-  const auto found = m_aritmetical_token_definitions.find(operator_char);
-  assert(found != m_aritmetical_token_definitions.end());
-
-  const auto& definition = found->second;
+  const auto& definition = info_of(operator_char);
+  assert(definition.cls == char_class::arithmetical);
 
   if (is_end()) {
     return definition.single;
@@ -263,66 +479,6 @@ token_type lexer::get_arithmetical_token_type(char operator_char)
   return definition.single;
 }
 
-lexer::aritmetical_token_definition_t
-lexer::create_arithmetical_token_definitions() const
-{
-  using def_t = arithmetical_token_definition;
-
-  aritmetical_token_definition_t definitions;
-
-  definitions['-'] =
-    def_t{ token_type::minus, token_type::minusequal, token_type::minusminus };
-  definitions['+'] =
-    def_t{ token_type::plus, token_type::plusequal, token_type::plusplus };
-  definitions['&'] =
-    def_t{ token_type::amp, token_type::ampequal, token_type::ampamp };
-  definitions['|'] =
-    def_t{ token_type::pipe, token_type::pipeequal, token_type::pipepipe };
-  definitions['/'] = def_t{ token_type::slash, token_type::slashequal };
-  definitions['*'] = def_t{ token_type::star, token_type::starequal };
-  definitions['%'] = def_t{ token_type::percent, token_type::percentequal };
-  definitions['!'] = def_t{ token_type::exclaim, token_type::exclaimequal };
-  definitions['^'] = def_t{ token_type::xor_, token_type::xorequal };
-  definitions['<'] = def_t{ token_type::less, token_type::lessequal };
-  definitions['>'] = def_t{ token_type::greater, token_type::greaterequal };
-
-  return definitions;
-}
-
-lexer::one_char_tokens_t lexer::create_one_char_tokens() const
-{
-  one_char_tokens_t tokens;
-
-  tokens['('] = token_type::open_paren;
-  tokens[')'] = token_type::close_paren;
-  tokens['{'] = token_type::open_brace;
-  tokens['}'] = token_type::close_brace;
-  tokens['['] = token_type::open_square;
-  tokens[']'] = token_type::close_square;
-  tokens[';'] = token_type::semicolon;
-  tokens['?'] = token_type::question;
-  tokens[','] = token_type::comma;
-
-  return tokens;
-}
-
-bool lexer::is_arithmetical_operator(char c) const
-{
-  const auto arith_operators = cmsl::string_view{ "-+&|/*%!^<>" };
-  return arith_operators.find(c) != cmsl::string_view::npos;
-}
-
-bool lexer::is_one_char_token(char c) const
-{
-  return contains(m_one_char_tokens, c);
-}
-
-bool lexer::is_whitespace(char c) const
-{
-  const auto chars = cmsl::string_view{ " \t\n\r" };
-  return chars.find(c) != cmsl::string_view::npos;
-}
-
 bool lexer::comment_starts() const
 {
   if (!has_next()) {
@@ -335,47 +491,12 @@ bool lexer::comment_starts() const
 
 token_type lexer::get_one_char_token_type(char c)
 {
-  const auto found = m_one_char_tokens.find(c);
-  assert(found != m_one_char_tokens.end());
+  const auto& info = info_of(c);
+  assert(info.cls == char_class::one_char_token);
 
   consume_char();
 
-  const auto token_type = found->second;
-  return token_type;
-}
-
-lexer::keyword_tokens_t lexer::create_keyword_tokens() const
-{
-  keyword_tokens_t tokens;
-
-  tokens["void"] = token_type::kw_void;
-  tokens["int"] = token_type::kw_int;
-  tokens["double"] = token_type::kw_double;
-  tokens["bool"] = token_type::kw_bool;
-  tokens["true"] = token_type::kw_true;
-  tokens["false"] = token_type::kw_false;
-  tokens["string"] = token_type::kw_string;
-  tokens["version"] = token_type::kw_version;
-  tokens["list"] = token_type::kw_list;
-  tokens["extern"] = token_type::kw_extern;
-  tokens["library"] = token_type::kw_library;
-  tokens["executable"] = token_type::kw_executable;
-  tokens["project"] = token_type::kw_project;
-  tokens["option"] = token_type::kw_option;
-  tokens["return"] = token_type::kw_return;
-  tokens["class"] = token_type::kw_class;
-  tokens["enum"] = token_type::kw_enum;
-  tokens["if"] = token_type::kw_if;
-  tokens["else"] = token_type::kw_else;
-  tokens["while"] = token_type::kw_while;
-  tokens["auto"] = token_type::kw_auto;
-  tokens["for"] = token_type::kw_for;
-  tokens["break"] = token_type::kw_break;
-  tokens["namespace"] = token_type::kw_namespace;
-  tokens["import"] = token_type::kw_import;
-  tokens["export"] = token_type::kw_export;
-
-  return tokens;
+  return info.single;
 }
 
 token_type lexer::get_scope_operator()
@@ -411,18 +532,9 @@ token_type lexer::get_comment()
     } else {
       if (is_end()) {
         const auto current_loc = m_source_loc.location();
-        errors::error err;
-        err.type = errors::error_type::error;
-        err.source_path = m_source.path();
-        err.range = source_range{ current_loc, current_loc };
-        err.message =
-          "Unexpected end of source in a middle of a multiline comment";
-
-        const auto line_info = m_source.line(current_loc.line);
-        err.line_snippet = line_info.line;
-        err.line_start_pos = line_info.start_pos;
-
-        m_err_observer.notify_error(std::move(err));
+        notify_error(
+          source_range{ current_loc, current_loc },
+          "Unexpected end of source in a middle of a multiline comment");
         return token_type::undef;
       }
 
@@ -5,8 +5,8 @@
 #include "lexer/source_location_manipulator.hpp"
 #include "token.hpp"
 
+#include <optional>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace cmsl {
@@ -27,26 +27,9 @@ public:
   std::vector<token> lex();
 
 private:
-  struct arithmetical_token_definition
-  {
-    token_type single;
-    token_type op_equal;
-    token_type twice{ token_type::undef };
-
-    bool has_twice() const { return twice != token_type::undef; }
-  };
-
-  using aritmetical_token_definition_t =
-    std::unordered_map<char, arithmetical_token_definition>;
-  aritmetical_token_definition_t create_arithmetical_token_definitions() const;
-
-  using one_char_tokens_t = std::unordered_map<char, token_type>;
-  one_char_tokens_t create_one_char_tokens() const;
-
-  using keyword_tokens_t = string_view_map<token_type>;
-  keyword_tokens_t create_keyword_tokens() const;
-
   token get_next_token();
+  std::optional<symbol_t> intern(cmsl::string_view spelling);
+  void notify_error(const source_range& range, std::string message);
   token_type get_next_token_type();
   token_type get_numeric_token_type();
   token_type get_identifier_or_keyword_token_type();
@@ -64,10 +47,6 @@ private:
   bool is_end() const;
   bool has_next() const;
 
-  bool is_identifier_char(char c) const;
-  bool is_arithmetical_operator(char c) const;
-  bool is_one_char_token(char c) const;
-  bool is_whitespace(char c) const;
   bool comment_starts() const;
 
   char current() const;
@@ -77,9 +56,9 @@ private:
   errors::errors_observer& m_err_observer;
   const source_t m_source;
   source_location_manipulator m_source_loc;
-  const aritmetical_token_definition_t m_aritmetical_token_definitions;
-  const one_char_tokens_t m_one_char_tokens;
-  const keyword_tokens_t m_keyword_tokens;
+  // Atoms of identifiers found so far, so that the global symbol table is
+  // locked once per distinct spelling.
+  cmsl::string_view_map<symbol_t> m_symbols;
 };
 }
 }
@@ -0,0 +1,71 @@
+#include "lexer/symbol_table.hpp"
+
+#include "common/assert.hpp"
+
+#include <mutex>
+
+namespace cmsl::lexer {
+symbol_table& symbol_table::instance()
+{
+  static symbol_table table;
+  return table;
+}
+
+symbol_table::symbol_table()
+{
+  [[maybe_unused]] const auto empty = intern("");
+  CMSL_ASSERT(empty == k_empty_symbol);
+}
+
+std::optional<symbol_t> symbol_table::try_intern(cmsl::string_view spelling)
+{
+  return intern_below(spelling, k_max_symbols - k_reserved_symbols);
+}
+
+symbol_t symbol_table::intern(cmsl::string_view spelling)
+{
+  const auto symbol = intern_below(spelling, k_max_symbols);
+  // Names from outside of sources are a fixed set, far smaller than the
+  // reserved atoms.
+  CMSL_ASSERT_MSG(symbol.has_value(), "Too many identifiers");
+  return symbol.value_or(k_empty_symbol);
+}
+
+std::optional<symbol_t> symbol_table::intern_below(
+  cmsl::string_view spelling, symbol_t max_symbols)
+{
+  {
+    std::shared_lock<std::shared_mutex> lock{ m_mutex };
+    if (const auto found = m_symbols.find(spelling);
+        found != m_symbols.end()) {
+      return found->second;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock{ m_mutex };
+  // Could have been interned by another thread in the meantime.
+  if (const auto found = m_symbols.find(spelling); found != m_symbols.end()) {
+    return found->second;
+  }
+
+  const auto symbol = static_cast<symbol_t>(m_symbols.size());
+  if (symbol >= max_symbols) {
+    return std::nullopt;
+  }
+
+  auto& chunk = m_chunks[symbol >> k_chunk_bits];
+  if (!chunk) {
+    chunk = std::make_unique<chunk_t>();
+  }
+  auto& stored = (*chunk)[symbol & (k_chunk_size - 1u)];
+  stored = spelling;
+  m_symbols.emplace(stored, symbol);
+
+  return symbol;
+}
+
+cmsl::string_view symbol_table::spelling(symbol_t symbol) const
+{
+  return (*m_chunks[symbol >> k_chunk_bits])[symbol & (k_chunk_size - 1u)];
+}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "common/string.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+
+namespace cmsl::lexer {
+// Atom of an interned identifier spelling. Identifiers with the same spelling
+// have the same atom, no matter in which source they are, so they can be
+// hashed and compared as integers.
+using symbol_t = std::uint32_t;
+
+// Global table of identifier spellings. Atoms of type names are also the
+// parts their canonical ids are made of. Sources are lexed by multiple
+// threads, so interning is synchronized. Spellings are never removed and are
+// kept in chunks that never move, so a spelling of an atom can be read without
+// locking. Lexers keep their own caches of atoms, so the table is locked once
+// per distinct spelling in a source, not per identifier token.
+class symbol_table
+{
+public:
+  // Atoms have to fit in 24 bits of a token.
+  static constexpr auto k_max_symbols = symbol_t{ 1u << 24u };
+  // The last atoms are kept for names that don't come from sources, e.g.
+  // builtin ones, so that sources can't exhaust them.
+  static constexpr auto k_reserved_symbols = symbol_t{ 1u << 16u };
+  static constexpr auto k_empty_symbol = symbol_t{ 0u };
+
+  static symbol_table& instance();
+
+  // Interns an identifier from a source. Returns nullopt if there is no room
+  // for a new atom, which the lexer reports as an error.
+  std::optional<symbol_t> try_intern(cmsl::string_view spelling);
+
+  // Interns a name that doesn't come from a source. It can use the reserved
+  // atoms.
+  symbol_t intern(cmsl::string_view spelling);
+  cmsl::string_view spelling(symbol_t symbol) const;
+
+private:
+  symbol_table();
+
+  // Interns a spelling if its atom would be lower than max_symbols.
+  std::optional<symbol_t> intern_below(cmsl::string_view spelling,
+                                       symbol_t max_symbols);
+
+  static constexpr auto k_chunk_bits = 12u;
+  static constexpr auto k_chunk_size = symbol_t{ 1u << k_chunk_bits };
+  static constexpr auto k_chunks_count = k_max_symbols / k_chunk_size;
+
+  using chunk_t = std::array<std::string, k_chunk_size>;
+
+  std::shared_mutex m_mutex;
+  // Keys view spellings stored in the chunks.
+  cmsl::string_view_map<symbol_t> m_symbols;
+  std::array<std::unique_ptr<chunk_t>, k_chunks_count> m_chunks;
+};
+}
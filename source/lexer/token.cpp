@@ -1,26 +1,52 @@
 #include "token.hpp"
 
+#include "common/assert.hpp"
+
 #include <ostream>
 
 namespace cmsl::lexer {
+namespace {
+static_assert(static_cast<unsigned>(token_type::_keywords_end) < 256u,
+              "Token type doesn't fit in token::m_type");
+
+cmsl::source_view empty_source()
+{
+  static const auto source = cmsl::source_view{ "" };
+  return source;
+}
+}
+
 token::token()
   : token{ token_type_t::undef }
 {
 }
 
 token::token(token_type_t type)
-  : token{ type, source_range{}, cmsl::source_view{ "" } }
+  : token{ type, empty_source(), 0u, 0u }
 {
 }
 
 token::token(token_type_t type, const source_range& src_range,
              cmsl::source_view source)
-  : m_type{ type }
-  , m_source_range{ src_range }
-  , m_source{ source }
+  : token{ type, source, src_range.begin.absolute, src_range.size() }
 {
 }
 
+token::token(token_type_t type, cmsl::source_view source, unsigned offset,
+             unsigned length)
+  : m_source{ source }
+  , m_offset{ offset }
+  , m_length_or_symbol{ length }
+  , m_type{ static_cast<std::uint32_t>(type) }
+{
+  CMSL_ASSERT_MSG(length <= k_max_length, "Token is too long");
+  if (is_identifier()) {
+    const auto spelling =
+      cmsl::string_view{ std::next(m_source.cdata(), m_offset), length };
+    m_length_or_symbol = symbol_table::instance().intern(spelling);
+  }
+}
+
 bool token::is_valid() const
 {
   return get_type() != token_type_t::undef;
@@ -28,7 +54,7 @@ bool token::is_valid() const
 
 token::token_type_t token::get_type() const
 {
-  return m_type;
+  return static_cast<token_type_t>(m_type);
 }
 
 token token::undef()
@@ -36,16 +62,56 @@ token token::undef()
   return token{ token_type_t::undef };
 }
 
+token token::identifier(cmsl::source_view source, unsigned offset,
+                        symbol_t symbol)
+{
+  auto t = token{ token_type_t::undef, source, offset, 0u };
+  t.m_type = static_cast<std::uint32_t>(token_type_t::identifier);
+  t.m_length_or_symbol = symbol;
+  return t;
+}
+
 cmsl::string_view token::str() const
 {
-  return cmsl::string_view{ std::next(m_source.cdata(),
-                                      m_source_range.begin.absolute),
-                            m_source_range.size() };
+  return cmsl::string_view{ std::next(m_source.cdata(), m_offset),
+                            length() };
+}
+
+symbol_t token::symbol() const
+{
+  CMSL_ASSERT(is_identifier());
+  return m_length_or_symbol;
+}
+
+std::size_t token::hash() const
+{
+  if (is_identifier()) {
+    return std::hash<symbol_t>{}(symbol());
+  }
+
+  return std::hash<cmsl::string_view>{}(str());
+}
+
+bool token::is_identifier() const
+{
+  return get_type() == token_type_t::identifier;
+}
+
+unsigned token::length() const
+{
+  // Spelling of an identifier is the same as its text in the source.
+  return is_identifier()
+    ? symbol_table::instance().spelling(symbol()).size()
+    : m_length_or_symbol;
 }
 
 bool token::operator==(const token& rhs) const
 {
-  return get_type() == rhs.get_type() && str() == rhs.str();
+  if (get_type() != rhs.get_type()) {
+    return false;
+  }
+
+  return is_identifier() ? symbol() == rhs.symbol() : str() == rhs.str();
 }
 
 bool token::operator!=(const token& rhs) const
@@ -61,7 +127,8 @@ std::ostream& operator<<(std::ostream& out, const token& t)
 
 source_range token::src_range() const
 {
-  return m_source_range;
+  return source_range{ m_source.location(m_offset),
+                       m_source.location(m_offset + length()) };
 }
 
 cmsl::source_view token::source() const
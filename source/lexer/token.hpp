@@ -3,21 +3,34 @@
 #include "common/source_location.hpp"
 #include "common/source_view.hpp"
 #include "common/string.hpp"
+#include "symbol_table.hpp"
 #include "token_type.hpp"
 
+#include <cstdint>
 #include <vector>
 
 namespace cmsl::lexer {
+// Token is kept small, 16 bytes, because scripts are lexed into millions of
+// them. It stores only an offset and a length in its source. Line and column
+// are computed from the line table of the source view when they're needed.
+// Length has 24 bits, so a single token can't be longer than 16 MiB. The
+// lexer reports longer ones as errors.
+// Identifiers store an atom from the symbol table instead of the length, so
+// they are hashed and compared as integers, e.g. by lookups in sema.
 class token
 {
 public:
   using token_type_t = cmsl::lexer::token_type;
 
+  static constexpr auto k_max_length = (1u << 24u) - 1u;
+
   // Creates token with invalid begin and end locations
   explicit token();
   explicit token(token_type_t type);
   explicit token(token_type_t type, const source_range& src_range,
                  cmsl::source_view source);
+  explicit token(token_type_t type, cmsl::source_view source,
+                 unsigned offset, unsigned length);
 
   token(const token&) = default;
   token& operator=(const token&) = default;
@@ -28,9 +41,17 @@ public:
   token_type_t get_type() const;
 
   static token undef();
+  // Identifier with an atom already interned, e.g. by the lexer.
+  static token identifier(cmsl::source_view source, unsigned offset,
+                          symbol_t symbol);
 
   cmsl::string_view str() const;
 
+  // Valid only for identifiers.
+  symbol_t symbol() const;
+
+  std::size_t hash() const;
+
   source_range src_range() const;
   cmsl::source_view source() const;
 
@@ -40,20 +61,26 @@ public:
   friend std::ostream& operator<<(std::ostream& out, const token& t);
 
 private:
-  token_type_t m_type;
-  source_range m_source_range;
+  bool is_identifier() const;
+  unsigned length() const;
+
+private:
   cmsl::source_view m_source;
+  std::uint32_t m_offset;
+  // Symbol of an identifier, length of other tokens.
+  std::uint32_t m_length_or_symbol : 24;
+  std::uint32_t m_type : 8;
 };
 
+static_assert(sizeof(token) == 16u || sizeof(void*) != 8u);
+
 using token_container_t = std::vector<token>;
 
 template <unsigned N>
 token make_token(lexer::token_type token_type, const char (&tok)[N])
 {
   // N counts also '\0'
-  const auto src_range = source_range{ source_location{ 1u, 1u, 0u },
-                                       source_location{ 1u, N, N - 1u } };
-  return token{ token_type, src_range, cmsl::source_view{ tok } };
+  return token{ token_type, cmsl::source_view{ tok }, 0u, N - 1u };
 }
 }
 
@@ -63,7 +90,7 @@ struct hash<cmsl::lexer::token>
 {
   std::size_t operator()(const cmsl::lexer::token& token) const
   {
-    return std::hash<std::string_view>{}(token.str());
+    return token.hash();
   }
 };
 }
@@ -211,7 +211,9 @@ void builtin_cmake_namespace_context::add_identifiers()
 
   for (const auto& identifier : identifiers) {
     const auto identifier_index = identifiers_index_provider::get_next();
-    const auto id_info = identifier_info{ identifier.type, identifier_index };
+    const auto id_info = identifier_info{ identifier.type, identifier_index,
+                                          std::nullopt,
+                                          identifier_storage::builtin };
     const auto builtin_id_info =
       builtin_identifier_info{ id_info, identifier.cmake_variable_name };
 
@@ -285,7 +287,7 @@ void builtin_cmake_namespace_context::add_types()
 
 const sema_type& builtin_cmake_namespace_context::add_cxx_compiler_id_type()
 {
-  static const auto token = m_builtin_tokens.cmake().cxx_compiler_id_name();
+  const auto token = m_builtin_tokens.cmake().cxx_compiler_id_name();
   const std::vector<lexer::token> enumerators{
     m_builtin_tokens.cmake().cxx_compiler_id_clang()
   };
@@ -295,7 +297,7 @@ const sema_type& builtin_cmake_namespace_context::add_cxx_compiler_id_type()
 
 const sema_type& builtin_cmake_namespace_context::add_cxx_standard_value_type()
 {
-  static const auto token = m_builtin_tokens.cmake().cxx_standard_value_name();
+  const auto token = m_builtin_tokens.cmake().cxx_standard_value_name();
   const std::vector<lexer::token> enumerators{
     m_builtin_tokens.cmake().cxx_standard_value_cpp_11(),
     m_builtin_tokens.cmake().cxx_standard_value_cpp_14(),
@@ -308,7 +310,7 @@ const sema_type& builtin_cmake_namespace_context::add_cxx_standard_value_type()
 
 const sema_type& builtin_cmake_namespace_context::add_visibility_type()
 {
-  static const auto token = m_builtin_tokens.cmake().visibility();
+  const auto token = m_builtin_tokens.cmake().visibility();
   const std::vector<lexer::token> enumerators{
     m_builtin_tokens.cmake().visibility_interface(),
     m_builtin_tokens.cmake().visibility_private(),
@@ -321,7 +323,7 @@ const sema_type& builtin_cmake_namespace_context::add_visibility_type()
 type_builder builtin_cmake_namespace_context::add_cxx_compiler_info_type(
   const sema_type& cxx_compiler_id)
 {
-  static const auto token = m_builtin_tokens.cmake().cxx_compiler_info_name();
+  const auto token = m_builtin_tokens.cmake().cxx_compiler_info_name();
   const auto name_representation =
     ast::type_representation{ ast::qualified_name{ token } };
   type_builder builder{ m_factories, m_qualified_ctxs.types, *this,
@@ -348,7 +350,7 @@ builtin_cmake_namespace_context::types_accessor() const
 
 type_builder builtin_cmake_namespace_context::add_version_type()
 {
-  static const auto token = m_builtin_tokens.version().name();
+  const auto token = m_builtin_tokens.version().name();
   return add_type_and_get_builder(token);
 }
 
@@ -438,7 +440,7 @@ void builtin_cmake_namespace_context::add_version_member_functions(
 
 type_builder builtin_cmake_namespace_context::add_library_type()
 {
-  static const auto token = m_builtin_tokens.library().name();
+  const auto token = m_builtin_tokens.library().name();
   return add_type_and_get_builder(token);
 }
 
@@ -499,7 +501,7 @@ void builtin_cmake_namespace_context::add_library_member_functions(
 type_builder builtin_cmake_namespace_context::add_executable_type()
 {
 
-  static const auto token = m_builtin_tokens.executable().name();
+  const auto token = m_builtin_tokens.executable().name();
   return add_type_and_get_builder(token);
 }
 
@@ -561,7 +563,7 @@ void builtin_cmake_namespace_context::add_executable_member_functions(
 
 type_builder builtin_cmake_namespace_context::add_project_type()
 {
-  static const auto token = m_builtin_tokens.project().name();
+  const auto token = m_builtin_tokens.project().name();
   return add_type_and_get_builder(token);
 }
 
@@ -609,7 +611,7 @@ void builtin_cmake_namespace_context::add_project_member_functions(
 
 type_builder builtin_cmake_namespace_context::add_option_type()
 {
-  static const auto token = m_builtin_tokens.option().name();
+  const auto token = m_builtin_tokens.option().name();
   return add_type_and_get_builder(token);
 }
 
@@ -644,7 +646,7 @@ void builtin_cmake_namespace_context::add_option_member_functions(
 
 const sema_type& builtin_cmake_namespace_context::add_system_id_type()
 {
-  static const auto token = m_builtin_tokens.cmake().system_id_name();
+  const auto token = m_builtin_tokens.cmake().system_id_name();
   const std::vector<lexer::token> enumerators{
     m_builtin_tokens.cmake().system_id_windows(),
     m_builtin_tokens.cmake().system_id_unix(),
@@ -657,7 +659,7 @@ const sema_type& builtin_cmake_namespace_context::add_system_info_type(
   const sema_type& system_id)
 {
 
-  static const auto token = m_builtin_tokens.cmake().system_info_name();
+  const auto token = m_builtin_tokens.cmake().system_info_name();
   const auto name_representation =
     ast::type_representation{ ast::qualified_name{ token } };
   type_builder builder{ m_factories, m_qualified_ctxs.types, *this,
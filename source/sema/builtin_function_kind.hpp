@@ -175,6 +175,8 @@ enum class builtin_function_kind
   list_empty,
   list_find_value,
   list_find_value_pos,
+  list_contains_value,
+  list_unique,
   list_operator_plus_value,
   list_operator_plus_list,
   list_operator_plus_equal_value,
@@ -211,6 +213,9 @@ enum class builtin_function_kind
 
   option_ctor_description,
   option_ctor_description_value,
-  option_value
+  option_value,
+
+  // Not a function. Number of the kinds above.
+  count
 };
 }
@@ -74,7 +74,7 @@ void builtin_sema_context::add_functions()
 
 type_builder builtin_sema_context::add_bool_type()
 {
-  static const auto token = m_builtin_tokens.bool_().name();
+  const auto token = m_builtin_tokens.bool_().name();
   return add_type_and_get_builder(token);
 }
 
@@ -136,7 +136,7 @@ void builtin_sema_context::add_bool_member_functions(
 
 type_builder builtin_sema_context::add_int_type()
 {
-  static const auto token = m_builtin_tokens.int_().name();
+  const auto token = m_builtin_tokens.int_().name();
   return add_type_and_get_builder(token);
 }
 
@@ -261,7 +261,7 @@ void builtin_sema_context::add_int_member_functions(
 
 type_builder builtin_sema_context::add_double_type()
 {
-  static const auto token = m_builtin_tokens.double_().name();
+  const auto token = m_builtin_tokens.double_().name();
   return add_type_and_get_builder(token);
 }
 
@@ -379,7 +379,7 @@ void builtin_sema_context::add_double_member_functions(
 
 type_builder builtin_sema_context::add_string_type()
 {
-  static const auto token = m_builtin_tokens.string().name();
+  const auto token = m_builtin_tokens.string().name();
   return add_type_and_get_builder(token);
 }
 
@@ -596,7 +596,7 @@ void builtin_sema_context::add_string_member_functions(
 
 type_builder builtin_sema_context::add_void_type()
 {
-  static const auto token = m_builtin_tokens.void_().name();
+  const auto token = m_builtin_tokens.void_().name();
   return add_type_and_get_builder(token);
 }
 
@@ -14,7 +14,8 @@ public:
                                  const sema_type& return_type,
                                  function_signature s,
                                  builtin_function_kind kind)
-    : m_ctx{ ctx }
+    : sema_function{ sema_function_kind::builtin }
+    , m_ctx{ ctx }
     , m_return_type{ return_type }
     , m_signature{ std::move(s) }
     , m_kind{ kind }
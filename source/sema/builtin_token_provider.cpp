@@ -8,6 +8,7 @@ builtin_token_provider::builtin_token_provider(
   : m_builtin_documentation_path{ std::move(builtin_documentation_path) }
 {
   initialize_documentation_paths();
+  initialize_documentation_sources();
 }
 
 void builtin_token_provider::initialize_documentation_paths()
@@ -39,6 +40,31 @@ void builtin_token_provider::initialize_documentation_paths()
   m_documentation_paths[provider_type::cmake] = path_provider("cmake.cmsl");
 }
 
+void builtin_token_provider::initialize_documentation_sources()
+{
+  const auto add_source = [this](provider_type type,
+                                 cmsl::string_view documentation) {
+    const auto path = get_path(type);
+    m_documentation_sources[type] = path
+      ? std::make_unique<source_info>(*path, documentation)
+      : std::make_unique<source_info>(documentation);
+  };
+
+  add_source(provider_type::bool_, bool_documentation_source);
+  add_source(provider_type::int_, int_documentation_source);
+  add_source(provider_type::double_, double_documentation_source);
+  add_source(provider_type::string, string_documentation_source);
+  add_source(provider_type::extern_, extern_documentation_source);
+  add_source(provider_type::list, list_documentation_source);
+  add_source(provider_type::executable, executable_documentation_source);
+  add_source(provider_type::library, library_documentation_source);
+  add_source(provider_type::project, project_documentation_source);
+  add_source(provider_type::version, version_documentation_source);
+  add_source(provider_type::void_, void_documentation_source);
+  add_source(provider_type::option, option_documentation_source);
+  add_source(provider_type::cmake, cmake_documentation_source);
+}
+
 std::optional<cmsl::string_view> builtin_token_provider::get_path(
   builtin_token_provider::provider_type type) const
 {
@@ -51,68 +77,74 @@ std::optional<cmsl::string_view> builtin_token_provider::get_path(
   return path;
 }
 
+const source_info& builtin_token_provider::get_source(
+  builtin_token_provider::provider_type type) const
+{
+  return *m_documentation_sources.at(type);
+}
+
 bool_tokens_provider builtin_token_provider::bool_() const
 {
-  return bool_tokens_provider{ get_path(provider_type::bool_) };
+  return bool_tokens_provider{ get_source(provider_type::bool_) };
 }
 
 double_tokens_provider builtin_token_provider::double_() const
 {
-  return double_tokens_provider{ get_path(provider_type::double_) };
+  return double_tokens_provider{ get_source(provider_type::double_) };
 }
 
 executable_tokens_provider builtin_token_provider::executable() const
 {
-  return executable_tokens_provider{ get_path(provider_type::executable) };
+  return executable_tokens_provider{ get_source(provider_type::executable) };
 }
 
 library_tokens_provider builtin_token_provider::library() const
 {
-  return library_tokens_provider{ get_path(provider_type::library) };
+  return library_tokens_provider{ get_source(provider_type::library) };
 }
 
 list_tokens_provider builtin_token_provider::list() const
 {
-  return list_tokens_provider{ get_path(provider_type::list) };
+  return list_tokens_provider{ get_source(provider_type::list) };
 }
 
 project_tokens_provider builtin_token_provider::project() const
 {
-  return project_tokens_provider{ get_path(provider_type::project) };
+  return project_tokens_provider{ get_source(provider_type::project) };
 }
 
 int_tokens_provider builtin_token_provider::int_() const
 {
-  return int_tokens_provider{ get_path(provider_type::int_) };
+  return int_tokens_provider{ get_source(provider_type::int_) };
 }
 
 string_tokens_provider builtin_token_provider::string() const
 {
-  return string_tokens_provider{ get_path(provider_type::string) };
+  return string_tokens_provider{ get_source(provider_type::string) };
 }
 
 version_tokens_provider builtin_token_provider::version() const
 {
-  return version_tokens_provider{ get_path(provider_type::version) };
+  return version_tokens_provider{ get_source(provider_type::version) };
 }
 
 void_tokens_provider builtin_token_provider::void_() const
 {
-  return void_tokens_provider{ get_path(provider_type::void_) };
+  return void_tokens_provider{ get_source(provider_type::void_) };
 }
 
 option_tokens_provider builtin_token_provider::option() const
 {
-  return option_tokens_provider{ get_path(provider_type::option) };
+  return option_tokens_provider{ get_source(provider_type::option) };
 }
 
 cmake_tokens_provider builtin_token_provider::cmake() const
 {
-  return cmake_tokens_provider{ get_path(provider_type::cmake) };
+  return cmake_tokens_provider{ get_source(provider_type::cmake) };
 }
 
 extern_tokens_provider builtin_token_provider::extern_() const
 {
-  return extern_tokens_provider{ get_path(provider_type::extern_) };
+  return extern_tokens_provider{ get_source(provider_type::extern_) };
 }
 }
@@ -2,6 +2,7 @@
 
 #include "lexer/token.hpp"
 
+#include <memory>
 #include <optional>
 #include <unordered_map>
 
@@ -80,11 +81,16 @@ private:
   };
 
   void initialize_documentation_paths();
+  void initialize_documentation_sources();
 
   std::optional<cmsl::string_view> get_path(provider_type type) const;
+  const source_info& get_source(provider_type type) const;
 
 private:
   std::string m_builtin_documentation_path;
   std::unordered_map<provider_type, std::string> m_documentation_paths;
+  // Tokens of a provider refer to its documentation source.
+  std::unordered_map<provider_type, std::unique_ptr<source_info>>
+    m_documentation_sources;
 };
 }
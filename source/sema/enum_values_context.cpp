@@ -39,6 +39,14 @@ std::unique_ptr<enum_values_context> enum_values_context_impl::clone() const
   return std::move(created);
 }
 
+std::unique_ptr<enum_values_context>
+enum_values_context_impl::create_overlay() const
+{
+  auto created = std::make_unique<enum_values_context_impl>();
+  created->m_finder = m_finder.create_overlay();
+  return std::move(created);
+}
+
 std::unique_ptr<enum_values_context>
 enum_values_context_impl::collect_exported_stuff() const
 {
@@ -38,6 +38,7 @@ public:
   virtual void leave_ctx() = 0;
 
   virtual std::unique_ptr<enum_values_context> clone() const = 0;
+  virtual std::unique_ptr<enum_values_context> create_overlay() const = 0;
   virtual std::unique_ptr<enum_values_context> collect_exported_stuff()
     const = 0;
 
@@ -58,6 +59,7 @@ public:
   void leave_ctx() override;
 
   std::unique_ptr<enum_values_context> clone() const override;
+  std::unique_ptr<enum_values_context> create_overlay() const override;
   std::unique_ptr<enum_values_context> collect_exported_stuff() const override;
 
   bool merge_imported_stuff(const enum_values_context& imported,
@@ -170,34 +170,17 @@ const sema_type* sema_generic_type_factory::create_generic(
   return nullptr;
 }
 
-const sema_type* sema_generic_type_factory::create_list(
-  const ast::type_representation& name)
+namespace {
+std::vector<type_builder::builtin_function_info> list_functions(
+  const sema_type& list_type, const sema_type& value_type,
+  const builtin_types_accessor& builtin_types,
+  const list_tokens_provider& token_provider)
 {
-  constexpr auto list_generic_parameters{ 1u };
-  if (!check_template_parameters_count(name, list_generic_parameters)) {
-    return nullptr;
-  }
-
-  const auto& value_type_representation = name.nested_types().front();
-  const auto value_type =
-    try_get_or_create_value_type(value_type_representation);
-  if (!value_type) {
-    return nullptr;
-  }
+  const auto& int_type = builtin_types.int_;
+  const auto& void_type = builtin_types.void_;
+  const auto& bool_type = builtin_types.bool_;
 
-  const auto list_name_representation = prepare_list_name_representation(name);
-  type_builder builder{ m_factories, m_types_ctx, m_generic_types_context,
-                        list_name_representation };
-  builder.build_homogeneous_generic_and_register_in_context(*value_type);
-
-  const auto& list_type = builder.built_type().ty;
-  const auto& int_type = m_builtin_types.int_;
-  const auto& void_type = m_builtin_types.void_;
-  const auto& bool_type = m_builtin_types.bool_;
-
-  const auto token_provider = m_builtin_token_provider.list();
-
-  auto functions = {
+  return {
     type_builder::builtin_function_info{
       // list()
       list_type,
@@ -209,7 +192,7 @@ const sema_type* sema_generic_type_factory::create_list(
       void_type,
       function_signature{
         token_provider.push_back_value(),
-        { parameter_declaration{ *value_type, make_id_token("") } } },
+        { parameter_declaration{ value_type, make_id_token("") } } },
       builtin_function_kind::list_push_back_value },
     // Todo: push_back could return reference
     type_builder::builtin_function_info{
@@ -225,7 +208,7 @@ const sema_type* sema_generic_type_factory::create_list(
       void_type,
       function_signature{
         token_provider.push_front_value(),
-        { parameter_declaration{ *value_type, make_id_token("") } } },
+        { parameter_declaration{ value_type, make_id_token("") } } },
       builtin_function_kind::list_push_front_value },
     // Todo: push_front could return reference
     type_builder::builtin_function_info{
@@ -247,7 +230,7 @@ const sema_type* sema_generic_type_factory::create_list(
       builtin_function_kind::list_pop_front },
     type_builder::builtin_function_info{
       // value_type& at(int)
-      *value_type,
+      value_type,
       function_signature{
         token_provider.at(),
         { parameter_declaration{ int_type, make_id_token("") } } },
@@ -255,12 +238,12 @@ const sema_type* sema_generic_type_factory::create_list(
     // Todo: front should return a reference
     type_builder::builtin_function_info{
       // value_type front()
-      *value_type, function_signature{ token_provider.front(), {} },
+      value_type, function_signature{ token_provider.front(), {} },
       builtin_function_kind::list_front },
     // Todo: back should return a reference
     type_builder::builtin_function_info{
       // value_type back()
-      *value_type, function_signature{ token_provider.back(), {} },
+      value_type, function_signature{ token_provider.back(), {} },
       builtin_function_kind::list_back },
     // Todo: insert could return reference
     type_builder::builtin_function_info{
@@ -269,7 +252,7 @@ const sema_type* sema_generic_type_factory::create_list(
       function_signature{
         token_provider.insert_pos_value(),
         { parameter_declaration{ int_type, make_id_token("") },
-          parameter_declaration{ *value_type, make_id_token("") } } },
+          parameter_declaration{ value_type, make_id_token("") } } },
       builtin_function_kind::list_insert_pos_value },
     // Todo: insert could return reference
     type_builder::builtin_function_info{
@@ -302,14 +285,14 @@ const sema_type* sema_generic_type_factory::create_list(
       int_type,
       function_signature{
         token_provider.remove_value(),
-        { parameter_declaration{ *value_type, make_id_token("") } } },
+        { parameter_declaration{ value_type, make_id_token("") } } },
       builtin_function_kind::list_remove_value },
     type_builder::builtin_function_info{
       // int remove(value_type, int count)
       int_type,
       function_signature{
         token_provider.remove_value_count(),
-        { parameter_declaration{ *value_type, make_id_token("") },
+        { parameter_declaration{ value_type, make_id_token("") },
           parameter_declaration{ int_type, make_id_token("") } } },
       builtin_function_kind::list_remove_value_count },
     type_builder::builtin_function_info{
@@ -317,7 +300,7 @@ const sema_type* sema_generic_type_factory::create_list(
       int_type,
       function_signature{
         token_provider.remove_last(),
-        { parameter_declaration{ *value_type, make_id_token("") },
+        { parameter_declaration{ value_type, make_id_token("") },
           parameter_declaration{ int_type, make_id_token("") } } },
       builtin_function_kind::list_remove_last_value_count },
     type_builder::builtin_function_info{
@@ -375,22 +358,33 @@ const sema_type* sema_generic_type_factory::create_list(
       int_type,
       function_signature{
         token_provider.find_value(),
-        { parameter_declaration{ *value_type, make_id_token("") } } },
+        { parameter_declaration{ value_type, make_id_token("") } } },
       builtin_function_kind::list_find_value },
     type_builder::builtin_function_info{
       // int find(value_type, int pos)
       int_type,
       function_signature{
         token_provider.find_value_pos(),
-        { parameter_declaration{ *value_type, make_id_token("") },
+        { parameter_declaration{ value_type, make_id_token("") },
           parameter_declaration{ int_type, make_id_token("") } } },
       builtin_function_kind::list_find_value_pos },
+    type_builder::builtin_function_info{
+      // bool contains(value_type)
+      bool_type,
+      function_signature{
+        token_provider.contains_value(),
+        { parameter_declaration{ value_type, make_id_token("") } } },
+      builtin_function_kind::list_contains_value },
+    type_builder::builtin_function_info{
+      // int unique()
+      int_type, function_signature{ token_provider.unique(), {} },
+      builtin_function_kind::list_unique },
     type_builder::builtin_function_info{
       // list operator+(value_type)
       list_type,
       function_signature{
         token_provider.operator_plus_value(),
-        { parameter_declaration{ *value_type, make_id_token("") } } },
+        { parameter_declaration{ value_type, make_id_token("") } } },
       builtin_function_kind::list_operator_plus_value },
     type_builder::builtin_function_info{
       // list operator+(list)
@@ -404,7 +398,7 @@ const sema_type* sema_generic_type_factory::create_list(
       list_type,
       function_signature{
         token_provider.operator_plus_equal_value(),
-        { parameter_declaration{ *value_type, make_id_token("") } } },
+        { parameter_declaration{ value_type, make_id_token("") } } },
       builtin_function_kind::list_operator_plus_equal_value },
     type_builder::builtin_function_info{
       // list& operator+=(list)
@@ -414,8 +408,39 @@ const sema_type* sema_generic_type_factory::create_list(
         { parameter_declaration{ list_type, make_id_token("") } } },
       builtin_function_kind::list_operator_plus_equal_list }
   };
+}
+}
 
-  builder.with_builtin_functions(functions);
+const sema_type* sema_generic_type_factory::create_list(
+  const ast::type_representation& name)
+{
+  constexpr auto list_generic_parameters{ 1u };
+  if (!check_template_parameters_count(name, list_generic_parameters)) {
+    return nullptr;
+  }
+
+  const auto& value_type_representation = name.nested_types().front();
+  const auto value_type =
+    try_get_or_create_value_type(value_type_representation);
+  if (!value_type) {
+    return nullptr;
+  }
+
+  const auto list_name_representation = prepare_list_name_representation(name);
+  type_builder builder{ m_factories, m_types_ctx, m_generic_types_context,
+                        list_name_representation };
+  builder.build_homogeneous_generic_and_register_in_context(*value_type);
+
+  const auto& list_type = builder.built_type().ty;
+
+  // Most of the list types use just a few of the functions, if any, so
+  // they're created on the first lookup.
+  builder.with_lazy_builtin_functions(
+    [&list_type, value_type, builtin_types = m_builtin_types,
+     token_provider = m_builtin_token_provider.list()] {
+      return list_functions(list_type, *value_type, builtin_types,
+                            token_provider);
+    });
 
   return &list_type;
 }
@@ -428,15 +453,12 @@ const sema_type* sema_generic_type_factory::try_get_or_create_value_type(
     if (!found) {
       errors::error err;
       err.message = "value type not found";
-      err.range = source_range{
-        type_name.generic_name().primary_name().src_range().begin,
-        type_name.generic_name().tokens.back().src_range().end
-      };
+      // The value type isn't generic, so it has no generic name to point at.
+      err.range = type_name.src_range();
       err.type = errors::error_type::error;
-      const auto source = type_name.generic_name().primary_name().source();
+      const auto source = type_name.source();
       err.source_path = source.path();
-      const auto line_info = source.line(
-        type_name.generic_name().primary_name().src_range().begin.line);
+      const auto line_info = source.line(err.range.begin.line);
       err.line_start_pos = line_info.start_pos;
       err.line_snippet = line_info.line;
       m_errors_observer.notify_error(err);
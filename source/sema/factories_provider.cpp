@@ -24,4 +24,9 @@ sema_type_factory factories_provider::type_factory(types_context& ctx)
 {
   return sema_type_factory{ ctx, m_types };
 }
+
+std::size_t factories_provider::functions_count() const
+{
+  return m_functions.size();
+}
 }
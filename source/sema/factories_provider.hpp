@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -21,6 +22,9 @@ public:
   sema_function_factory function_factory();
   sema_type_factory type_factory(types_context& ctx);
 
+  // Count of all the functions created so far, including the builtin ones.
+  std::size_t functions_count() const;
+
 private:
   std::vector<std::unique_ptr<sema_context>> m_contextes;
   std::vector<std::unique_ptr<sema_function>> m_functions;
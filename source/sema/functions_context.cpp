@@ -65,6 +65,14 @@ std::unique_ptr<functions_context> functions_context_impl::clone() const
   return std::move(created);
 }
 
+std::unique_ptr<functions_context>
+functions_context_impl::create_overlay() const
+{
+  auto created = std::make_unique<functions_context_impl>();
+  created->m_functions_finder = m_functions_finder.create_overlay();
+  return std::move(created);
+}
+
 std::unique_ptr<functions_context>
 functions_context_impl::collect_exported_stuff() const
 {
@@ -80,4 +88,13 @@ bool functions_context_impl::merge_imported_stuff(
   return m_functions_finder.merge_imported_stuff(casted.m_functions_finder,
                                                  errs);
 }
+
+void functions_context_impl::for_each_function(
+  const function_visitor_t& visitor) const
+{
+  m_functions_finder.for_each_entry(
+    [&visitor](const auto& qualified_name, const function_data& data) {
+      visitor(qualified_name, data.fun);
+    });
+}
 }
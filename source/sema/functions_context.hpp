@@ -3,6 +3,7 @@
 #include "sema/function_lookup_result.hpp"
 #include "sema/qualified_entries_finder.hpp"
 
+#include <functional>
 #include <memory>
 
 namespace cmsl {
@@ -33,11 +34,19 @@ public:
   virtual void leave_ctx() = 0;
 
   virtual std::unique_ptr<functions_context> clone() const = 0;
+  virtual std::unique_ptr<functions_context> create_overlay() const = 0;
   virtual std::unique_ptr<functions_context> collect_exported_stuff()
     const = 0;
 
   virtual bool merge_imported_stuff(const functions_context& imported,
                                     errors::errors_observer& errs) = 0;
+
+  // Visits all the functions that can be found by a qualified name, with the
+  // name given from the root scope.
+  using function_visitor_t =
+    std::function<void(const std::vector<lexer::token>& qualified_name,
+                       const sema_function& fun)>;
+  virtual void for_each_function(const function_visitor_t& visitor) const = 0;
 };
 
 class functions_context_impl : public functions_context
@@ -62,11 +71,14 @@ public:
   void leave_ctx() override;
 
   std::unique_ptr<functions_context> clone() const override;
+  std::unique_ptr<functions_context> create_overlay() const override;
   std::unique_ptr<functions_context> collect_exported_stuff() const override;
 
   bool merge_imported_stuff(const functions_context& imported,
                             errors::errors_observer& errs) override;
 
+  void for_each_function(const function_visitor_t& visitor) const override;
+
 private:
   qualified_entries_finder<function_data> m_functions_finder;
 };
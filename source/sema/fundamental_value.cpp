@@ -0,0 +1,284 @@
+#include "sema/fundamental_value.hpp"
+
+#include "sema/builtin_function_kind.hpp"
+#include "sema/builtin_sema_function.hpp"
+#include "sema/sema_nodes.hpp"
+
+#include <limits>
+
+namespace cmsl::sema {
+namespace {
+using kind_t = builtin_function_kind;
+
+// Integer division is undefined for these operands. It is not folded, so
+// it behaves the same as before folding, at run time.
+bool is_undefined_division(kind_t function, fundamental_value lhs,
+                           fundamental_value rhs)
+{
+  if (function != kind_t::int_operator_slash) {
+    return false;
+  }
+
+  return rhs.get_int() == 0 ||
+    (lhs.get_int() == std::numeric_limits<int_t>::min() &&
+     rhs.get_int() == -1);
+}
+
+std::unique_ptr<expression_node> make_literal(const ast::ast_node& ast_node,
+                                              const sema_type& type,
+                                              fundamental_value value)
+{
+  switch (value.which()) {
+    case fundamental_value::kind::bool_:
+      return std::make_unique<bool_value_node>(ast_node, type,
+                                               value.get_bool());
+    case fundamental_value::kind::int_:
+      return std::make_unique<int_value_node>(ast_node, type,
+                                              value.get_int());
+    case fundamental_value::kind::double_:
+      return std::make_unique<double_value_node>(ast_node, type,
+                                                 value.get_double());
+  }
+
+  return nullptr;
+}
+
+std::optional<kind_t> builtin_kind(const sema_function& function)
+{
+  if (function.function_kind() != sema_function_kind::builtin) {
+    return std::nullopt;
+  }
+
+  return static_cast<const builtin_sema_function&>(function).kind();
+}
+}
+
+std::optional<kind_t> assigned_value_operator(kind_t function)
+{
+  switch (function) {
+    case kind_t::int_operator_plus_equal:
+      return kind_t::int_operator_plus;
+    case kind_t::int_operator_minus_equal:
+      return kind_t::int_operator_minus;
+    case kind_t::int_operator_star_equal:
+      return kind_t::int_operator_star;
+    case kind_t::int_operator_slash_equal:
+      return kind_t::int_operator_slash;
+    case kind_t::double_operator_plus_equal:
+      return kind_t::double_operator_plus;
+    case kind_t::double_operator_minus_equal:
+      return kind_t::double_operator_minus;
+    case kind_t::double_operator_star_equal:
+      return kind_t::double_operator_star;
+    case kind_t::double_operator_slash_equal:
+      return kind_t::double_operator_slash;
+    default:
+      return std::nullopt;
+  }
+}
+
+bool is_fundamental_assignment(kind_t function)
+{
+  return function == kind_t::bool_operator_equal ||
+    function == kind_t::int_operator_equal ||
+    function == kind_t::double_operator_equal;
+}
+
+fundamental_value::fundamental_value(bool value)
+  : m_kind{ kind::bool_ }
+  , m_bool{ value }
+{
+}
+
+fundamental_value::fundamental_value(int_t value)
+  : m_kind{ kind::int_ }
+  , m_int{ value }
+{
+}
+
+fundamental_value::fundamental_value(double value)
+  : m_kind{ kind::double_ }
+  , m_double{ value }
+{
+}
+
+std::optional<fundamental_value> fundamental_value::of_literal(
+  const expression_node& node)
+{
+  if (const auto literal = dynamic_cast<const bool_value_node*>(&node)) {
+    return fundamental_value{ literal->value() };
+  }
+  if (const auto literal = dynamic_cast<const int_value_node*>(&node)) {
+    return fundamental_value{ literal->value() };
+  }
+  if (const auto literal = dynamic_cast<const double_value_node*>(&node)) {
+    return fundamental_value{ literal->value() };
+  }
+
+  return std::nullopt;
+}
+
+bool is_fundamental_operator(kind_t function)
+{
+  switch (function) {
+    case kind_t::bool_operator_equal:
+    case kind_t::bool_operator_equal_equal:
+    case kind_t::bool_operator_pipe_pipe:
+    case kind_t::bool_operator_amp_amp:
+
+    case kind_t::int_operator_plus:
+    case kind_t::int_operator_minus:
+    case kind_t::int_operator_star:
+    case kind_t::int_operator_slash:
+    case kind_t::int_operator_less:
+    case kind_t::int_operator_less_equal:
+    case kind_t::int_operator_greater:
+    case kind_t::int_operator_greater_equal:
+    case kind_t::int_operator_equal_equal:
+    case kind_t::int_operator_equal:
+    case kind_t::int_operator_plus_equal:
+    case kind_t::int_operator_minus_equal:
+    case kind_t::int_operator_star_equal:
+    case kind_t::int_operator_slash_equal:
+
+    case kind_t::double_operator_plus:
+    case kind_t::double_operator_minus:
+    case kind_t::double_operator_star:
+    case kind_t::double_operator_slash:
+    case kind_t::double_operator_less:
+    case kind_t::double_operator_less_equal:
+    case kind_t::double_operator_greater:
+    case kind_t::double_operator_greater_equal:
+    case kind_t::double_operator_equal:
+    case kind_t::double_operator_plus_equal:
+    case kind_t::double_operator_minus_equal:
+    case kind_t::double_operator_star_equal:
+    case kind_t::double_operator_slash_equal:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+std::optional<kind_t> fundamental_operator_kind(const sema_function& function)
+{
+  const auto kind = builtin_kind(function);
+  if (!kind || !is_fundamental_operator(*kind)) {
+    return std::nullopt;
+  }
+
+  return kind;
+}
+
+std::optional<fundamental_value> evaluate_fundamental_operator(
+  kind_t function, fundamental_value lhs, fundamental_value rhs)
+{
+  switch (function) {
+    case kind_t::bool_operator_equal_equal:
+      return fundamental_value{ lhs.get_bool() == rhs.get_bool() };
+    case kind_t::bool_operator_pipe_pipe:
+      return fundamental_value{ lhs.get_bool() || rhs.get_bool() };
+    case kind_t::bool_operator_amp_amp:
+      return fundamental_value{ lhs.get_bool() && rhs.get_bool() };
+
+    case kind_t::int_operator_plus:
+      return fundamental_value{ lhs.get_int() + rhs.get_int() };
+    case kind_t::int_operator_minus:
+      return fundamental_value{ lhs.get_int() - rhs.get_int() };
+    case kind_t::int_operator_star:
+      return fundamental_value{ lhs.get_int() * rhs.get_int() };
+    case kind_t::int_operator_slash:
+      return fundamental_value{ lhs.get_int() / rhs.get_int() };
+    case kind_t::int_operator_less:
+      return fundamental_value{ lhs.get_int() < rhs.get_int() };
+    case kind_t::int_operator_less_equal:
+      return fundamental_value{ lhs.get_int() <= rhs.get_int() };
+    case kind_t::int_operator_greater:
+      return fundamental_value{ lhs.get_int() > rhs.get_int() };
+    case kind_t::int_operator_greater_equal:
+      return fundamental_value{ lhs.get_int() >= rhs.get_int() };
+    case kind_t::int_operator_equal_equal:
+      return fundamental_value{ lhs.get_int() == rhs.get_int() };
+
+    case kind_t::double_operator_plus:
+      return fundamental_value{ lhs.get_double() + rhs.get_double() };
+    case kind_t::double_operator_minus:
+      return fundamental_value{ lhs.get_double() - rhs.get_double() };
+    case kind_t::double_operator_star:
+      return fundamental_value{ lhs.get_double() * rhs.get_double() };
+    case kind_t::double_operator_slash:
+      return fundamental_value{ lhs.get_double() / rhs.get_double() };
+    case kind_t::double_operator_less:
+      return fundamental_value{ lhs.get_double() < rhs.get_double() };
+    case kind_t::double_operator_less_equal:
+      return fundamental_value{ lhs.get_double() <= rhs.get_double() };
+    case kind_t::double_operator_greater:
+      return fundamental_value{ lhs.get_double() > rhs.get_double() };
+    case kind_t::double_operator_greater_equal:
+      return fundamental_value{ lhs.get_double() >= rhs.get_double() };
+
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<fundamental_value> evaluate_fundamental_operator(
+  kind_t function, fundamental_value operand)
+{
+  switch (function) {
+    case kind_t::bool_operator_unary_exclaim:
+      return fundamental_value{ !operand.get_bool() };
+    case kind_t::int_operator_unary_minus:
+      return fundamental_value{ -1 * operand.get_int() };
+    case kind_t::double_operator_unary_minus:
+      return fundamental_value{ -1 * operand.get_double() };
+
+    default:
+      return std::nullopt;
+  }
+}
+
+std::unique_ptr<expression_node> fold_constant_operator(
+  const ast::ast_node& ast_node, const sema_function& function,
+  const expression_node& lhs, const expression_node& rhs)
+{
+  const auto kind = fundamental_operator_kind(function);
+  if (!kind) {
+    return nullptr;
+  }
+
+  const auto lhs_value = fundamental_value::of_literal(lhs);
+  const auto rhs_value = fundamental_value::of_literal(rhs);
+  if (!lhs_value || !rhs_value || lhs_value->which() != rhs_value->which() ||
+      is_undefined_division(*kind, *lhs_value, *rhs_value)) {
+    return nullptr;
+  }
+
+  const auto result =
+    evaluate_fundamental_operator(*kind, *lhs_value, *rhs_value);
+  if (!result) {
+    return nullptr;
+  }
+
+  return make_literal(ast_node, function.return_type(), *result);
+}
+
+std::unique_ptr<expression_node> fold_constant_operator(
+  const ast::ast_node& ast_node, const sema_function& function,
+  const expression_node& operand)
+{
+  const auto kind = builtin_kind(function);
+  const auto value = fundamental_value::of_literal(operand);
+  if (!kind || !value) {
+    return nullptr;
+  }
+
+  const auto result = evaluate_fundamental_operator(*kind, *value);
+  if (!result) {
+    return nullptr;
+  }
+
+  return make_literal(ast_node, function.return_type(), *result);
+}
+}
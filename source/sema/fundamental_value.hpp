@@ -0,0 +1,95 @@
+#pragma once
+
+#include "common/int_alias.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace cmsl {
+namespace ast {
+class ast_node;
+}
+
+namespace sema {
+enum class builtin_function_kind;
+class expression_node;
+class sema_function;
+
+// Value of a bool, an int or a double, without an instance around it.
+class fundamental_value
+{
+public:
+  enum class kind : std::uint8_t
+  {
+    bool_,
+    int_,
+    double_
+  };
+
+  explicit fundamental_value(bool value);
+  explicit fundamental_value(int_t value);
+  explicit fundamental_value(double value);
+
+  // Returns value of a bool, int or double literal, nullopt for any other
+  // expression.
+  static std::optional<fundamental_value> of_literal(
+    const expression_node& node);
+
+  kind which() const { return m_kind; }
+
+  bool get_bool() const { return m_bool; }
+  int_t get_int() const { return m_int; }
+  double get_double() const { return m_double; }
+
+private:
+  kind m_kind;
+  union
+  {
+    bool m_bool;
+    int_t m_int;
+    double m_double;
+  };
+};
+
+// Operators of bool, int and double, e.g. int + int, or double += double.
+// They can be evaluated directly on fundamental values, by sema when
+// operands are literals, and by executors without calling the builtin
+// function.
+bool is_fundamental_operator(builtin_function_kind function);
+
+// Returns kind of the function if it is a fundamental operator, nullopt
+// otherwise.
+std::optional<builtin_function_kind> fundamental_operator_kind(
+  const sema_function& function);
+
+// For a compound assignment, e.g. +=, returns the operator that computes the
+// assigned value. Nullopt for any other function.
+std::optional<builtin_function_kind> assigned_value_operator(
+  builtin_function_kind function);
+
+// Tells whether the function is a plain assignment of a fundamental type.
+bool is_fundamental_assignment(builtin_function_kind function);
+
+// Evaluates an operator that doesn't modify its operands. Returns nullopt
+// for assignments and functions that are not fundamental operators.
+std::optional<fundamental_value> evaluate_fundamental_operator(
+  builtin_function_kind function, fundamental_value lhs,
+  fundamental_value rhs);
+
+// Same as above, for unary - and !.
+std::optional<fundamental_value> evaluate_fundamental_operator(
+  builtin_function_kind function, fundamental_value operand);
+
+// Folds an operator with literal operands to a literal. Returns null if
+// the operator is not a fundamental one, an operand is not a literal or the
+// result would be undefined, e.g. in case of an integer division by zero.
+// Such expressions are left to be evaluated at run time.
+std::unique_ptr<expression_node> fold_constant_operator(
+  const ast::ast_node& ast_node, const sema_function& function,
+  const expression_node& lhs, const expression_node& rhs);
+std::unique_ptr<expression_node> fold_constant_operator(
+  const ast::ast_node& ast_node, const sema_function& function,
+  const expression_node& operand);
+}
+}
@@ -22,6 +22,10 @@ generic_type_creation_utils::generic_type_creation_utils(
 
 const sema_type& generic_type_creation_utils::list_of_strings()
 {
+  if (m_list_of_strings != nullptr) {
+    return *m_list_of_strings;
+  }
+
   const auto string_token = make_token(lexer::token_type::kw_string, "string");
   const auto string_type_representation =
     ast::type_representation{ ast::qualified_name{ string_token } };
@@ -34,7 +38,9 @@ const sema_type& generic_type_creation_utils::list_of_strings()
   };
   const auto sources_list_type_name_representation =
     ast::type_representation{ generic_name };
-  return get_or_create_generic_type(sources_list_type_name_representation);
+  m_list_of_strings =
+    &get_or_create_generic_type(sources_list_type_name_representation);
+  return *m_list_of_strings;
 }
 
 const sema_type& generic_type_creation_utils::get_or_create_generic_type(
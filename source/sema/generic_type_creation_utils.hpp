@@ -41,6 +41,8 @@ private:
   const builtin_token_provider& m_builtin_token_provider;
   const builtin_types_accessor& m_builtin_types;
   types_context& m_types_ctx;
+  // Builtin functions of many types take lists of strings.
+  const sema_type* m_list_of_strings{ nullptr };
 };
 }
 }
@@ -1,13 +1,35 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 
 namespace cmsl::sema {
 class sema_type;
+
+// Where a variable lives during execution. It's resolved by sema, so that
+// executors go straight to the right storage.
+enum class identifier_storage
+{
+  // Not resolved, every storage needs to be searched.
+  unknown,
+  // Parameter or local variable of a function.
+  local,
+  // Variable of a module, also of an imported one.
+  global,
+  // Member of the current class instance.
+  member,
+  // Variable provided by the builtin context, e.g. from cmake namespace.
+  builtin
+};
+
 struct identifier_info
 {
   std::reference_wrapper<const sema_type> type;
   unsigned index;
+  // Slot in the frame of the enclosing function. Set only for parameters and
+  // local variables, globals and class members are looked up by index.
+  std::optional<unsigned> slot{};
+  identifier_storage storage{ identifier_storage::unknown };
 };
 
 struct builtin_identifier_info
@@ -70,6 +70,14 @@ std::unique_ptr<identifiers_context> identifiers_context_impl::clone() const
   return std::move(created);
 }
 
+std::unique_ptr<identifiers_context>
+identifiers_context_impl::create_overlay() const
+{
+  auto created = std::make_unique<identifiers_context_impl>();
+  created->m_contextes_handler = m_contextes_handler.create_overlay();
+  return std::move(created);
+}
+
 bool identifiers_context_impl::is_in_global_ctx() const
 {
   return m_contextes_handler.is_in_global_context();
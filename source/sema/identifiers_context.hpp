@@ -38,6 +38,7 @@ public:
   virtual bool is_in_global_ctx() const = 0;
 
   virtual std::unique_ptr<identifiers_context> clone() const = 0;
+  virtual std::unique_ptr<identifiers_context> create_overlay() const = 0;
   virtual std::unique_ptr<identifiers_context> collect_exported_stuff()
     const = 0;
 
@@ -65,6 +66,7 @@ public:
   bool is_in_global_ctx() const override;
 
   std::unique_ptr<identifiers_context> clone() const override;
+  std::unique_ptr<identifiers_context> create_overlay() const override;
   std::unique_ptr<identifiers_context> collect_exported_stuff() const override;
 
   bool merge_imported_stuff(const identifiers_context& imported,
@@ -17,13 +17,16 @@ namespace sema {
 class sema_type;
 class expression_node;
 class call_node;
+class overload_resolution_cache;
 
 class overload_resolution
 {
 public:
   // Todo: consider accepting source range instead of token
+  // Functions chosen for calls are stored in the cache, if it's passed.
   explicit overload_resolution(errors::errors_observer& errs,
-                               lexer::token call_token);
+                               lexer::token call_token,
+                               overload_resolution_cache* cache = nullptr);
 
   // Todo: use small vector
   const sema_function* choose(
@@ -123,6 +126,7 @@ private:
 private:
   errors::errors_observer& m_errs;
   lexer::token m_call_token;
+  overload_resolution_cache* m_cache;
 };
 }
 }
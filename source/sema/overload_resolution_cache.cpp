@@ -0,0 +1,72 @@
+#include "sema/overload_resolution_cache.hpp"
+
+#include "sema/sema_nodes.hpp"
+#include "sema/sema_type.hpp"
+
+namespace cmsl::sema {
+namespace {
+void hash_combine(std::size_t& seed, std::size_t value)
+{
+  seed ^= value + 0x9e3779b9u + (seed << 6u) + (seed >> 2u);
+}
+}
+
+bool overload_resolution_cache::argument::operator==(
+  const argument& other) const
+{
+  return type == other.type && temporary == other.temporary;
+}
+
+bool overload_resolution_cache::key::operator==(const key& other) const
+{
+  return functions == other.functions && arguments == other.arguments;
+}
+
+std::size_t overload_resolution_cache::key_hash::operator()(
+  const key& k) const
+{
+  std::size_t seed{ 0u };
+  for (const auto function : k.functions) {
+    hash_combine(seed, std::hash<const sema_function*>{}(function));
+  }
+  for (const auto& arg : k.arguments) {
+    hash_combine(seed, std::hash<const sema_type*>{}(arg.type));
+    hash_combine(seed, std::hash<bool>{}(arg.temporary));
+  }
+
+  return seed;
+}
+
+std::optional<overload_resolution_cache::key>
+overload_resolution_cache::make_key(
+  const single_scope_function_lookup_result_t& functions,
+  const std::vector<std::reference_wrapper<const expression_node>>&
+    call_parameters)
+{
+  key k{ functions, {} };
+  k.arguments.reserve(call_parameters.size());
+
+  for (const auto& param : call_parameters) {
+    const auto& param_type = param.get().type();
+    if (param_type.is_designated_initializer()) {
+      return std::nullopt;
+    }
+
+    k.arguments.emplace_back(
+      argument{ &param_type, param.get().produces_temporary_value() });
+  }
+
+  return k;
+}
+
+const sema_function* overload_resolution_cache::find(const key& k) const
+{
+  const auto found = m_chosen.find(k);
+  return found != std::cend(m_chosen) ? found->second : nullptr;
+}
+
+void overload_resolution_cache::store(key k, const sema_function& function)
+{
+  m_chosen.emplace(std::move(k), &function);
+}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "sema/function_lookup_result.hpp"
+
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace cmsl::sema {
+class expression_node;
+class sema_type;
+
+// Remembers functions chosen by overload resolution. Whether a function
+// matches a call depends only on types of the arguments and whether they
+// are temporary values, so calls with the same candidates and such
+// arguments, e.g. thousands of list<string>::push_back(string) calls, are
+// resolved once.
+class overload_resolution_cache
+{
+public:
+  struct argument
+  {
+    const sema_type* type;
+    // Matters when a reference parameter is initialized.
+    bool temporary;
+
+    bool operator==(const argument& other) const;
+  };
+
+  struct key
+  {
+    single_scope_function_lookup_result_t functions;
+    std::vector<argument> arguments;
+
+    bool operator==(const key& other) const;
+  };
+
+  // Returns nullopt for calls that can't be cached, e.g. with designated
+  // initializers, which are checked member by member.
+  static std::optional<key> make_key(
+    const single_scope_function_lookup_result_t& functions,
+    const std::vector<std::reference_wrapper<const expression_node>>&
+      call_parameters);
+
+  const sema_function* find(const key& k) const;
+  void store(key k, const sema_function& function);
+
+private:
+  struct key_hash
+  {
+    std::size_t operator()(const key& k) const;
+  };
+
+  std::unordered_map<key, const sema_function*, key_hash> m_chosen;
+};
+}
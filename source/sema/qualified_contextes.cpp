@@ -17,6 +17,13 @@ qualified_contextes qualified_contextes::clone() const
                               types->clone() };
 }
 
+qualified_contextes qualified_contextes::create_overlay() const
+{
+  return qualified_contextes{ enums->create_overlay(),
+                              functions->create_overlay(),
+                              ids->create_overlay(), types->create_overlay() };
+}
+
 qualified_contextes qualified_contextes::collect_exported_stuff() const
 {
   return qualified_contextes{ enums->collect_exported_stuff(),
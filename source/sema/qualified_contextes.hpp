@@ -26,6 +26,15 @@ struct qualified_contextes
   std::unique_ptr<types_context> types;
 
   qualified_contextes clone() const;
+  // Creates empty contexts that see everything registered in these ones,
+  // without copying it. These contexts must outlive the created ones and
+  // nothing can be registered in them anymore. Entries they refer to can
+  // still change, as long as lookups through these contexts find the same
+  // entries. Builtin types are such entries: member functions of builtin
+  // generic types are created on the first lookup (see
+  // sema_context_impl::add_functions_lazily()). It's safe because sema runs
+  // on a single thread, prefetching threads only lex and parse.
+  qualified_contextes create_overlay() const;
   qualified_contextes collect_exported_stuff() const;
   bool merge_imported_stuff(const qualified_contextes& imported,
                             errors::errors_observer& errs);
@@ -8,6 +8,7 @@
 #include "lexer/token.hpp"
 
 #include <algorithm>
+#include <memory>
 
 namespace cmsl::sema {
 template <typename Entry>
@@ -34,17 +35,30 @@ private:
     token_t name;
     node_id_t id{ k_bad_id };
     node_id_t parent_id{ k_bad_id };
+    // Node with the same qualified name in the base finder, if any.
+    node_id_t base_id{ k_bad_id };
     bool exported{ false };
     std::unordered_map<token_t, node_id_t> nodes;
     entries_map_t entries;
   };
 
+  using nodes_container_t = std::vector<tree_node>;
+
   struct node_id_and_name
   {
     token_t name;
     node_id_t id{};
   };
 
+  // Node found by a qualified name. It can exist in this finder, in the base
+  // one or in both of them.
+  struct found_node
+  {
+    token_t name;
+    node_id_t id{ k_bad_id };
+    node_id_t base_id{ k_bad_id };
+  };
+
 public:
   explicit qualified_entries_finder()
   {
@@ -54,6 +68,19 @@ public:
     m_current_nodes_path.push_back({ name_token, 0u });
   }
 
+  // Creates an empty finder that finds entries of this one too, without
+  // copying them. Used to share builtin entries between all the compiled
+  // modules. This finder must outlive the created one and nothing can be
+  // registered in it anymore, see qualified_contextes::create_overlay().
+  qualified_entries_finder create_overlay() const
+  {
+    CMSL_ASSERT_MSG(m_base == nullptr, "Overlay of an overlay");
+    qualified_entries_finder overlay;
+    overlay.m_base = this;
+    overlay.mutable_nodes_container()[0].base_id = 0u;
+    return overlay;
+  }
+
   void register_entry(token_t name, Entry entry, bool exported)
   {
     possibly_exported_entry e{ .e = std::move(entry), .exported = exported };
@@ -100,21 +127,22 @@ public:
 
   std::vector<entry_info> find(const qualified_names_t& names) const
   {
-    const auto found_range = find_it(names);
-
-    if (!found_range) {
-      return {};
+    if (is_qualified_name(names)) {
+      return find_qualified(names);
+    } else {
+      const auto name = names.front().name;
+      return find(name);
     }
-
-    return to_entries_info(*found_range);
   }
 
   std::vector<entry_info> find_in_current_node(const lexer::token& name) const
   {
-    const auto& entries = current_entries();
+    if (!m_local_nodes.empty()) {
+      return to_entries_info(m_local_nodes.back().equal_range(name));
+    }
 
-    const auto found_range = entries.equal_range(name);
-    return to_entries_info(found_range);
+    const auto& current = current_node();
+    return find_in_node(name, current.id, current.base_id);
   }
 
   std::optional<token_t> find_node_registration_token(
@@ -128,25 +156,77 @@ public:
     return node->name;
   }
 
-  // Todo: test it
+  // Visits entries of this finder and of the base one, all but the local
+  // ones. Visitor gets the qualified name of an entry, starting from the root
+  // node, and the entry.
+  template <typename Visitor>
+  void for_each_entry(const Visitor& visitor) const
+  {
+    if (m_base != nullptr) {
+      m_base->for_each_entry(visitor);
+    }
+
+    std::vector<token_t> qualified_name;
+    visit_entries(nodes_container()[0], qualified_name, visitor);
+  }
+
+  // Entries of the base finder are never exported, so they're not collected.
   qualified_entries_finder collect_exported_stuff() const
   {
     qualified_entries_finder cloned;
-    cloned.m_nodes_container = m_nodes_container;
-    cloned.erase_not_exported();
+    auto& cloned_nodes = cloned.mutable_nodes_container();
+    cloned_nodes.clear();
+
+    for (const auto& node : nodes_container()) {
+      auto& cloned_node =
+        cloned_nodes.emplace_back(tree_node{ .name = node.name,
+                                             .id = node.id,
+                                             .parent_id = node.parent_id,
+                                             .exported = node.exported,
+                                             .nodes = node.nodes });
+
+      for (const auto& entry : node.entries) {
+        if (entry.second.exported) {
+          cloned_node.entries.emplace(entry);
+        }
+      }
+    }
+
     return cloned;
   }
 
   bool merge_imported_stuff(const qualified_entries_finder& imported,
                             errors::errors_observer& errs)
   {
-    return merge_node(imported.m_nodes_container,
-                      imported.m_nodes_container[0], m_nodes_container[0]);
+    // Imported finder can share nodes with this one, so keep them alive till
+    // the merge is done.
+    const auto imported_nodes = imported.m_nodes_container;
+    auto& into = mutable_nodes_container()[0];
+    return merge_node(*imported_nodes, (*imported_nodes)[0], into);
   }
 
 private:
-  bool merge_node(std::vector<tree_node> imported_nodes_container,
-                  const tree_node& imported_node, tree_node& into)
+  template <typename Visitor>
+  void visit_entries(const tree_node& node,
+                     std::vector<token_t>& qualified_name,
+                     const Visitor& visitor) const
+  {
+    for (const auto& [token, entry] : node.entries) {
+      qualified_name.push_back(token);
+      visitor(qualified_name, entry.e);
+      qualified_name.pop_back();
+    }
+
+    for (const auto& [token, id] : node.nodes) {
+      const auto& child = nodes_container()[id];
+      qualified_name.push_back(child.name);
+      visit_entries(child, qualified_name, visitor);
+      qualified_name.pop_back();
+    }
+  }
+
+  bool merge_node(const nodes_container_t& imported_nodes_container,
+                  const tree_node& imported_node, const tree_node& into)
   {
     bool result{ true };
 
@@ -155,9 +235,15 @@ private:
 
     entries_map_t merged_entries;
 
+    const auto has_base = (m_base != nullptr && into.base_id != k_bad_id);
+    const auto into_base_entries =
+      has_base ? &m_base->nodes_container()[into.base_id].entries : nullptr;
+
     for (const auto& [token, entry] : imported_node.entries) {
       const auto found = into.entries.find(token);
-      if (found != std::cend(into.entries)) {
+      const auto found_in_base = into_base_entries != nullptr &&
+        contains(*into_base_entries, token);
+      if (found != std::cend(into.entries) || found_in_base) {
         // Todo: redeclaration
         result = false;
         continue;
@@ -184,33 +270,17 @@ private:
     return result;
   }
 
-  void erase_not_exported()
-  {
-    auto& root_node = m_nodes_container[0];
-    erase_not_exported_in_node(root_node);
-  }
-
-  void erase_not_exported_in_node(tree_node& node)
-  {
-    const auto entry_pred = [](const auto& pair) {
-      const auto& entry = pair.second;
-      return !entry.exported;
-    };
-
-    cmsl::remove_if(node.entries, entry_pred);
-
-    for (auto& child : node.nodes) {
-      const auto node_id = child.second;
-      auto& child_node = m_nodes_container[node_id];
-      erase_not_exported_in_node(child_node);
-    }
-  }
-
   std::vector<entry_info> to_entries_info(
     const search_result_range_t& range) const
   {
     std::vector<entry_info> results;
+    append_entries_info(range, results);
+    return results;
+  }
 
+  void append_entries_info(const search_result_range_t& range,
+                           std::vector<entry_info>& results) const
+  {
     std::transform(range.first, range.second, std::back_inserter(results),
                    [](const auto& pair) {
                      const auto& [registration_token, exported_entry] = pair;
@@ -220,36 +290,54 @@ private:
                                         .entry = exported_entry.e,
                                         .exported = exported_entry.exported };
                    });
+  }
 
-    return results;
+  const nodes_container_t& nodes_container() const
+  {
+    return *m_nodes_container;
+  }
+
+  // Nodes are shared by copies of a finder till one of them is modified.
+  nodes_container_t& mutable_nodes_container()
+  {
+    if (m_nodes_container.use_count() > 1) {
+      m_nodes_container =
+        std::make_shared<nodes_container_t>(*m_nodes_container);
+    }
+
+    return *m_nodes_container;
   }
 
   tree_node& current_node()
   {
+    auto& nodes = mutable_nodes_container();
     if (const auto curr_id = current_node_id(); curr_id != k_bad_id) {
-      return m_nodes_container.at(curr_id);
+      return nodes.at(curr_id);
     } else {
-      return m_nodes_container[0];
+      return nodes[0];
     }
   }
 
   const tree_node& current_node() const
   {
+    const auto& nodes = nodes_container();
     if (const auto curr_id = current_node_id(); curr_id != k_bad_id) {
-      return m_nodes_container.at(curr_id);
+      return nodes.at(curr_id);
     } else {
-      return m_nodes_container[0];
+      return nodes[0];
     }
   }
 
   node_id_t create_node(token_t name, bool exported)
   {
-    const node_id_t id = m_nodes_container.size();
+    auto& nodes = mutable_nodes_container();
+    const node_id_t id = nodes.size();
     tree_node node{ .name = name,
                     .id = id,
                     .parent_id = current_node_id(),
+                    .base_id = find_base_child(current_node_id(), name),
                     .exported = exported };
-    m_nodes_container.emplace_back(node);
+    nodes.emplace_back(node);
     if (current_node_id() != k_bad_id) {
       auto& current = current_node();
       current.nodes[name] = id;
@@ -268,98 +356,124 @@ private:
     return names.size() > 1u;
   }
 
-  std::optional<search_result_range_t> find_it(
-    const qualified_names_t& names) const
+  // Returns id of a child of the base node that corresponds to the given
+  // node of this finder.
+  node_id_t find_base_child(node_id_t id, const token_t& name) const
   {
-    if (is_qualified_name(names)) {
-      return find_qualified(names);
-    } else {
-      const auto name = names.front().name;
-      return find(name);
+    if (id == k_bad_id) {
+      return k_bad_id;
     }
+
+    return find_child(m_base, nodes_container()[id].base_id, name);
   }
 
-  std::optional<node_id_and_name> find_node(
+  static node_id_t find_child(const qualified_entries_finder* finder,
+                              node_id_t id, const token_t& name)
+  {
+    if (finder == nullptr || id == k_bad_id) {
+      return k_bad_id;
+    }
+
+    const auto& nodes = finder->nodes_container()[id].nodes;
+    const auto found = nodes.find(name);
+    return found != std::cend(nodes) ? found->second : k_bad_id;
+  }
+
+  std::optional<found_node> find_node(
     qualified_names_t::const_iterator begin,
     qualified_names_t::const_iterator end) const
   {
     const auto& first_name = begin->name;
     auto* node = &current_node();
+    std::optional<found_node> found;
 
     const auto is_explicit_root_node_accessed = first_name.str().empty();
     if (is_explicit_root_node_accessed) {
-      node = &m_nodes_container[0];
+      const auto& root = nodes_container()[0];
+      found = found_node{ root.name, root.id, root.base_id };
     } else {
       while (true) {
-        const auto found = node->nodes.find(first_name);
-        if (found != std::cend(node->nodes)) {
-          const auto id = found->second;
-          node = &m_nodes_container[id];
+        const auto id = find_child(this, node->id, first_name);
+        const auto base_id = find_child(m_base, node->base_id, first_name);
+        if (id != k_bad_id || base_id != k_bad_id) {
+          found = found_node{ first_name, id, base_id };
           break;
         }
 
         const auto is_root_node = (node->id == 0u);
         if (is_root_node) {
-          node = nullptr;
           break;
         }
 
-        node = &m_nodes_container[node->parent_id];
+        node = &nodes_container()[node->parent_id];
       }
     }
 
-    if (node == nullptr) {
+    if (!found) {
       return std::nullopt;
     }
 
     auto first = std::next(begin);
     while (first != end) {
-      if (!contains(node->nodes, first->name)) {
+      found->id = find_child(this, found->id, first->name);
+      found->base_id = find_child(m_base, found->base_id, first->name);
+      if (found->id == k_bad_id && found->base_id == k_bad_id) {
         return std::nullopt;
       }
 
-      const auto next_node_id = node->nodes.at(first->name);
-      node = &m_nodes_container[next_node_id];
       ++first;
     }
 
-    return node_id_and_name{ node->name, node->id };
+    // Prefer registration token of the base node. It's the one that has been
+    // registered first.
+    found->name = found->base_id != k_bad_id
+      ? m_base->nodes_container()[found->base_id].name
+      : nodes_container()[found->id].name;
+
+    return found;
   }
 
-  std::optional<search_result_range_t> find_qualified(
-    const qualified_names_t& names) const
+  std::vector<entry_info> find_qualified(const qualified_names_t& names) const
   {
     const auto found_ctx =
       find_node(std::cbegin(names), std::prev(std::cend(names)));
     if (!found_ctx) {
-      return std::nullopt;
+      return {};
     }
 
-    const auto node = &m_nodes_container[found_ctx->id];
     const auto looked_identifier_name = names.back().name;
-
-    return find_in_node(looked_identifier_name, node->entries);
+    return find_in_node(looked_identifier_name, found_ctx->id,
+                        found_ctx->base_id);
   }
 
-  std::optional<search_result_range_t> find_in_node(
-    const token_t& name, const entries_map_t& ids) const
+  // Finds entries in a node of this finder and in the corresponding node of
+  // the base one.
+  std::vector<entry_info> find_in_node(const token_t& name, node_id_t id,
+                                       node_id_t base_id) const
   {
-    const auto found = ids.equal_range(name);
-    if (found.first == std::cend(ids)) {
-      return std::nullopt;
+    std::vector<entry_info> results;
+
+    if (id != k_bad_id) {
+      const auto& entries = nodes_container()[id].entries;
+      append_entries_info(entries.equal_range(name), results);
     }
 
-    return found;
+    if (m_base != nullptr && base_id != k_bad_id) {
+      const auto& entries = m_base->nodes_container()[base_id].entries;
+      append_entries_info(entries.equal_range(name), results);
+    }
+
+    return results;
   }
 
-  std::optional<search_result_range_t> find(const token_t& name) const
+  std::vector<entry_info> find(const token_t& name) const
   {
     // Try to find in local nodes.
     for (auto node_it = std::crbegin(m_local_nodes);
          node_it != std::crend(m_local_nodes); ++node_it) {
-      const auto found = find_in_node(name, *node_it);
-      if (found) {
-        return *found;
+      const auto found = node_it->equal_range(name);
+      if (found.first != found.second) {
+        return to_entries_info(found);
       }
     }
 
@@ -367,17 +481,17 @@ private:
     auto* current = &current_node();
 
     while (true) {
-      const auto found = find_in_node(name, current->entries);
-      if (found) {
-        return *found;
+      auto found = find_in_node(name, current->id, current->base_id);
+      if (!found.empty()) {
+        return found;
       }
 
       const auto is_root_ctx = (current->id == 0u);
       if (is_root_ctx) {
-        return std::nullopt;
+        return {};
       }
 
-      current = &m_nodes_container[current->parent_id];
+      current = &nodes_container()[current->parent_id];
     }
   }
 
@@ -400,7 +514,12 @@ private:
   }
 
 private:
-  std::vector<tree_node> m_nodes_container;
+  // Finder with entries that are visible in this one too.
+  const qualified_entries_finder* m_base{ nullptr };
+  // Copy-on-write, so copying a finder doesn't copy its entries.
+  std::shared_ptr<nodes_container_t> m_nodes_container{
+    std::make_shared<nodes_container_t>()
+  };
   std::vector<node_id_and_name> m_current_nodes_path;
   std::vector<entries_map_t> m_local_nodes;
 };
@@ -22,9 +22,15 @@ sema_builder::sema_builder(
 {
 }
 
+void sema_builder::enable_constant_folding()
+{
+  m_fold_constants = true;
+}
+
 std::unique_ptr<sema_node> sema_builder::build(const ast::ast_node& ast_tree)
 {
   parsing_context parsing_ctx{};
+  parsing_ctx.fold_constants = m_fold_constants;
 
   auto members = sema_builder_ast_visitor_members{ m_ctx, // generic types ctx
                                                    m_ctx, // global ctx
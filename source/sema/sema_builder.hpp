@@ -34,6 +34,11 @@ public:
     const builtin_token_provider& builtin_token_provider,
     builtin_types_accessor builtin_types);
 
+  // Operators with literal operands are replaced with literals of their
+  // results. Off by default, because tools need the operators to map the tree
+  // back to the source.
+  void enable_constant_folding();
+
   std::unique_ptr<sema_node> build(const ast::ast_node& ast_tree);
 
 private:
@@ -45,6 +50,7 @@ private:
   import_handler& m_imports_handler;
   const builtin_token_provider& m_builtin_token_provider;
   builtin_types_accessor m_builtin_types;
+  bool m_fold_constants{ false };
 };
 }
 }
@@ -31,6 +31,7 @@
 #include "sema/factories_provider.hpp"
 #include "sema/failed_initialization_errors_reporters.hpp"
 #include "sema/functions_context.hpp"
+#include "sema/fundamental_value.hpp"
 #include "sema/identifiers_context.hpp"
 #include "sema/identifiers_index_provider.hpp"
 #include "sema/import_handler.hpp"
@@ -57,6 +58,7 @@ sema_builder_ast_visitor::sema_builder_ast_visitor(
 void sema_builder_ast_visitor::visit(const ast::block_node& node)
 {
   auto ig = m_.qualified_ctxs.local_ids_guard();
+  local_slots_guard slots_guard{ m_.parsing_ctx.function_parsing_ctx };
   std::vector<std::unique_ptr<sema_node>> nodes;
 
   for (const auto& n : node.nodes()) {
@@ -117,22 +119,28 @@ void sema_builder_ast_visitor::visit(const ast::class_node& node)
 
   for (auto function_declaration : members->functions) {
     auto function_params_guard = m_.qualified_ctxs.local_ids_guard();
-    for (const auto& param_decl :
-         function_declaration.fun->signature().params) {
+    const auto& params = function_declaration.fun->signature().params;
+    for (auto i = 0u; i < params.size(); ++i) {
       m_.qualified_ctxs.ids.register_identifier(
-        param_decl.name, { param_decl.ty, param_decl.index },
+        params[i].name,
+        { params[i].ty, params[i].index, i, identifier_storage::local },
         /*exported=*/false);
     }
 
-    m_.parsing_ctx.function_parsing_ctx.function = function_declaration.fun;
-    m_.parsing_ctx.function_parsing_ctx.return_nodes.clear();
+    auto& function_parsing_ctx = m_.parsing_ctx.function_parsing_ctx;
+    function_parsing_ctx.function = function_declaration.fun;
+    function_parsing_ctx.return_nodes.clear();
+    function_parsing_ctx.start_locals(static_cast<unsigned>(params.size()));
     auto body = visit_child_node<block_node>(
       function_declaration.body_to_visit, class_context);
-    m_.parsing_ctx.function_parsing_ctx.function = nullptr;
+    function_parsing_ctx.function = nullptr;
     if (!body) {
       return;
     }
 
+    function_declaration.fun->set_locals_count(
+      function_parsing_ctx.locals_count);
+
     add_implicit_return_node_if_need(*body);
 
     if (function_declaration.should_deduce_return_type) {
@@ -150,7 +158,7 @@ void sema_builder_ast_visitor::visit(const ast::class_node& node)
       std::move(body)));
   }
 
-  add_user_type_default_methods(class_type, class_context);
+  add_user_type_default_methods(m_.factories, class_type, class_context);
 
   m_result_node = std::make_unique<class_node>(
     node, name, std::move(members->declarations), std::move(functions));
@@ -224,12 +232,21 @@ void sema_builder_ast_visitor::visit(const ast::binary_operator_node& node)
     return;
   }
 
-  overload_resolution over_resolution{ m_.errors_observer, op };
+  overload_resolution over_resolution{ m_.errors_observer, op,
+                                       &m_.parsing_ctx.overload_resolutions };
   const auto chosen_function = over_resolution.choose(lookup_result, *rhs);
   if (!chosen_function) {
     return;
   }
 
+  if (m_.parsing_ctx.fold_constants) {
+    if (auto folded =
+          fold_constant_operator(node, *chosen_function, *lhs, *rhs)) {
+      m_result_node = std::move(folded);
+      return;
+    }
+  }
+
   m_result_node = std::make_unique<binary_operator_node>(
     node, std::move(lhs), node.operator_(), *chosen_function, std::move(rhs),
     chosen_function->return_type());
@@ -267,7 +284,8 @@ std::unique_ptr<expression_node> sema_builder_ast_visitor::build_function_call(
   const auto function_lookup_result = node.is_generic_type_constructor_call()
     ? find_generict_type_constructor_functions(node.generic_type_name())
     : find_functions(node.names());
-  overload_resolution over_resolution{ m_.errors_observer, node.name() };
+  overload_resolution over_resolution{ m_.errors_observer, node.name(),
+                                       &m_.parsing_ctx.overload_resolutions };
   const auto chosen_function =
     over_resolution.choose(function_lookup_result, *params);
   if (!chosen_function) {
@@ -308,8 +326,9 @@ std::unique_ptr<expression_node> sema_builder_ast_visitor::build_function_call(
     } break;
     case sema_context::context_type::class_: {
       const auto& name = chosen_function->return_type().name();
-      const auto& function_name =
-        name.is_generic() ? name.primary_name_token().str() : name.to_string();
+      const auto function_name = name.is_generic()
+        ? std::string{ name.primary_name_token().str() }
+        : name.to_string();
       const auto is_constructor =
         chosen_function->signature().name.str() == function_name;
 
@@ -406,7 +425,8 @@ void sema_builder_ast_visitor::visit(
   }
 
   const auto member_functions = lhs->type().find_member_function(name);
-  overload_resolution over_resolution{ m_.errors_observer, node.name() };
+  overload_resolution over_resolution{ m_.errors_observer, node.name(),
+                                       &m_.parsing_ctx.overload_resolutions };
   const auto chosen_function =
     over_resolution.choose(member_functions, *params);
   if (!chosen_function) {
@@ -471,7 +491,8 @@ void sema_builder_ast_visitor::visit(const ast::id_node& node)
 
   if (const auto info = m_.qualified_ctxs.ids.info_of(names)) {
     m_result_node =
-      std::make_unique<id_node>(node, info->type, names, info->index);
+      std::make_unique<id_node>(node, info->type, names, info->index,
+                                info->slot, info->storage);
     return;
   } else if (const auto enum_info = m_.qualified_ctxs.enums.info_of(names)) {
     m_result_node = std::make_unique<enum_constant_access_node>(
@@ -554,12 +575,17 @@ void sema_builder_ast_visitor::visit(const ast::user_function_node& node)
     }
 
     const auto identifier_index = identifiers_index_provider::get_next();
+    const auto slot = static_cast<unsigned>(params.size());
     params.emplace_back(
       param_decl_t{ *param_type, param_decl.name, identifier_index });
     m_.qualified_ctxs.ids.register_identifier(
-      param_decl.name, { *param_type, identifier_index }, /*exported=*/false);
+      param_decl.name,
+      { *param_type, identifier_index, slot, identifier_storage::local },
+      /*exported=*/false);
   }
 
+  const auto params_count = static_cast<unsigned>(params.size());
+
   // Todo: add test for function redefinition.
   function_signature signature{ node.name(), std::move(params) };
   if (raise_error_if_function_redefined(signature)) {
@@ -578,14 +604,18 @@ void sema_builder_ast_visitor::visit(const ast::user_function_node& node)
   // Store pointer to function that is currently parsed,
   // so function body will be able to figure out function return type
   // and make casted return expression nodes as needed.
-  m_.parsing_ctx.function_parsing_ctx.function = &function;
-  m_.parsing_ctx.function_parsing_ctx.return_nodes.clear();
+  auto& function_parsing_ctx = m_.parsing_ctx.function_parsing_ctx;
+  function_parsing_ctx.function = &function;
+  function_parsing_ctx.return_nodes.clear();
+  function_parsing_ctx.start_locals(params_count);
   auto block = visit_child_node<block_node>(node.body());
-  m_.parsing_ctx.function_parsing_ctx.function = nullptr;
+  function_parsing_ctx.function = nullptr;
   if (!block) {
     return;
   }
 
+  function.set_locals_count(function_parsing_ctx.locals_count);
+
   if (should_deduce_return_type) {
     return_type = try_deduce_currently_parsed_function_return_type();
     if (!return_type) {
@@ -831,7 +861,9 @@ sema_builder_ast_visitor::get_function_declaration_and_add_to_ctx(
                                                param_identifier_index });
     const auto idenfitied_context = identifiers_index_provider::get_next();
     m_.qualified_ctxs.ids.register_identifier(
-      param_decl.name, { *param_type, idenfitied_context },
+      param_decl.name,
+      { *param_type, idenfitied_context, std::nullopt,
+        identifier_storage::local },
       /*exported=*/false);
   }
 
@@ -856,6 +888,7 @@ sema_builder_ast_visitor::collect_class_members_and_add_functions_to_ctx(
   const ast::class_node& node, sema_context_impl& class_context)
 {
   class_members members;
+  class_members_guard members_guard{ m_.parsing_ctx };
 
   for (const auto& n : node.nodes()) {
     if (auto variable_decl =
@@ -890,9 +923,7 @@ lexer::token sema_builder_ast_visitor::make_token(lexer::token_type token_type,
                                                   const char (&tok)[N])
 {
   // N counts also '\0'
-  const auto src_range = source_range{ source_location{ 1u, 1u, 0u },
-                                       source_location{ 1u, N, N - 1u } };
-  return lexer::token{ token_type, src_range, source_view{ tok } };
+  return lexer::token{ token_type, source_view{ tok }, 0u, N - 1u };
 }
 
 std::unique_ptr<expression_node>
@@ -1198,15 +1229,24 @@ void sema_builder_ast_visitor::visit(
 
   const auto identifier_index = identifiers_index_provider::get_next();
   const auto is_exported = node.export_().has_value();
+  auto& function_parsing_ctx = m_.parsing_ctx.function_parsing_ctx;
+  const auto slot = function_parsing_ctx.function != nullptr
+    ? std::optional<unsigned>{ function_parsing_ctx.allocate_local_slot() }
+    : std::nullopt;
+  const auto storage = slot ? identifier_storage::local
+    : m_.parsing_ctx.parsing_class_members ? identifier_storage::member
+                                           : identifier_storage::global;
   m_.qualified_ctxs.ids.register_identifier(
-    node.name(), { *type, identifier_index }, is_exported);
+    node.name(), { *type, identifier_index, slot, storage }, is_exported);
   m_result_node = std::make_unique<variable_declaration_node>(
-    node, *type, node.name(), std::move(initialization), identifier_index);
+    node, *type, node.name(), std::move(initialization), identifier_index,
+    slot);
 }
 
 void sema_builder_ast_visitor::visit(const ast::for_node& node)
 {
   auto guard = m_.qualified_ctxs.local_ids_guard();
+  local_slots_guard slots_guard{ m_.parsing_ctx.function_parsing_ctx };
 
   std::unique_ptr<sema_node> init;
   if (node.init()) {
@@ -1431,12 +1471,21 @@ void sema_builder_ast_visitor::visit(const ast::unary_operator& node)
 
   const auto found_functions =
     expression->type().context().find_function_in_this_scope(node.operator_());
-  overload_resolution resolution{ m_.errors_observer, node.operator_() };
+  overload_resolution resolution{ m_.errors_observer, node.operator_(),
+                                  &m_.parsing_ctx.overload_resolutions };
   const auto chosen_function = resolution.choose(found_functions);
   if (!chosen_function) {
     return;
   }
 
+  if (m_.parsing_ctx.fold_constants) {
+    if (auto folded =
+          fold_constant_operator(node, *chosen_function, *expression)) {
+      m_result_node = std::move(folded);
+      return;
+    }
+  }
+
   m_result_node = std::make_unique<unary_operator_node>(
     node, node.operator_(), std::move(expression), *chosen_function);
 }
@@ -1498,32 +1547,6 @@ const sema_type& sema_builder_ast_visitor::create_enum_type(
   return creator.create(node.name(), node.enumerators());
 }
 
-void sema_builder_ast_visitor::add_user_type_default_methods(
-  const sema_type& class_ty, sema_context& class_ctx)
-{
-  const auto& class_ref_ty = *class_ctx.find_reference_for(class_ty);
-
-  const auto dummy_param_name_token =
-    lexer::make_token(lexer::token_type::identifier, "");
-
-  auto functions = {
-    type_builder::builtin_function_info{
-      // operator=(val)
-      class_ref_ty,
-      function_signature{
-        lexer::make_token(lexer::token_type::identifier, "="),
-        { parameter_declaration{ class_ref_ty, dummy_param_name_token,
-                                 identifiers_index_provider::get_next() } } },
-      builtin_function_kind::user_type_operator_equal },
-  };
-
-  for (auto& f : functions) {
-    const auto& function = m_.factories.function_factory().create_builtin(
-      class_ctx, f.return_type, std::move(f.signature), f.kind);
-    class_ctx.add_function(function);
-  }
-}
-
 void sema_builder_ast_visitor::visit(const ast::import_node& node)
 {
   const auto file_path_view = node.file_path().str();
@@ -2,6 +2,7 @@
 
 #include "ast/ast_node_visitor.hpp"
 #include "sema/builtin_types_accessor.hpp"
+#include "sema/overload_resolution_cache.hpp"
 #include "sema/qualified_contextes_refs.hpp"
 #include "sema/sema_context.hpp"
 #include "sema/sema_node.hpp"
@@ -9,6 +10,7 @@
 
 #include <optional>
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -50,19 +52,76 @@ struct function_parsing_context
   ast::user_function_node* function_node{ nullptr };
   sema_function* function{ nullptr };
   std::vector<const return_node*> return_nodes;
+  // Frame slots of the currently parsed function. Parameters occupy the first
+  // slots. Slots of a scope are released when the scope ends, so variables of
+  // sibling scopes share them.
+  unsigned next_local_slot{ 0u };
+  unsigned locals_count{ 0u };
 
   void reset()
   {
     function_node = nullptr;
     function = nullptr;
     return_nodes.clear();
+    next_local_slot = 0u;
+    locals_count = 0u;
+  }
+
+  void start_locals(unsigned params_count)
+  {
+    next_local_slot = params_count;
+    locals_count = params_count;
+  }
+
+  unsigned allocate_local_slot()
+  {
+    const auto slot = next_local_slot++;
+    locals_count = std::max(locals_count, next_local_slot);
+    return slot;
   }
 };
 
+class local_slots_guard
+{
+public:
+  explicit local_slots_guard(function_parsing_context& ctx)
+    : m_ctx{ ctx }
+    , m_next_local_slot{ ctx.next_local_slot }
+  {
+  }
+
+  ~local_slots_guard() { m_ctx.next_local_slot = m_next_local_slot; }
+
+private:
+  function_parsing_context& m_ctx;
+  const unsigned m_next_local_slot;
+};
+
 struct parsing_context
 {
   function_parsing_context function_parsing_ctx;
   unsigned loop_parsing_counter{ 0u };
+  // Variables declared while set are members of a class.
+  bool parsing_class_members{ false };
+  bool fold_constants{ false };
+  overload_resolution_cache overload_resolutions;
+};
+
+class class_members_guard
+{
+public:
+  explicit class_members_guard(parsing_context& ctx)
+    : m_ctx{ ctx }
+    , m_previous{ ctx.parsing_class_members }
+  {
+    m_ctx.parsing_class_members = true;
+  }
+
+  ~class_members_guard() { m_ctx.parsing_class_members = m_previous; }
+
+private:
+  parsing_context& m_ctx;
+  const bool m_previous;
 };
 
 struct sema_builder_ast_visitor_members
@@ -208,9 +267,6 @@ private:
 
   bool is_inside_loop() const;
 
-  void add_user_type_default_methods(const sema_type& class_ty,
-                                     sema_context& class_ctx);
-
   bool is_export_allowed() const;
 
 public:
@@ -17,11 +17,21 @@ sema_context_impl::sema_context_impl(std::string name,
 void sema_context_impl::add_function(const sema_function& function)
 {
   m_functions.push_back(&function);
+  m_functions_by_name[function.signature().name.str()].emplace_back(
+    &function);
 }
 
 void sema_context_impl::add_type(const sema_type& type)
 {
   m_types.emplace_back(&type);
+
+  const auto& name = type.name();
+  m_types_by_id.emplace(name.id(), &type);
+  m_types_by_id_without_reference.emplace(name.id_without_reference(),
+                                          &type);
+  if (type.is_reference()) {
+    m_references_by_id.emplace(type.referenced_type().name().id(), &type);
+  }
 }
 
 const sema_type* sema_context_impl::find_type(
@@ -41,14 +51,10 @@ const sema_type* sema_context_impl::find_referenced_type(
     return nullptr;
   }
 
-  // Todo: optimize creation of string out.
-  const auto pred = [referenced_type_name =
-                       name.to_string_without_reference()](const auto& type) {
-    return referenced_type_name == type->name().to_string_without_reference();
-  };
-
-  if (auto found = find_type_in_this_scope_with_predicate(pred)) {
-    return found;
+  const auto found =
+    m_types_by_id_without_reference.find(name.id_without_reference());
+  if (found != std::cend(m_types_by_id_without_reference)) {
+    return found->second;
   }
 
   return m_parent ? m_parent->find_referenced_type(name) : nullptr;
@@ -57,9 +63,8 @@ const sema_type* sema_context_impl::find_referenced_type(
 const sema_type* sema_context_impl::find_type_in_this_scope(
   const ast::type_representation& name) const
 {
-  const auto pred = [&name](const auto& type) { return name == type->name(); };
-
-  return find_type_in_this_scope_with_predicate(pred);
+  const auto found = m_types_by_id.find(name.id());
+  return found != std::cend(m_types_by_id) ? found->second : nullptr;
 }
 
 function_lookup_result_t sema_context_impl::find_function(
@@ -80,14 +85,15 @@ function_lookup_result_t sema_context_impl::find_function(
 single_scope_function_lookup_result_t
 sema_context_impl::find_function_in_this_scope(const lexer::token& name) const
 {
+  create_lazy_functions();
+
   single_scope_function_lookup_result_t result;
 
   // Collect functions.
-  const auto pred = [name](const auto& function) {
-    return name.str() == function->signature().name.str();
-  };
-  std::copy_if(std::cbegin(m_functions), std::cend(m_functions),
-               std::back_inserter(result), pred);
+  const auto found = m_functions_by_name.find(name.str());
+  if (found != std::cend(m_functions_by_name)) {
+    result = found->second;
+  }
 
   // Collect constructors.
   // Todo: test ctors collecting.
@@ -103,27 +109,35 @@ sema_context_impl::find_function_in_this_scope(const lexer::token& name) const
   return result;
 }
 
-sema_context::context_type sema_context_impl::type() const
+void sema_context_impl::add_functions_lazily(std::function<void()> creator)
 {
-  return m_context_type;
+  m_lazy_functions_creator = std::move(creator);
 }
 
-template <typename Predicate>
-const sema_type* sema_context_impl::find_type_in_this_scope_with_predicate(
-  Predicate&& pred) const
+void sema_context_impl::create_lazy_functions() const
 {
-  const auto found =
-    std::find_if(std::cbegin(m_types), std::cend(m_types), pred);
-  return found != std::cend(m_types) ? *found : nullptr;
+  if (!m_lazy_functions_creator) {
+    return;
+  }
+
+  // The creator adds functions to this context, so it's reset before it's
+  // called.
+  const auto creator = std::move(m_lazy_functions_creator);
+  m_lazy_functions_creator = nullptr;
+  creator();
+}
+
+sema_context::context_type sema_context_impl::type() const
+{
+  return m_context_type;
 }
 
 const sema_type* sema_context_impl::find_reference_for(
   const sema_type& type) const
 {
-  for (const auto& t : m_types) {
-    if (t->is_reference() && t->referenced_type() == type) {
-      return t;
-    }
+  const auto found = m_references_by_id.find(type.name().id());
+  if (found != std::cend(m_references_by_id)) {
+    return found->second;
   }
 
   return m_parent ? m_parent->find_reference_for(type) : nullptr;
@@ -159,11 +173,15 @@ const sema_context* sema_context_impl::find_ctx_containing_type(
   //    return this;
   //  }
 
+  for (; m_fully_qualified_indexed_count < m_types.size();
+       ++m_fully_qualified_indexed_count) {
+    const auto ty = m_types[m_fully_qualified_indexed_count];
+    m_types_fully_qualified_names.emplace(ty->fully_qualified_name());
+  }
+
   const auto fully_qualified_type_name = fully_qualified_name() + "::" + name;
-  for (const auto ty : m_types) {
-    if (ty->fully_qualified_name() == fully_qualified_type_name) {
-      return this;
-    }
+  if (m_types_fully_qualified_names.count(fully_qualified_type_name) != 0u) {
+    return this;
   }
 
   if (m_parent) {
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "common/string.hpp"
 #include "sema/sema_context.hpp"
 
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace cmsl::sema {
 class sema_context_impl : public sema_context
 {
@@ -32,20 +37,48 @@ public:
 
   const sema_context* parent() const override { return m_parent; }
 
+  // Functions added by the creator are added on the first function lookup
+  // in this context. Builtin generic types have dozens of member functions,
+  // and a script usually uses just a few of them, if any. Apart from the
+  // on-demand index of fully qualified names, it's the only way a context of
+  // a builtin type changes once builtin qualified contexts are shared by
+  // overlays.
+  void add_functions_lazily(std::function<void()> creator);
+
 private:
-  template <typename Predicate>
-  const sema_type* find_type_in_this_scope_with_predicate(
-    Predicate&& pred) const;
+  using types_by_id_t =
+    std::unordered_map<lexer::symbol_t, const sema_type*>;
 
   const sema_context* find_ctx_containing_type(
     const std::string& name) const override;
 
   const sema_context* find_root() const;
 
+  void create_lazy_functions() const;
+
 private:
   const sema_context* m_parent;
   std::vector<const sema_function*> m_functions;
   std::vector<const sema_type*> m_types;
+
+  // Indexes of the functions and types, updated as they are added. Builtin
+  // types have dozens of member functions, so lookups by name must not scan
+  // all of them. When names collide, the first added function or type is
+  // the one found, like in case of a scan. Types are indexed by canonical
+  // ids of their names.
+  string_view_map<std::vector<const sema_function*>> m_functions_by_name;
+  types_by_id_t m_types_by_id;
+  types_by_id_t m_types_by_id_without_reference;
+  // Reference types, by ids of the referenced types.
+  types_by_id_t m_references_by_id;
+
+  // Fully qualified names of the types. Indexed on demand, because getting
+  // such name walks through all the parent contexts.
+  mutable std::unordered_set<std::string> m_types_fully_qualified_names;
+  mutable std::size_t m_fully_qualified_indexed_count{ 0u };
+
+  mutable std::function<void()> m_lazy_functions_creator;
+
   context_type m_context_type;
   std::string m_name;
 };
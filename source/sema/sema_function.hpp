@@ -6,13 +6,31 @@
 namespace cmsl::sema {
 class sema_context;
 
+enum class sema_function_kind
+{
+  user,
+  builtin
+};
+
 class sema_function
 {
 public:
+  explicit sema_function(sema_function_kind function_kind)
+    : m_function_kind{ function_kind }
+  {
+  }
+
   virtual ~sema_function() = default;
   virtual const function_signature& signature() const = 0;
   virtual const sema_type& return_type() const = 0;
   virtual const sema_type* try_return_type() const = 0;
   virtual const sema_context& context() const = 0;
+
+  // Allows executors to pick the proper function implementation without
+  // casting the function in every call.
+  sema_function_kind function_kind() const { return m_function_kind; }
+
+private:
+  sema_function_kind m_function_kind;
 };
 }
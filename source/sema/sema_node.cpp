@@ -1,27 +1,41 @@
 #include "sema/sema_node.hpp"
 
 #include "ast/ast_node.hpp"
+#include "common/assert.hpp"
 #include "sema_node.hpp"
 
 namespace cmsl::sema {
-sema::sema_node::sema_node(const ast::ast_node& ast_node)
-  : m_ast_node{ ast_node }
+sema_node_origin::sema_node_origin(const ast::ast_node& ast_node)
+  : m_ast_node{ &ast_node }
+  , m_src_range{ ast_node.src_range() }
+{
+}
+
+sema_node_origin::sema_node_origin(const source_range& src_range)
+  : m_src_range{ src_range }
+{
+}
+
+sema::sema_node::sema_node(const sema_node_origin& origin)
+  : m_ast_node{ origin.m_ast_node }
+  , m_src_range{ origin.m_src_range }
 {
 }
 
 source_location sema_node::begin_location() const
 {
-  return m_ast_node.begin_location();
+  return m_src_range.begin;
 }
 
 source_location sema_node::end_location() const
 {
-  return m_ast_node.end_location();
+  return m_src_range.end;
 }
 
 const ast::ast_node& sema_node::ast_node() const
 {
-  return m_ast_node;
+  CMSL_ASSERT_MSG(m_ast_node != nullptr, "Sema node has no AST node");
+  return *m_ast_node;
 }
 
 void sema_node::set_parent(const sema_node& node, passkey)
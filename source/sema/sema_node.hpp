@@ -1,8 +1,9 @@
 #pragma once
 
-namespace cmsl {
-struct source_location;
+#include "common/nodes_arena.hpp"
+#include "common/source_location.hpp"
 
+namespace cmsl {
 namespace ast {
 class ast_node;
 }
@@ -10,6 +11,22 @@ class ast_node;
 namespace sema {
 class sema_node_visitor;
 
+// What a sema node has been created from. Nodes built by sema refer to their
+// AST node. Nodes loaded from a cached sema tree have been created without
+// parsing the source, so they know only their source range.
+class sema_node_origin
+{
+public:
+  sema_node_origin(const ast::ast_node& ast_node);
+  explicit sema_node_origin(const source_range& src_range);
+
+private:
+  friend class sema_node;
+
+  const ast::ast_node* m_ast_node{ nullptr };
+  source_range m_src_range;
+};
+
 class sema_node
 {
 protected:
@@ -18,20 +35,35 @@ protected:
   };
 
 public:
-  explicit sema_node(const ast::ast_node& ast_node);
+  explicit sema_node(const sema_node_origin& origin);
 
   virtual ~sema_node() = default;
 
+  // Nodes are allocated in the current nodes_arena, if there is one.
+  static void* operator new(std::size_t size)
+  {
+    return nodes_arena::allocate_node(size);
+  }
+  static void operator delete(void* node)
+  {
+    nodes_arena::deallocate_node(node);
+  }
+
   virtual void visit(sema_node_visitor& visitor) const = 0;
   virtual source_location begin_location() const;
   virtual source_location end_location() const;
+  // The AST can be released after semantic analysis, e.g. compiled_source
+  // doesn't keep it, so this can be used only while the AST is alive. Nodes
+  // loaded from a cached sema tree have no AST node at all.
   const ast::ast_node& ast_node() const;
   const sema_node* parent() const;
   void set_parent(const sema_node& node, passkey);
 
 private:
-  const ast::ast_node& m_ast_node;
+  const ast::ast_node* m_ast_node;
   const sema_node* m_parent{ nullptr };
+  // Copied from the AST node, so that locations outlive the AST.
+  source_range m_src_range;
 };
 }
 }
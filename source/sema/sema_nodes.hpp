@@ -5,12 +5,14 @@
 #include "ast/qualified_name.hpp"
 #include "common/int_alias.hpp"
 #include "lexer/token.hpp"
+#include "sema/identifier_info.hpp"
 #include "sema/sema_function.hpp"
 #include "sema/sema_node.hpp"
 #include "sema/sema_node_visitor.hpp"
 #include "sema/sema_type.hpp"
 
 #include <memory>
+#include <optional>
 
 #define VISIT_METHOD                                                          \
   void visit(sema_node_visitor& visitor) const override                       \
@@ -34,8 +36,9 @@ template <typename T>
 class value_node : public expression_node
 {
 public:
-  explicit value_node(const ast::ast_node& ast_node, const sema_type& t, T val)
-    : expression_node{ ast_node }
+  explicit value_node(const sema_node_origin& origin, const sema_type& t,
+                      T val)
+    : expression_node{ origin }
     , m_type{ t }
     , m_value{ val }
   {
@@ -55,9 +58,9 @@ private:
 class bool_value_node : public value_node<bool>
 {
 public:
-  explicit bool_value_node(const ast::ast_node& ast_node, const sema_type& t,
+  explicit bool_value_node(const sema_node_origin& origin, const sema_type& t,
                            bool val)
-    : value_node{ ast_node, t, val }
+    : value_node{ origin, t, val }
   {
   }
 
@@ -67,9 +70,9 @@ public:
 class int_value_node : public value_node<int_t>
 {
 public:
-  explicit int_value_node(const ast::ast_node& ast_node, const sema_type& t,
+  explicit int_value_node(const sema_node_origin& origin, const sema_type& t,
                           int_t val)
-    : value_node{ ast_node, t, val }
+    : value_node{ origin, t, val }
   {
   }
 
@@ -79,9 +82,9 @@ public:
 class double_value_node : public value_node<double>
 {
 public:
-  explicit double_value_node(const ast::ast_node& ast_node, const sema_type& t,
-                             double val)
-    : value_node{ ast_node, t, val }
+  explicit double_value_node(const sema_node_origin& origin,
+                             const sema_type& t, double val)
+    : value_node{ origin, t, val }
   {
   }
 
@@ -91,9 +94,9 @@ public:
 class string_value_node : public value_node<cmsl::string_view>
 {
 public:
-  explicit string_value_node(const ast::ast_node& ast_node, const sema_type& t,
-                             cmsl::string_view val)
-    : value_node{ ast_node, t, val }
+  explicit string_value_node(const sema_node_origin& origin,
+                             const sema_type& t, cmsl::string_view val)
+    : value_node{ origin, t, val }
   {
   }
 
@@ -103,13 +106,17 @@ public:
 class id_node : public expression_node
 {
 public:
-  explicit id_node(const ast::ast_node& ast_node, const sema_type& t,
-                   std::vector<ast::name_with_coloncolon> names,
-                   unsigned index)
-    : expression_node{ ast_node }
+  explicit id_node(
+    const sema_node_origin& origin, const sema_type& t,
+    std::vector<ast::name_with_coloncolon> names, unsigned index,
+    std::optional<unsigned> slot = std::nullopt,
+    identifier_storage storage = identifier_storage::unknown)
+    : expression_node{ origin }
     , m_type{ t }
     , m_names{ std::move(names) }
     , m_index{ index }
+    , m_slot{ slot }
+    , m_storage{ storage }
   {
   }
 
@@ -124,22 +131,30 @@ public:
 
   unsigned index() const { return m_index; }
 
+  // Frame slot of a parameter or a local variable, empty for other
+  // identifiers.
+  std::optional<unsigned> slot() const { return m_slot; }
+
+  identifier_storage storage() const { return m_storage; }
+
   VISIT_METHOD
 
 private:
   const sema_type& m_type;
   std::vector<ast::name_with_coloncolon> m_names;
   const unsigned m_index;
+  const std::optional<unsigned> m_slot;
+  const identifier_storage m_storage;
 };
 
 class enum_constant_access_node : public expression_node
 {
 public:
   explicit enum_constant_access_node(
-    const ast::ast_node& ast_node, const sema_type& t,
+    const sema_node_origin& origin, const sema_type& t,
     std::vector<ast::name_with_coloncolon> names, unsigned enum_value,
     unsigned index)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_type{ t }
     , m_names{ std::move(names) }
     , m_value{ enum_value }
@@ -172,9 +187,9 @@ private:
 class return_node : public expression_node
 {
 public:
-  explicit return_node(const ast::ast_node& ast_node,
+  explicit return_node(const sema_node_origin& origin,
                        std::unique_ptr<expression_node> expr)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_expr{ std::move(expr) }
   {
     m_expr->set_parent(*this, passkey{});
@@ -198,13 +213,13 @@ private:
 class binary_operator_node : public expression_node
 {
 public:
-  explicit binary_operator_node(const ast::ast_node& ast_node,
+  explicit binary_operator_node(const sema_node_origin& origin,
                                 std::unique_ptr<expression_node> lhs,
                                 lexer::token op,
                                 const sema_function& operator_function,
                                 std::unique_ptr<expression_node> rhs,
                                 const sema_type& result_type)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_lhs{ std::move(lhs) }
     , m_operator{ op }
     , m_operator_function{ operator_function }
@@ -248,10 +263,12 @@ class variable_declaration_node : public sema_node
 {
 public:
   explicit variable_declaration_node(
-    const ast::ast_node& ast_node, const sema_type& type, lexer::token name,
-    std::unique_ptr<expression_node> initialization, unsigned index)
-    : sema_node{ ast_node }
+    const sema_node_origin& origin, const sema_type& type, lexer::token name,
+    std::unique_ptr<expression_node> initialization, unsigned index,
+    std::optional<unsigned> slot = std::nullopt)
+    : sema_node{ origin }
     , m_index{ index }
+    , m_slot{ slot }
     , m_type{ type }
     , m_name{ name }
     , m_initialization{ std::move(initialization) }
@@ -268,10 +285,15 @@ public:
   const sema_node* initialization() const { return m_initialization.get(); }
   unsigned index() const { return m_index; }
 
+  // Frame slot of a local variable, empty for global variables and class
+  // members.
+  std::optional<unsigned> slot() const { return m_slot; }
+
   VISIT_METHOD
 
 private:
   unsigned m_index;
+  std::optional<unsigned> m_slot;
   const sema_type& m_type;
   const lexer::token m_name;
   std::unique_ptr<expression_node> m_initialization;
@@ -282,10 +304,10 @@ class call_node : public expression_node
 public:
   using param_expressions_t = std::vector<std::unique_ptr<expression_node>>;
 
-  explicit call_node(const ast::ast_node& ast_node,
+  explicit call_node(const sema_node_origin& origin,
                      const sema_function& function, param_expressions_t params,
                      const token_t& call_name)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_function{ function }
     , m_params{ std::move(params) }
     , m_call_name{ call_name }
@@ -319,11 +341,11 @@ private:
 class function_call_node : public call_node
 {
 public:
-  explicit function_call_node(const ast::ast_node& ast_node,
+  explicit function_call_node(const sema_node_origin& origin,
                               const sema_function& function,
                               param_expressions_t params,
                               const token_t& call_name)
-    : call_node{ ast_node, function, std::move(params), call_name }
+    : call_node{ origin, function, std::move(params), call_name }
   {
   }
 
@@ -333,12 +355,12 @@ public:
 class member_function_call_node : public call_node
 {
 public:
-  explicit member_function_call_node(const ast::ast_node& ast_node,
+  explicit member_function_call_node(const sema_node_origin& origin,
                                      std::unique_ptr<expression_node> lhs,
                                      const sema_function& function,
                                      param_expressions_t params,
                                      const token_t& call_name)
-    : call_node{ ast_node, function, std::move(params), call_name }
+    : call_node{ origin, function, std::move(params), call_name }
     , m_lhs{ std::move(lhs) }
   {
     m_lhs->set_parent(*this, passkey{});
@@ -355,11 +377,11 @@ private:
 class implicit_member_function_call_node : public call_node
 {
 public:
-  explicit implicit_member_function_call_node(const ast::ast_node& ast_node,
+  explicit implicit_member_function_call_node(const sema_node_origin& origin,
                                               const sema_function& function,
                                               param_expressions_t params,
                                               const token_t& call_name)
-    : call_node{ ast_node, function, std::move(params), call_name }
+    : call_node{ origin, function, std::move(params), call_name }
   {
   }
 
@@ -369,12 +391,12 @@ public:
 class constructor_call_node : public call_node
 {
 public:
-  explicit constructor_call_node(const ast::ast_node& ast_node,
+  explicit constructor_call_node(const sema_node_origin& origin,
                                  const sema_type& class_type,
                                  const sema_function& function,
                                  param_expressions_t params,
                                  const token_t& call_name)
-    : call_node{ ast_node, function, std::move(params), call_name }
+    : call_node{ origin, function, std::move(params), call_name }
     , m_class_type{ class_type }
   {
   }
@@ -391,11 +413,11 @@ class add_subdirectory_node : public call_node
 {
 public:
   explicit add_subdirectory_node(
-    const ast::ast_node& ast_node,
+    const sema_node_origin& origin,
     std::unique_ptr<string_value_node> directory_name,
     const sema_function& function, param_expressions_t params,
     const token_t& call_name)
-    : call_node{ ast_node, function, std::move(params), call_name }
+    : call_node{ origin, function, std::move(params), call_name }
     , m_directory_name{ std::move(directory_name) }
   {
     m_directory_name->set_parent(*this, passkey{});
@@ -413,10 +435,10 @@ class add_subdirectory_with_old_script_node : public expression_node
 {
 public:
   explicit add_subdirectory_with_old_script_node(
-    const ast::ast_node& ast_node,
+    const sema_node_origin& origin,
     std::unique_ptr<string_value_node> directory_name,
     const sema_type& void_type)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_directory_name{ std::move(directory_name) }
     , m_void_type{ void_type }
   {
@@ -444,8 +466,8 @@ private:
   using nodes_t = std::vector<std::unique_ptr<sema_node>>;
 
 public:
-  explicit block_node(const ast::ast_node& ast_node, nodes_t nodes)
-    : sema_node{ ast_node }
+  explicit block_node(const sema_node_origin& origin, nodes_t nodes)
+    : sema_node{ origin }
     , m_nodes{ std::move(nodes) }
   {
     for (auto& node : m_nodes) {
@@ -466,10 +488,10 @@ private:
 class function_node : public sema_node
 {
 public:
-  explicit function_node(const ast::ast_node& ast_node,
+  explicit function_node(const sema_node_origin& origin,
                          const sema_function& function,
                          std::unique_ptr<block_node> body)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_function{ function }
     , m_body{ std::move(body) }
   {
@@ -501,9 +523,9 @@ private:
   using functions_t = std::vector<std::unique_ptr<function_node>>;
 
 public:
-  explicit class_node(const ast::ast_node& ast_node, lexer::token name,
+  explicit class_node(const sema_node_origin& origin, lexer::token name,
                       members_t members, functions_t functions)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_name{ name }
     , m_members{ std::move(members) }
     , m_functions{ std::move(functions) }
@@ -533,10 +555,10 @@ private:
 class conditional_node : public sema_node
 {
 public:
-  explicit conditional_node(const ast::ast_node& ast_node,
+  explicit conditional_node(const sema_node_origin& origin,
                             std::unique_ptr<expression_node> condition,
                             std::unique_ptr<block_node> body)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_condition{ std::move(condition) }
     , m_body{ std::move(body) }
   {
@@ -558,9 +580,9 @@ private:
 class while_node : public sema_node
 {
 public:
-  explicit while_node(const ast::ast_node& ast_node,
+  explicit while_node(const sema_node_origin& origin,
                       std::unique_ptr<conditional_node> condition)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_conditional{ std::move(condition) }
   {
     m_conditional->set_parent(*this, passkey{});
@@ -571,6 +593,7 @@ public:
     return m_conditional->get_condition();
   }
   const block_node& body() const { return m_conditional->get_body(); }
+  const conditional_node& conditional() const { return *m_conditional; }
 
   VISIT_METHOD
 
@@ -583,9 +606,9 @@ class if_else_node : public sema_node
 public:
   using ifs_t = std::vector<std::unique_ptr<conditional_node>>;
 
-  explicit if_else_node(const ast::ast_node& ast_node, ifs_t ifs,
+  explicit if_else_node(const sema_node_origin& origin, ifs_t ifs,
                         std::unique_ptr<block_node> else_node)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_ifs{ std::move(ifs) }
     , m_else{ std::move(else_node) }
   {
@@ -612,11 +635,11 @@ private:
 class class_member_access_node : public expression_node
 {
 public:
-  explicit class_member_access_node(const ast::ast_node& ast_node,
+  explicit class_member_access_node(const sema_node_origin& origin,
                                     std::unique_ptr<expression_node> lhs,
                                     const token_t& member_access_name,
                                     member_info member_info)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_lhs{ std::move(lhs) }
     , m_member_access_name{ member_access_name }
     , m_member_info{ member_info }
@@ -650,9 +673,9 @@ class translation_unit_node : public sema_node
 public:
   using nodes_t = std::vector<std::unique_ptr<sema_node>>;
 
-  explicit translation_unit_node(const ast::ast_node& ast_node,
+  explicit translation_unit_node(const sema_node_origin& origin,
                                  const sema_context& ctx, nodes_t nodes)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_ctx{ ctx }
     , m_nodes{ std::move(nodes) }
   {
@@ -675,10 +698,10 @@ private:
 class cast_to_reference_node : public expression_node
 {
 public:
-  explicit cast_to_reference_node(const ast::ast_node& ast_node,
+  explicit cast_to_reference_node(const sema_node_origin& origin,
                                   const sema_type& t,
                                   std::unique_ptr<expression_node> expr)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_type{ t }
     , m_expr{ std::move(expr) }
   {
@@ -701,10 +724,10 @@ private:
 class cast_to_value_node : public expression_node
 {
 public:
-  explicit cast_to_value_node(const ast::ast_node& ast_node,
+  explicit cast_to_value_node(const sema_node_origin& origin,
                               const sema_type& t,
                               std::unique_ptr<expression_node> expr)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_type{ t }
     , m_expr{ std::move(expr) }
   {
@@ -728,9 +751,9 @@ class initializer_list_node : public expression_node
 {
 public:
   explicit initializer_list_node(
-    const ast::ast_node& ast_node, const sema_type& t,
+    const sema_node_origin& origin, const sema_type& t,
     std::vector<std::unique_ptr<expression_node>> values)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_type{ t }
     , m_values{ std::move(values) }
   {
@@ -758,9 +781,9 @@ private:
 class implicit_return_node : public expression_node
 {
 public:
-  explicit implicit_return_node(const ast::ast_node& ast_node,
+  explicit implicit_return_node(const sema_node_origin& origin,
                                 const sema_type& type)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_type{ type }
   {
   }
@@ -770,11 +793,7 @@ public:
 
   source_location begin_location() const override
   {
-    return ast_node().end_location();
-  }
-  source_location end_location() const override
-  {
-    return ast_node().end_location();
+    return expression_node::end_location();
   }
 
   VISIT_METHOD
@@ -786,12 +805,12 @@ private:
 class for_node : public sema_node
 {
 public:
-  explicit for_node(const ast::ast_node& ast_node,
+  explicit for_node(const sema_node_origin& origin,
                     std::unique_ptr<sema_node> init,
                     std::unique_ptr<expression_node> condition,
                     std::unique_ptr<expression_node> iteration,
                     std::unique_ptr<block_node> body)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_init{ std::move(init) }
     , m_condition{ std::move(condition) }
     , m_iteration{ std::move(iteration) }
@@ -826,8 +845,8 @@ private:
 class break_node : public sema_node
 {
 public:
-  explicit break_node(const ast::ast_node& ast_node)
-    : sema_node{ ast_node }
+  explicit break_node(const sema_node_origin& origin)
+    : sema_node{ origin }
   {
   }
 
@@ -840,9 +859,9 @@ public:
   using nodes_t = std::vector<std::unique_ptr<sema_node>>;
   using names_t = std::vector<ast::name_with_coloncolon>;
 
-  explicit namespace_node(const ast::ast_node& ast_node, names_t names,
+  explicit namespace_node(const sema_node_origin& origin, names_t names,
                           nodes_t nodes)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_nodes{ std::move(nodes) }
     , m_names{ std::move(names) }
   {
@@ -865,11 +884,11 @@ private:
 class ternary_operator_node : public expression_node
 {
 public:
-  explicit ternary_operator_node(const ast::ast_node& ast_node,
+  explicit ternary_operator_node(const sema_node_origin& origin,
                                  std::unique_ptr<expression_node> condition,
                                  std::unique_ptr<expression_node> true_,
                                  std::unique_ptr<expression_node> false_)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_condition{ std::move(condition) }
     , m_true{ std::move(true_) }
     , m_false{ std::move(false_) }
@@ -910,10 +929,10 @@ public:
 
   using initializers_t = std::vector<initializer>;
 
-  explicit designated_initializers_node(const ast::ast_node& ast_node,
+  explicit designated_initializers_node(const sema_node_origin& origin,
                                         const sema_type& ty,
                                         initializers_t initializers)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_type{ ty }
     , m_initializers{ std::move(initializers) }
   {
@@ -940,10 +959,10 @@ private:
 class unary_operator_node : public expression_node
 {
 public:
-  explicit unary_operator_node(const ast::ast_node& ast_node, token_t op,
+  explicit unary_operator_node(const sema_node_origin& origin, token_t op,
                                std::unique_ptr<expression_node> expression,
                                const sema_function& function)
-    : expression_node{ ast_node }
+    : expression_node{ origin }
     , m_expression{ std::move(expression) }
     , m_function{ function }
   {
@@ -974,9 +993,9 @@ private:
 class enum_node : public sema_node
 {
 public:
-  explicit enum_node(const ast::ast_node& ast_node, lexer::token name,
+  explicit enum_node(const sema_node_origin& origin, lexer::token name,
                      std::vector<lexer::token> enumerators)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_name{ name }
     , m_enumerators{ std::move(enumerators) }
   {
@@ -998,9 +1017,9 @@ private:
 class import_node : public sema_node
 {
 public:
-  explicit import_node(const ast::ast_node& ast_node,
+  explicit import_node(const sema_node_origin& origin,
                        const lexer::token& file_path)
-    : sema_node{ ast_node }
+    : sema_node{ origin }
     , m_file_path{ file_path }
   {
   }
@@ -0,0 +1,132 @@
+#include "sema/sema_tree_format.hpp"
+
+#include <cstring>
+
+namespace cmsl::sema::sema_tree_format {
+namespace {
+// Integers are written in little endian, no matter what the host uses, so
+// that a tree doesn't depend on the machine it has been written on.
+template <typename T>
+void write_le(std::string& out, T value)
+{
+  for (auto i = 0u; i < sizeof(T); ++i) {
+    out.push_back(static_cast<char>((value >> (8u * i)) & 0xffu));
+  }
+}
+
+template <typename T>
+T read_le(const char* data)
+{
+  T value{};
+  for (auto i = 0u; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<unsigned char>(data[i])) << (8u * i);
+  }
+
+  return value;
+}
+}
+
+void output::write_u8(std::uint8_t value)
+{
+  m_data.push_back(static_cast<char>(value));
+}
+
+void output::write_bool(bool value)
+{
+  write_u8(value ? 1u : 0u);
+}
+
+void output::write_u32(std::uint32_t value)
+{
+  write_le(m_data, value);
+}
+
+void output::write_u64(std::uint64_t value)
+{
+  write_le(m_data, value);
+}
+
+void output::write_double(double value)
+{
+  static_assert(sizeof(double) == sizeof(std::uint64_t));
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  write_u64(bits);
+}
+
+void output::write_string(cmsl::string_view value)
+{
+  write_u32(static_cast<std::uint32_t>(value.size()));
+  m_data.append(value.data(), value.size());
+}
+
+std::string output::take()
+{
+  return std::move(m_data);
+}
+
+input::input(cmsl::string_view data)
+  : m_data{ data }
+{
+}
+
+std::uint8_t input::read_u8()
+{
+  const auto data = read_bytes(1u);
+  return data ? static_cast<std::uint8_t>(*data) : 0u;
+}
+
+bool input::read_bool()
+{
+  return read_u8() != 0u;
+}
+
+std::uint32_t input::read_u32()
+{
+  const auto data = read_bytes(sizeof(std::uint32_t));
+  return data ? read_le<std::uint32_t>(data) : 0u;
+}
+
+std::uint64_t input::read_u64()
+{
+  const auto data = read_bytes(sizeof(std::uint64_t));
+  return data ? read_le<std::uint64_t>(data) : 0u;
+}
+
+double input::read_double()
+{
+  const auto bits = read_u64();
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+cmsl::string_view input::read_string()
+{
+  const auto size = read_u32();
+  const auto data = read_bytes(size);
+  return data ? cmsl::string_view{ data, size } : cmsl::string_view{};
+}
+
+bool input::failed() const
+{
+  return m_failed;
+}
+
+bool input::at_end() const
+{
+  return m_position == m_data.size();
+}
+
+const char* input::read_bytes(std::size_t count)
+{
+  if (m_failed || m_data.size() - m_position < count) {
+    m_failed = true;
+    return nullptr;
+  }
+
+  const auto data = m_data.data() + m_position;
+  m_position += count;
+  return data;
+}
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "common/string.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace cmsl::sema::sema_tree_format {
+// Has to be bumped every time the format, the set of sema nodes or the token
+// types change.
+constexpr std::uint32_t k_version = 1u;
+
+enum class node_tag : std::uint8_t
+{
+  add_subdirectory,
+  add_subdirectory_with_old_script,
+  binary_operator,
+  block,
+  bool_value,
+  break_,
+  cast_to_reference,
+  cast_to_value,
+  class_member_access,
+  class_,
+  conditional,
+  constructor_call,
+  designated_initializers,
+  double_value,
+  enum_constant_access,
+  enum_,
+  for_,
+  function_call,
+  function,
+  id,
+  if_else,
+  implicit_member_function_call,
+  implicit_return,
+  import,
+  initializer_list,
+  int_value,
+  member_function_call,
+  namespace_,
+  return_,
+  string_value,
+  ternary_operator,
+  translation_unit,
+  unary_operator,
+  variable_declaration,
+  while_
+};
+
+// Where text of a token or a string value comes from.
+enum class text_origin : std::uint8_t
+{
+  // No text, e.g. of an undefined token.
+  none,
+  // Text from the source of the module.
+  source,
+  // Text from somewhere else, e.g. a name of a builtin type. It's stored
+  // next to the tree, see serialized_sema_tree::names.
+  names
+};
+
+enum class type_tag : std::uint8_t
+{
+  // Type found by its qualified name, from the root scope.
+  named,
+  // Type of a generic type, found or created by its name representation.
+  generic
+};
+
+enum class function_tag : std::uint8_t
+{
+  // Function of a namespace, found by its qualified name.
+  free,
+  // Function found in the context of a type.
+  member
+};
+
+enum class name_tag : std::uint8_t
+{
+  qualified,
+  generic
+};
+
+class output
+{
+public:
+  void write_u8(std::uint8_t value);
+  void write_bool(bool value);
+  void write_u32(std::uint32_t value);
+  void write_u64(std::uint64_t value);
+  void write_double(double value);
+  void write_string(cmsl::string_view value);
+
+  std::string take();
+
+private:
+  std::string m_data;
+};
+
+// Reading past the end of the data doesn't crash, but makes the input fail
+// and return zeros from then on, so a truncated or corrupted tree is detected
+// by checking failed() once in a while.
+class input
+{
+public:
+  explicit input(cmsl::string_view data);
+
+  std::uint8_t read_u8();
+  bool read_bool();
+  std::uint32_t read_u32();
+  std::uint64_t read_u64();
+  double read_double();
+  cmsl::string_view read_string();
+
+  bool failed() const;
+  bool at_end() const;
+
+private:
+  const char* read_bytes(std::size_t count);
+
+private:
+  cmsl::string_view m_data;
+  std::size_t m_position{ 0u };
+  bool m_failed{ false };
+};
+}
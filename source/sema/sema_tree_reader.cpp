@@ -0,0 +1,1235 @@
+#include "sema/sema_tree_reader.hpp"
+
+#include "common/overloaded.hpp"
+#include "sema/add_subdirectory_semantic_handler.hpp"
+#include "sema/enum_creator.hpp"
+#include "sema/enum_values_context.hpp"
+#include "sema/factories.hpp"
+#include "sema/factories_provider.hpp"
+#include "sema/functions_context.hpp"
+#include "sema/homogeneous_generic_type.hpp"
+#include "sema/identifiers_context.hpp"
+#include "sema/identifiers_index_provider.hpp"
+#include "sema/import_handler.hpp"
+#include "sema/qualified_contextes.hpp"
+#include "sema/sema_context.hpp"
+#include "sema/sema_nodes.hpp"
+#include "sema/sema_type.hpp"
+#include "sema/type_builder.hpp"
+#include "sema/types_context.hpp"
+#include "sema/user_sema_function.hpp"
+
+#include <algorithm>
+#include <stack>
+
+namespace cmsl::sema {
+using sema_tree_format::function_tag;
+using sema_tree_format::name_tag;
+using sema_tree_format::node_tag;
+using sema_tree_format::text_origin;
+using sema_tree_format::type_tag;
+
+sema_tree_reader::sema_tree_reader(
+  sema_context& global_ctx, qualified_contextes_refs& qualified_ctxs,
+  factories_provider& factories,
+  add_subdirectory_semantic_handler& add_subdirectory_handler,
+  import_handler& imports_handler,
+  const builtin_token_provider& builtin_tokens,
+  builtin_types_accessor builtin_types)
+  : m_global_ctx{ global_ctx }
+  , m_qualified_ctxs{ qualified_ctxs }
+  , m_factories{ factories }
+  , m_add_subdirectory_handler{ add_subdirectory_handler }
+  , m_imports_handler{ imports_handler }
+  , m_builtin_tokens{ builtin_tokens }
+  , m_builtin_types{ builtin_types }
+{
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read(source_view source,
+                                                  source_view names,
+                                                  cmsl::string_view nodes)
+{
+  m_ctx = &m_global_ctx;
+  m_in.emplace(nodes);
+  m_source.emplace(source);
+  m_names.emplace(names);
+
+  auto tree = read_node_as<translation_unit_node>();
+  if (!tree || !m_in->at_end()) {
+    return nullptr;
+  }
+
+  return tree;
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_node()
+{
+  const auto tag = static_cast<node_tag>(m_in->read_u8());
+  const auto range = read_range();
+  if (!range) {
+    return nullptr;
+  }
+
+  const auto origin = sema_node_origin{ *range };
+  const auto& builtin_types = m_builtin_types;
+
+  switch (tag) {
+    case node_tag::add_subdirectory:
+      return read_add_subdirectory(origin);
+    case node_tag::add_subdirectory_with_old_script:
+      return read_add_subdirectory_with_old_script(origin);
+    case node_tag::binary_operator:
+      return read_binary_operator(origin);
+    case node_tag::block:
+      return read_block(origin);
+    case node_tag::bool_value: {
+      const auto value = m_in->read_bool();
+      return std::make_unique<bool_value_node>(origin, builtin_types.bool_,
+                                               value);
+    }
+    case node_tag::break_:
+      return std::make_unique<break_node>(origin);
+    case node_tag::cast_to_reference:
+    case node_tag::cast_to_value:
+      return read_cast(tag, origin);
+    case node_tag::class_member_access:
+      return read_class_member_access(origin);
+    case node_tag::class_:
+      return read_class(origin);
+    case node_tag::conditional:
+      return read_conditional(origin);
+    case node_tag::constructor_call:
+    case node_tag::function_call:
+    case node_tag::implicit_member_function_call:
+    case node_tag::member_function_call:
+      return read_call(tag, origin);
+    case node_tag::designated_initializers:
+      return read_designated_initializers(origin);
+    case node_tag::double_value: {
+      const auto value = m_in->read_double();
+      return std::make_unique<double_value_node>(
+        origin, builtin_types.double_, value);
+    }
+    case node_tag::enum_constant_access:
+    case node_tag::id:
+      return read_id(tag, origin);
+    case node_tag::enum_:
+      return read_enum(origin);
+    case node_tag::for_:
+      return read_for(origin);
+    case node_tag::function:
+      return read_function(origin);
+    case node_tag::if_else:
+      return read_if_else(origin);
+    case node_tag::implicit_return:
+      return std::make_unique<implicit_return_node>(origin,
+                                                    builtin_types.void_);
+    case node_tag::import:
+      return read_import(origin);
+    case node_tag::initializer_list:
+      return read_initializer_list(origin);
+    case node_tag::int_value: {
+      const auto value = static_cast<int_t>(m_in->read_u64());
+      return std::make_unique<int_value_node>(origin, builtin_types.int_,
+                                              value);
+    }
+    case node_tag::namespace_:
+      return read_namespace(origin);
+    case node_tag::return_: {
+      auto expression = read_node_as<expression_node>();
+      if (!expression) {
+        return nullptr;
+      }
+      return std::make_unique<return_node>(origin, std::move(expression));
+    }
+    case node_tag::string_value:
+      return read_string_value(origin);
+    case node_tag::ternary_operator:
+      return read_ternary_operator(origin);
+    case node_tag::translation_unit:
+      return read_translation_unit(origin);
+    case node_tag::unary_operator:
+      return read_unary_operator(origin);
+    case node_tag::variable_declaration:
+      return read_variable_declaration(origin);
+    case node_tag::while_:
+      return read_while(origin);
+  }
+
+  return nullptr;
+}
+
+template <typename T>
+std::unique_ptr<T> sema_tree_reader::read_node_as()
+{
+  auto node = read_node();
+  if (m_in->failed() || !dynamic_cast<T*>(node.get())) {
+    return nullptr;
+  }
+
+  return std::unique_ptr<T>{ static_cast<T*>(node.release()) };
+}
+
+std::optional<std::vector<std::unique_ptr<sema_node>>>
+sema_tree_reader::read_nodes()
+{
+  const auto count = m_in->read_u32();
+  std::vector<std::unique_ptr<sema_node>> nodes;
+
+  for (auto i = 0u; i < count && !m_in->failed(); ++i) {
+    auto node = read_node_as<sema_node>();
+    if (!node) {
+      return std::nullopt;
+    }
+
+    nodes.emplace_back(std::move(node));
+  }
+
+  if (m_in->failed()) {
+    return std::nullopt;
+  }
+
+  return std::move(nodes);
+}
+
+std::optional<sema_tree_reader::param_expressions_t>
+sema_tree_reader::read_expressions()
+{
+  const auto count = m_in->read_u32();
+  param_expressions_t expressions;
+
+  for (auto i = 0u; i < count && !m_in->failed(); ++i) {
+    auto expression = read_node_as<expression_node>();
+    if (!expression) {
+      return std::nullopt;
+    }
+
+    expressions.emplace_back(std::move(expression));
+  }
+
+  if (m_in->failed()) {
+    return std::nullopt;
+  }
+
+  return std::move(expressions);
+}
+
+std::optional<source_range> sema_tree_reader::read_range()
+{
+  const auto begin = m_in->read_u32();
+  const auto end = m_in->read_u32();
+  // Begin is not checked against end. Ranges of some nodes, e.g. of ids with
+  // the global scope access, are built from tokens that aren't in the source
+  // and they're kept as they are.
+  const auto size = m_source->source().size();
+  if (m_in->failed() || begin > size || end > size) {
+    return std::nullopt;
+  }
+
+  return source_range{ m_source->location(begin), m_source->location(end) };
+}
+
+std::optional<lexer::token> sema_tree_reader::read_token()
+{
+  const auto type = m_in->read_u8();
+  const auto text = read_text();
+  if (!text ||
+      type > static_cast<std::uint8_t>(lexer::token_type::_keywords_end)) {
+    return std::nullopt;
+  }
+
+  const auto token_type = static_cast<lexer::token_type>(type);
+  if (text->length == 0u) {
+    return lexer::token{ token_type };
+  }
+
+  if (text->length > lexer::token::k_max_length) {
+    return std::nullopt;
+  }
+
+  return lexer::token{ token_type, text->view, text->offset, text->length };
+}
+
+std::optional<sema_tree_reader::text_location> sema_tree_reader::read_text()
+{
+  const auto origin = static_cast<text_origin>(m_in->read_u8());
+  if (m_in->failed()) {
+    return std::nullopt;
+  }
+
+  if (origin == text_origin::none) {
+    return text_location{ *m_source, 0u, 0u };
+  }
+
+  const auto offset = m_in->read_u32();
+  const auto length = m_in->read_u32();
+  if (m_in->failed() ||
+      (origin != text_origin::source && origin != text_origin::names)) {
+    return std::nullopt;
+  }
+
+  const auto& view = origin == text_origin::source ? *m_source : *m_names;
+  if (std::uint64_t{ offset } + length > view.source().size()) {
+    return std::nullopt;
+  }
+
+  return text_location{ view, offset, length };
+}
+
+std::optional<std::vector<ast::name_with_coloncolon>>
+sema_tree_reader::read_names()
+{
+  const auto count = m_in->read_u32();
+  std::vector<ast::name_with_coloncolon> names;
+
+  for (auto i = 0u; i < count && !m_in->failed(); ++i) {
+    auto name = read_token();
+    if (!name) {
+      return std::nullopt;
+    }
+
+    std::optional<lexer::token> coloncolon;
+    if (m_in->read_bool()) {
+      coloncolon = read_token();
+      if (!coloncolon) {
+        return std::nullopt;
+      }
+    }
+
+    names.emplace_back(ast::name_with_coloncolon{ *name, coloncolon });
+  }
+
+  if (m_in->failed() || names.empty()) {
+    return std::nullopt;
+  }
+
+  return std::move(names);
+}
+
+std::optional<std::vector<ast::name_with_coloncolon>>
+sema_tree_reader::read_qualified_name()
+{
+  // Names are written from the root scope, so they're looked up from there,
+  // no matter what the current scope is.
+  static const auto root_name =
+    lexer::make_token(lexer::token_type::identifier, "");
+  static const auto coloncolon =
+    lexer::make_token(lexer::token_type::coloncolon, "::");
+
+  std::vector<ast::name_with_coloncolon> names{
+    ast::name_with_coloncolon{ root_name, coloncolon }
+  };
+
+  const auto count = m_in->read_u32();
+  for (auto i = 0u; i < count && !m_in->failed(); ++i) {
+    const auto name = read_token();
+    if (!name) {
+      return std::nullopt;
+    }
+
+    names.back().coloncolon = coloncolon;
+    names.emplace_back(ast::name_with_coloncolon{ *name });
+  }
+
+  if (m_in->failed() || count == 0u) {
+    return std::nullopt;
+  }
+
+  return std::move(names);
+}
+
+const sema_type* sema_tree_reader::read_type()
+{
+  const auto tag = static_cast<type_tag>(m_in->read_u8());
+  if (tag == type_tag::generic) {
+    const auto name = read_type_representation();
+    const auto value_type = read_type();
+    if (!name || !name->is_generic() || !value_type) {
+      return nullptr;
+    }
+
+    return get_or_create_generic_type(*name, *value_type);
+  }
+
+  if (tag != type_tag::named) {
+    return nullptr;
+  }
+
+  const auto is_reference = m_in->read_bool();
+  const auto names = read_qualified_name();
+  if (!names) {
+    return nullptr;
+  }
+
+  const auto found = m_qualified_ctxs.types.find(*names);
+  if (!found) {
+    return nullptr;
+  }
+
+  return is_reference ? &found->ref : &found->ty;
+}
+
+std::optional<ast::type_representation>
+sema_tree_reader::read_type_representation()
+{
+  const auto is_reference = m_in->read_bool();
+  const auto tag = static_cast<name_tag>(m_in->read_u8());
+
+  if (tag == name_tag::qualified) {
+    auto names = read_names();
+    if (!names) {
+      return std::nullopt;
+    }
+
+    auto name = ast::qualified_name{ std::move(*names) };
+    if (is_reference) {
+      return ast::type_representation{
+        std::move(name), ast::type_representation::is_reference_tag{}
+      };
+    }
+
+    return ast::type_representation{ std::move(name) };
+  }
+
+  if (tag != name_tag::generic) {
+    return std::nullopt;
+  }
+
+  lexer::token_container_t tokens;
+  const auto tokens_count = m_in->read_u32();
+  for (auto i = 0u; i < tokens_count && !m_in->failed(); ++i) {
+    const auto token = read_token();
+    if (!token) {
+      return std::nullopt;
+    }
+
+    tokens.emplace_back(*token);
+  }
+
+  std::vector<ast::type_representation> nested_types;
+  const auto nested_count = m_in->read_u32();
+  for (auto i = 0u; i < nested_count && !m_in->failed(); ++i) {
+    auto nested = read_type_representation();
+    if (!nested) {
+      return std::nullopt;
+    }
+
+    nested_types.emplace_back(std::move(*nested));
+  }
+
+  if (m_in->failed() || tokens.empty()) {
+    return std::nullopt;
+  }
+
+  auto name = ast::type_representation::generic_type_name{
+    std::move(tokens), std::move(nested_types)
+  };
+  return is_reference
+    ? ast::type_representation{ std::move(name),
+                                ast::type_representation::is_reference_tag{} }
+    : ast::type_representation{ std::move(name) };
+}
+
+const sema_type* sema_tree_reader::get_or_create_generic_type(
+  const ast::type_representation& name, const sema_type& value_type)
+{
+  const auto primary_name = name.generic_name().primary_name().str();
+  const auto is_searched = [&](const sema_type& ty) {
+    const auto generic = dynamic_cast<const homogeneous_generic_type*>(&ty);
+    return generic != nullptr && &generic->value_type() == &value_type &&
+      generic->name().generic_name().primary_name().str() == primary_name;
+  };
+  const auto get_type = [&name](const sema_context& ctx,
+                                const sema_type& ty) {
+    return name.is_reference() ? ctx.find_reference_for(ty) : &ty;
+  };
+
+  if (const auto found = m_qualified_ctxs.types.find_generic(name);
+      found != nullptr &&
+      is_searched(found->is_reference() ? found->referenced_type() : *found)) {
+    return found;
+  }
+
+  // A generic type is added to global context of the module that has used it
+  // first. It may be a module that this one imports, e.g. the one that
+  // defines the value type. Then, the type may be not reachable by its name
+  // from here.
+  std::vector<const sema_context*> contexts{ &m_global_ctx };
+  for (auto ctx = &value_type.context(); ctx != nullptr; ctx = ctx->parent()) {
+    contexts.push_back(ctx);
+  }
+
+  for (const auto ctx : contexts) {
+    for (const auto& ty : ctx->types()) {
+      if (is_searched(ty)) {
+        return get_type(*ctx, ty);
+      }
+    }
+  }
+
+  // Generic types are created on their first use, the same as sema does.
+  // The factory creates the value type, its reference is created alongside.
+  const auto value_name = ast::type_representation{ name.name() };
+  auto factory = sema_generic_type_factory{
+    m_global_ctx, *m_ctx,          m_factories,
+    m_errors,     m_builtin_tokens, m_builtin_types,
+    m_qualified_ctxs.types
+  };
+  const auto created = factory.create_generic(value_name);
+  if (!created || !is_searched(*created)) {
+    return nullptr;
+  }
+
+  return get_type(m_global_ctx, *created);
+}
+
+const sema_function* sema_tree_reader::read_called_function()
+{
+  const auto tag = static_cast<function_tag>(m_in->read_u8());
+  single_scope_function_lookup_result_t candidates;
+
+  if (tag == function_tag::free) {
+    const auto names = read_qualified_name();
+    if (!names) {
+      return nullptr;
+    }
+
+    for (const auto& scope : m_qualified_ctxs.functions.find(*names)) {
+      candidates.insert(std::end(candidates), std::cbegin(scope),
+                        std::cend(scope));
+    }
+  } else if (tag == function_tag::member) {
+    const auto owner_type = read_type();
+    const auto name = read_token();
+    if (!owner_type || !name) {
+      return nullptr;
+    }
+
+    candidates = owner_type->context().find_function_in_this_scope(*name);
+  } else {
+    return nullptr;
+  }
+
+  std::vector<cmsl::string_view> param_types;
+  const auto params_count = m_in->read_u32();
+  for (auto i = 0u; i < params_count && !m_in->failed(); ++i) {
+    param_types.emplace_back(m_in->read_string());
+  }
+
+  if (m_in->failed()) {
+    return nullptr;
+  }
+
+  const auto matches = [&param_types](const sema_function* function) {
+    const auto& params = function->signature().params;
+    return std::equal(std::cbegin(params), std::cend(params),
+                      std::cbegin(param_types), std::cend(param_types),
+                      [](const auto& param, cmsl::string_view type_name) {
+                        return param.ty.name().to_string() == type_name;
+                      });
+  };
+
+  const auto found =
+    std::find_if(std::cbegin(candidates), std::cend(candidates), matches);
+  return found != std::cend(candidates) ? *found : nullptr;
+}
+
+user_sema_function* sema_tree_reader::read_function_declaration(
+  sema_context& ctx)
+{
+  const auto name = read_token();
+  const auto exported = m_in->read_bool();
+  const auto return_type = read_type();
+  if (!name || !return_type) {
+    return nullptr;
+  }
+
+  std::vector<parameter_declaration> params;
+  const auto params_count = m_in->read_u32();
+  for (auto i = 0u; i < params_count && !m_in->failed(); ++i) {
+    const auto param_type = read_type();
+    const auto param_name = read_token();
+    if (!param_type || !param_name) {
+      return nullptr;
+    }
+
+    params.emplace_back(parameter_declaration{
+      *param_type, *param_name, identifiers_index_provider::get_next() });
+  }
+
+  const auto locals_count = m_in->read_u32();
+  if (m_in->failed()) {
+    return nullptr;
+  }
+
+  auto& function = m_factories.function_factory().create_user(
+    ctx, return_type, function_signature{ *name, std::move(params) });
+  function.set_locals_count(locals_count);
+  ctx.add_function(function);
+  m_qualified_ctxs.functions.register_function(*name, function, exported);
+  return &function;
+}
+
+std::unique_ptr<block_node> sema_tree_reader::read_function_body(
+  const user_sema_function& function)
+{
+  auto params_guard = m_qualified_ctxs.local_ids_guard();
+  const auto& params = function.signature().params;
+  for (auto i = 0u; i < params.size(); ++i) {
+    m_qualified_ctxs.ids.register_identifier(
+      params[i].name,
+      { params[i].ty, params[i].index, i, identifier_storage::local },
+      /*exported=*/false);
+  }
+
+  return read_node_as<block_node>();
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_add_subdirectory(
+  const origin_t& origin)
+{
+  auto dir_name = read_node_as<string_value_node>();
+  if (!dir_name) {
+    return nullptr;
+  }
+
+  auto params = read_expressions();
+  const auto call_name = read_token();
+  if (!params || !call_name) {
+    return nullptr;
+  }
+
+  const auto result = m_add_subdirectory_handler.handle_add_subdirectory(
+    dir_name->value(), *params);
+  const auto script =
+    std::get_if<add_subdirectory_semantic_handler::contains_cmakesl_script>(
+      &result);
+  if (!script || !script->main_function) {
+    return nullptr;
+  }
+
+  return std::make_unique<add_subdirectory_node>(
+    origin, std::move(dir_name), *script->main_function, std::move(*params),
+    *call_name);
+}
+
+std::unique_ptr<sema_node>
+sema_tree_reader::read_add_subdirectory_with_old_script(const origin_t& origin)
+{
+  auto dir_name = read_node_as<string_value_node>();
+  if (!dir_name) {
+    return nullptr;
+  }
+
+  const auto result = m_add_subdirectory_handler.handle_add_subdirectory(
+    dir_name->value(), {});
+  using old_script_t =
+    add_subdirectory_semantic_handler::contains_old_cmake_script;
+  if (!std::holds_alternative<old_script_t>(result)) {
+    return nullptr;
+  }
+
+  return std::make_unique<add_subdirectory_with_old_script_node>(
+    origin, std::move(dir_name), m_builtin_types.void_);
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_binary_operator(
+  const origin_t& origin)
+{
+  auto lhs = read_node_as<expression_node>();
+  if (!lhs) {
+    return nullptr;
+  }
+
+  const auto op = read_token();
+  const auto function = read_called_function();
+  if (!op || !function) {
+    return nullptr;
+  }
+
+  auto rhs = read_node_as<expression_node>();
+  if (!rhs) {
+    return nullptr;
+  }
+
+  return std::make_unique<binary_operator_node>(origin, std::move(lhs), *op,
+                                                *function, std::move(rhs),
+                                                function->return_type());
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_block(
+  const origin_t& origin)
+{
+  auto ids_guard = m_qualified_ctxs.local_ids_guard();
+  auto nodes = read_nodes();
+  if (!nodes) {
+    return nullptr;
+  }
+
+  return std::make_unique<block_node>(origin, std::move(*nodes));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_cast(node_tag tag,
+                                                       const origin_t& origin)
+{
+  const auto type = read_type();
+  if (!type) {
+    return nullptr;
+  }
+
+  auto expression = read_node_as<expression_node>();
+  if (!expression) {
+    return nullptr;
+  }
+
+  if (tag == node_tag::cast_to_reference) {
+    return std::make_unique<cast_to_reference_node>(origin, *type,
+                                                    std::move(expression));
+  }
+
+  return std::make_unique<cast_to_value_node>(origin, *type,
+                                              std::move(expression));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_class_member_access(
+  const origin_t& origin)
+{
+  auto lhs = read_node_as<expression_node>();
+  if (!lhs) {
+    return nullptr;
+  }
+
+  const auto name = read_token();
+  if (!name) {
+    return nullptr;
+  }
+
+  const auto member_info = lhs->type().find_member(name->str());
+  if (!member_info) {
+    return nullptr;
+  }
+
+  return std::make_unique<class_member_access_node>(origin, std::move(lhs),
+                                                    *name, *member_info);
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_class(
+  const origin_t& origin)
+{
+  const auto name = read_token();
+  const auto exported = m_in->read_bool();
+  if (!name || m_in->failed()) {
+    return nullptr;
+  }
+
+  auto class_ids_guard = m_qualified_ctxs.global_ids_guard(*name, exported);
+  auto functions_guard =
+    m_qualified_ctxs.functions_ctx_guard(*name, exported);
+  auto enums_guard = m_qualified_ctxs.enums_ctx_guard(*name, exported);
+
+  auto& class_context = m_factories.context_factory().create_class(
+    std::string{ name->str() }, m_ctx);
+
+  std::vector<std::unique_ptr<variable_declaration_node>> members;
+  std::vector<member_info> members_info;
+  const auto members_count = m_in->read_u32();
+  for (auto i = 0u; i < members_count && !m_in->failed(); ++i) {
+    auto member = read_node_as<variable_declaration_node>();
+    if (!member) {
+      return nullptr;
+    }
+
+    members_info.emplace_back(
+      member_info{ member->name(), member->type(), member->index() });
+    members.emplace_back(std::move(member));
+  }
+
+  std::vector<user_sema_function*> functions;
+  const auto functions_count = m_in->read_u32();
+  for (auto i = 0u; i < functions_count && !m_in->failed(); ++i) {
+    const auto function = read_function_declaration(class_context);
+    if (!function) {
+      return nullptr;
+    }
+
+    functions.emplace_back(function);
+  }
+
+  if (m_in->failed()) {
+    return nullptr;
+  }
+
+  auto type_factory = m_factories.type_factory(m_qualified_ctxs.types);
+  const auto& class_type = type_factory.create(
+    class_context, ast::type_representation{ ast::qualified_name{ *name } },
+    std::move(members_info), exported);
+  const auto& class_type_reference =
+    type_factory.create_reference(class_type, exported);
+
+  auto types_guard = m_qualified_ctxs.types_ctx_guard(*name, exported);
+
+  m_ctx->add_type(class_type);
+  m_ctx->add_type(class_type_reference);
+
+  std::vector<std::unique_ptr<function_node>> function_nodes;
+  const auto ctx = m_ctx;
+  m_ctx = &class_context;
+  for (const auto function : functions) {
+    const auto range = read_range();
+    auto body = range ? read_function_body(*function) : nullptr;
+    if (!body) {
+      m_ctx = ctx;
+      return nullptr;
+    }
+
+    function->set_body(*body);
+    function_nodes.emplace_back(std::make_unique<function_node>(
+      sema_node_origin{ *range }, *function, std::move(body)));
+  }
+  m_ctx = ctx;
+
+  add_user_type_default_methods(m_factories, class_type, class_context);
+
+  return std::make_unique<class_node>(origin, *name, std::move(members),
+                                      std::move(function_nodes));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_conditional(
+  const origin_t& origin)
+{
+  auto ids_guard = m_qualified_ctxs.local_ids_guard();
+  auto condition = read_node_as<expression_node>();
+  if (!condition) {
+    return nullptr;
+  }
+
+  auto body = read_node_as<block_node>();
+  if (!body) {
+    return nullptr;
+  }
+
+  return std::make_unique<conditional_node>(origin, std::move(condition),
+                                            std::move(body));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_call(node_tag tag,
+                                                       const origin_t& origin)
+{
+  std::unique_ptr<expression_node> lhs;
+  if (tag == node_tag::member_function_call) {
+    lhs = read_node_as<expression_node>();
+    if (!lhs) {
+      return nullptr;
+    }
+  }
+
+  const auto function = read_called_function();
+  if (!function) {
+    return nullptr;
+  }
+
+  auto params = read_expressions();
+  const auto call_name = read_token();
+  if (!params || !call_name) {
+    return nullptr;
+  }
+
+  switch (tag) {
+    case node_tag::constructor_call:
+      return std::make_unique<constructor_call_node>(
+        origin, function->return_type(), *function, std::move(*params),
+        *call_name);
+    case node_tag::implicit_member_function_call:
+      return std::make_unique<implicit_member_function_call_node>(
+        origin, *function, std::move(*params), *call_name);
+    case node_tag::member_function_call:
+      return std::make_unique<member_function_call_node>(
+        origin, std::move(lhs), *function, std::move(*params), *call_name);
+    default:
+      return std::make_unique<function_call_node>(
+        origin, *function, std::move(*params), *call_name);
+  }
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_designated_initializers(
+  const origin_t& origin)
+{
+  const auto name = ast::type_representation{ ast::qualified_name{
+    lexer::make_token(lexer::token_type::identifier,
+                      "designated_initializer") } };
+  auto type_factory = m_factories.type_factory(m_qualified_ctxs.types);
+  const auto& designated_type = type_factory.create_designated_initializer(
+    *m_ctx, name, /*exported=*/false);
+
+  designated_initializers_node::initializers_t initializers;
+  const auto count = m_in->read_u32();
+  for (auto i = 0u; i < count && !m_in->failed(); ++i) {
+    designated_initializers_node::initializer initializer;
+    const auto initializer_name = read_token();
+    if (!initializer_name) {
+      return nullptr;
+    }
+
+    initializer.name = *initializer_name;
+    initializer.init = read_node_as<expression_node>();
+    if (!initializer.init) {
+      return nullptr;
+    }
+
+    initializers.emplace_back(std::move(initializer));
+  }
+
+  if (m_in->failed()) {
+    return nullptr;
+  }
+
+  return std::make_unique<designated_initializers_node>(
+    origin, designated_type, std::move(initializers));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_enum(const origin_t& origin)
+{
+  const auto name = read_token();
+  const auto exported = m_in->read_bool();
+  if (!name) {
+    return nullptr;
+  }
+
+  std::vector<lexer::token> enumerators;
+  const auto count = m_in->read_u32();
+  for (auto i = 0u; i < count && !m_in->failed(); ++i) {
+    const auto enumerator = read_token();
+    if (!enumerator) {
+      return nullptr;
+    }
+
+    enumerators.emplace_back(*enumerator);
+  }
+
+  if (m_in->failed()) {
+    return nullptr;
+  }
+
+  enum_creator creator{ m_factories, m_qualified_ctxs.types, *m_ctx,
+                        m_builtin_types };
+  const auto& enum_type = creator.create(*name, enumerators);
+  auto functions_guard = m_qualified_ctxs.functions_ctx_guard(*name, exported);
+
+  {
+    auto guard = m_qualified_ctxs.enums_ctx_guard(*name, exported);
+
+    unsigned value{};
+    for (const auto& enumerator : enumerators) {
+      const auto enum_value_index = identifiers_index_provider::get_next();
+      m_qualified_ctxs.enums.register_identifier(
+        enumerator,
+        enum_values_context::enum_value_info{ enum_type, value++,
+                                              enum_value_index },
+        exported);
+    }
+  }
+
+  return std::make_unique<enum_node>(origin, *name, std::move(enumerators));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_for(const origin_t& origin)
+{
+  auto ids_guard = m_qualified_ctxs.local_ids_guard();
+
+  const auto read_optional = [this](auto& node) {
+    if (!m_in->read_bool()) {
+      return !m_in->failed();
+    }
+
+    using node_t = typename std::decay_t<decltype(node)>::element_type;
+    node = read_node_as<node_t>();
+    return node != nullptr;
+  };
+
+  std::unique_ptr<sema_node> init;
+  std::unique_ptr<expression_node> condition;
+  std::unique_ptr<expression_node> iteration;
+  if (!read_optional(init) || !read_optional(condition) ||
+      !read_optional(iteration)) {
+    return nullptr;
+  }
+
+  auto body = read_node_as<block_node>();
+  if (!body) {
+    return nullptr;
+  }
+
+  return std::make_unique<for_node>(origin, std::move(init),
+                                    std::move(condition), std::move(iteration),
+                                    std::move(body));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_function(
+  const origin_t& origin)
+{
+  const auto function = read_function_declaration(*m_ctx);
+  if (!function) {
+    return nullptr;
+  }
+
+  auto body = read_function_body(*function);
+  if (!body) {
+    return nullptr;
+  }
+
+  function->set_body(*body);
+  return std::make_unique<function_node>(origin, *function, std::move(body));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_id(node_tag tag,
+                                                     const origin_t& origin)
+{
+  auto names = read_names();
+  if (!names) {
+    return nullptr;
+  }
+
+  if (tag == node_tag::id) {
+    const auto info = m_qualified_ctxs.ids.info_of(*names);
+    if (!info) {
+      return nullptr;
+    }
+
+    return std::make_unique<id_node>(origin, info->type, std::move(*names),
+                                     info->index, info->slot, info->storage);
+  }
+
+  const auto info = m_qualified_ctxs.enums.info_of(*names);
+  if (!info) {
+    return nullptr;
+  }
+
+  return std::make_unique<enum_constant_access_node>(
+    origin, info->type, std::move(*names), info->value, info->index);
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_if_else(
+  const origin_t& origin)
+{
+  if_else_node::ifs_t ifs;
+  const auto count = m_in->read_u32();
+  for (auto i = 0u; i < count && !m_in->failed(); ++i) {
+    auto conditional = read_node_as<conditional_node>();
+    if (!conditional) {
+      return nullptr;
+    }
+
+    ifs.emplace_back(std::move(conditional));
+  }
+
+  std::unique_ptr<block_node> else_body;
+  if (m_in->read_bool()) {
+    auto ids_guard = m_qualified_ctxs.local_ids_guard();
+    else_body = read_node_as<block_node>();
+    if (!else_body) {
+      return nullptr;
+    }
+  }
+
+  if (m_in->failed()) {
+    return nullptr;
+  }
+
+  return std::make_unique<if_else_node>(origin, std::move(ifs),
+                                        std::move(else_body));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_import(
+  const origin_t& origin)
+{
+  const auto file_path = read_token();
+  if (!file_path || file_path->str().size() < 2u) {
+    return nullptr;
+  }
+
+  // -2 to remove "".
+  const auto file_path_view = file_path->str();
+  const auto path = cmsl::string_view{ file_path_view.data() + 1u,
+                                       file_path_view.size() - 2u };
+  const auto imported = m_imports_handler.handle_import(path);
+  if (!imported) {
+    return nullptr;
+  }
+
+  const auto enums_succeed =
+    m_qualified_ctxs.enums.merge_imported_stuff(*imported->enums, m_errors);
+  const auto functions_succeed =
+    m_qualified_ctxs.functions.merge_imported_stuff(*imported->functions,
+                                                    m_errors);
+  const auto ids_succeed =
+    m_qualified_ctxs.ids.merge_imported_stuff(*imported->ids, m_errors);
+  const auto types_succeed =
+    m_qualified_ctxs.types.merge_imported_stuff(*imported->types, m_errors);
+  if (!enums_succeed || !functions_succeed || !ids_succeed ||
+      !types_succeed) {
+    return nullptr;
+  }
+
+  return std::make_unique<import_node>(origin, *file_path);
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_initializer_list(
+  const origin_t& origin)
+{
+  auto values = read_expressions();
+  if (!values || values->empty()) {
+    return nullptr;
+  }
+
+  const auto type = read_type();
+  if (!type) {
+    return nullptr;
+  }
+
+  return std::make_unique<initializer_list_node>(origin, *type,
+                                                 std::move(*values));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_namespace(
+  const origin_t& origin)
+{
+  auto names = read_names();
+  if (!names) {
+    return nullptr;
+  }
+
+  std::stack<qualified_contextes_refs::all_qualified_contextes_guard> guards;
+  for (const auto& name_with_colon : *names) {
+    guards.emplace(m_qualified_ctxs.all_qualified_ctxs_guard(
+      name_with_colon.name, /*exported=*/false));
+  }
+
+  auto nodes = read_nodes();
+  if (!nodes) {
+    return nullptr;
+  }
+
+  return std::make_unique<namespace_node>(origin, std::move(*names),
+                                          std::move(*nodes));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_string_value(
+  const origin_t& origin)
+{
+  const auto text = read_text();
+  if (!text) {
+    return nullptr;
+  }
+
+  const auto value = text->view.source().substr(text->offset, text->length);
+  return std::make_unique<string_value_node>(origin, m_builtin_types.string,
+                                             value);
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_ternary_operator(
+  const origin_t& origin)
+{
+  auto condition = read_node_as<expression_node>();
+  if (!condition) {
+    return nullptr;
+  }
+
+  auto true_ = read_node_as<expression_node>();
+  if (!true_) {
+    return nullptr;
+  }
+
+  auto false_ = read_node_as<expression_node>();
+  if (!false_) {
+    return nullptr;
+  }
+
+  return std::make_unique<ternary_operator_node>(
+    origin, std::move(condition), std::move(true_), std::move(false_));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_translation_unit(
+  const origin_t& origin)
+{
+  auto nodes = read_nodes();
+  if (!nodes) {
+    return nullptr;
+  }
+
+  return std::make_unique<translation_unit_node>(origin, m_global_ctx,
+                                                 std::move(*nodes));
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_unary_operator(
+  const origin_t& origin)
+{
+  const auto op = read_token();
+  if (!op) {
+    return nullptr;
+  }
+
+  auto expression = read_node_as<expression_node>();
+  if (!expression) {
+    return nullptr;
+  }
+
+  const auto function = read_called_function();
+  if (!function) {
+    return nullptr;
+  }
+
+  return std::make_unique<unary_operator_node>(origin, *op,
+                                               std::move(expression),
+                                               *function);
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_variable_declaration(
+  const origin_t& origin)
+{
+  const auto type = read_type();
+  const auto name = read_token();
+  if (!type || !name) {
+    return nullptr;
+  }
+
+  std::unique_ptr<expression_node> initialization;
+  if (m_in->read_bool()) {
+    initialization = read_node_as<expression_node>();
+    if (!initialization) {
+      return nullptr;
+    }
+  }
+
+  const auto has_slot = m_in->read_bool();
+  const auto slot_value = m_in->read_u32();
+  const auto storage = m_in->read_u8();
+  const auto exported = m_in->read_bool();
+  if (m_in->failed() ||
+      storage > static_cast<std::uint8_t>(identifier_storage::builtin)) {
+    return nullptr;
+  }
+
+  const auto identifier_index = identifiers_index_provider::get_next();
+  const auto slot =
+    has_slot ? std::optional<unsigned>{ slot_value } : std::nullopt;
+  m_qualified_ctxs.ids.register_identifier(
+    *name,
+    { *type, identifier_index, slot,
+      static_cast<identifier_storage>(storage) },
+    exported);
+  return std::make_unique<variable_declaration_node>(
+    origin, *type, *name, std::move(initialization), identifier_index, slot);
+}
+
+std::unique_ptr<sema_node> sema_tree_reader::read_while(
+  const origin_t& origin)
+{
+  auto conditional = read_node_as<conditional_node>();
+  if (!conditional) {
+    return nullptr;
+  }
+
+  return std::make_unique<while_node>(origin, std::move(conditional));
+}
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "common/source_view.hpp"
+#include "errors/errors_observer.hpp"
+#include "lexer/token.hpp"
+#include "sema/builtin_types_accessor.hpp"
+#include "sema/qualified_contextes_refs.hpp"
+#include "sema/sema_node.hpp"
+#include "sema/sema_tree_format.hpp"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace cmsl {
+namespace ast {
+struct name_with_coloncolon;
+class type_representation;
+}
+
+namespace sema {
+class add_subdirectory_semantic_handler;
+class block_node;
+class builtin_token_provider;
+class expression_node;
+class factories_provider;
+class import_handler;
+class sema_context;
+class sema_function;
+class sema_node;
+class sema_type;
+class user_sema_function;
+
+// Loads a sema tree written by sema_tree_writer. The tree is built the same
+// way sema_builder builds it from the AST: types, functions and identifiers
+// are created and registered in the qualified contexts, so the module exports
+// the same things as if it has been compiled. Imports and subdirectories are
+// handled again, so they're loaded or compiled too.
+class sema_tree_reader
+{
+public:
+  explicit sema_tree_reader(
+    sema_context& global_ctx, qualified_contextes_refs& qualified_ctxs,
+    factories_provider& factories,
+    add_subdirectory_semantic_handler& add_subdirectory_handler,
+    import_handler& imports_handler,
+    const builtin_token_provider& builtin_tokens,
+    builtin_types_accessor builtin_types);
+
+  // Returns nullptr if the tree is corrupted or refers to something that
+  // can't be found anymore, e.g. to a function removed from an imported
+  // module. The tree needs to be compiled from the source then, with fresh
+  // contexts, because some of its entries may have been registered already.
+  std::unique_ptr<sema_node> read(source_view source, source_view names,
+                                  cmsl::string_view nodes);
+
+private:
+  using param_expressions_t = std::vector<std::unique_ptr<expression_node>>;
+
+  std::unique_ptr<sema_node> read_node();
+  template <typename T>
+  std::unique_ptr<T> read_node_as();
+  std::optional<std::vector<std::unique_ptr<sema_node>>> read_nodes();
+  std::optional<param_expressions_t> read_expressions();
+  std::optional<source_range> read_range();
+
+  struct text_location
+  {
+    source_view view;
+    unsigned offset;
+    unsigned length;
+  };
+
+  std::optional<lexer::token> read_token();
+  std::optional<text_location> read_text();
+  std::optional<std::vector<ast::name_with_coloncolon>> read_names();
+  std::optional<std::vector<ast::name_with_coloncolon>>
+  read_qualified_name();
+  const sema_type* read_type();
+  std::optional<ast::type_representation> read_type_representation();
+  const sema_type* get_or_create_generic_type(
+    const ast::type_representation& name, const sema_type& value_type);
+  const sema_function* read_called_function();
+  user_sema_function* read_function_declaration(sema_context& ctx);
+  std::unique_ptr<block_node> read_function_body(
+    const user_sema_function& function);
+
+  using origin_t = sema_node_origin;
+  std::unique_ptr<sema_node> read_add_subdirectory(const origin_t& origin);
+  std::unique_ptr<sema_node> read_add_subdirectory_with_old_script(
+    const origin_t& origin);
+  std::unique_ptr<sema_node> read_binary_operator(const origin_t& origin);
+  std::unique_ptr<sema_node> read_block(const origin_t& origin);
+  std::unique_ptr<sema_node> read_cast(sema_tree_format::node_tag tag,
+                                       const origin_t& origin);
+  std::unique_ptr<sema_node> read_class_member_access(const origin_t& origin);
+  std::unique_ptr<sema_node> read_class(const origin_t& origin);
+  std::unique_ptr<sema_node> read_conditional(const origin_t& origin);
+  std::unique_ptr<sema_node> read_call(sema_tree_format::node_tag tag,
+                                       const origin_t& origin);
+  std::unique_ptr<sema_node> read_designated_initializers(
+    const origin_t& origin);
+  std::unique_ptr<sema_node> read_enum(const origin_t& origin);
+  std::unique_ptr<sema_node> read_for(const origin_t& origin);
+  std::unique_ptr<sema_node> read_function(const origin_t& origin);
+  std::unique_ptr<sema_node> read_id(sema_tree_format::node_tag tag,
+                                     const origin_t& origin);
+  std::unique_ptr<sema_node> read_if_else(const origin_t& origin);
+  std::unique_ptr<sema_node> read_import(const origin_t& origin);
+  std::unique_ptr<sema_node> read_initializer_list(const origin_t& origin);
+  std::unique_ptr<sema_node> read_namespace(const origin_t& origin);
+  std::unique_ptr<sema_node> read_string_value(const origin_t& origin);
+  std::unique_ptr<sema_node> read_ternary_operator(const origin_t& origin);
+  std::unique_ptr<sema_node> read_translation_unit(const origin_t& origin);
+  std::unique_ptr<sema_node> read_unary_operator(const origin_t& origin);
+  std::unique_ptr<sema_node> read_variable_declaration(
+    const origin_t& origin);
+  std::unique_ptr<sema_node> read_while(const origin_t& origin);
+
+private:
+  sema_context& m_global_ctx;
+  qualified_contextes_refs& m_qualified_ctxs;
+  factories_provider& m_factories;
+  add_subdirectory_semantic_handler& m_add_subdirectory_handler;
+  import_handler& m_imports_handler;
+  const builtin_token_provider& m_builtin_tokens;
+  builtin_types_accessor m_builtin_types;
+  // Errors of a tree that has been read successfully have been reported
+  // while it was compiled, so they're not reported again.
+  errors::errors_observer m_errors{ errors::errors_observer::defer_errors };
+
+  // Context that sema would build the current node in, e.g. the context of a
+  // class while its member functions are read.
+  sema_context* m_ctx{ nullptr };
+  std::optional<sema_tree_format::input> m_in;
+  std::optional<source_view> m_source;
+  std::optional<source_view> m_names;
+};
+}
+}
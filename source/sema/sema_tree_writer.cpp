@@ -0,0 +1,547 @@
+#include "sema/sema_tree_writer.hpp"
+
+#include "ast/ast_node.hpp"
+#include "sema/functions_context.hpp"
+#include "sema/homogeneous_generic_type.hpp"
+#include "sema/qualified_contextes_refs.hpp"
+#include "sema/sema_context.hpp"
+#include "sema/sema_nodes.hpp"
+#include "sema/sema_type.hpp"
+#include "sema/types_context.hpp"
+#include "sema/user_sema_function.hpp"
+
+namespace cmsl::sema {
+using sema_tree_format::function_tag;
+using sema_tree_format::name_tag;
+using sema_tree_format::node_tag;
+using sema_tree_format::text_origin;
+using sema_tree_format::type_tag;
+
+sema_tree_writer::sema_tree_writer(
+  source_view source, const qualified_contextes_refs& qualified_ctxs)
+  : m_source{ source }
+{
+  // Generic types are written by their name representations, and designated
+  // initializers have a type per initializer, so only the other types need
+  // qualified names.
+  qualified_ctxs.types.for_each_type(
+    [this](const auto& qualified_name, const sema_type& ty) {
+      if (!ty.is_reference()) {
+        m_context_types.emplace(&ty.context(), &ty);
+      }
+
+      if (!ty.name().is_generic() && !ty.is_designated_initializer()) {
+        m_type_names.emplace(&ty, qualified_name);
+      }
+    });
+
+  qualified_ctxs.functions.for_each_function(
+    [this](const auto& qualified_name, const sema_function& function) {
+      m_function_names.emplace(&function, qualified_name);
+    });
+}
+
+std::optional<serialized_sema_tree> sema_tree_writer::write(
+  const sema_node& tree)
+{
+  write_node(tree);
+  if (m_failed) {
+    return std::nullopt;
+  }
+
+  return serialized_sema_tree{ std::move(m_names), m_out.take() };
+}
+
+void sema_tree_writer::visit(const add_subdirectory_node& node)
+{
+  // Main function of the subdirectory is found again while loading, by
+  // handling the add_subdirectory call once more.
+  write_header(node_tag::add_subdirectory, node);
+  write_node(node.dir_name());
+  write_nodes(node.param_expressions());
+  write_token(node.call_name());
+}
+
+void sema_tree_writer::visit(const add_subdirectory_with_old_script_node& node)
+{
+  write_header(node_tag::add_subdirectory_with_old_script, node);
+  write_node(node.dir_name());
+}
+
+void sema_tree_writer::visit(const binary_operator_node& node)
+{
+  write_header(node_tag::binary_operator, node);
+  write_node(node.lhs());
+  write_token(node.op());
+  write_function(node.operator_function(), &node.lhs().type());
+  write_node(node.rhs());
+}
+
+void sema_tree_writer::visit(const block_node& node)
+{
+  write_header(node_tag::block, node);
+  write_nodes(node.nodes());
+}
+
+void sema_tree_writer::visit(const bool_value_node& node)
+{
+  write_header(node_tag::bool_value, node);
+  m_out.write_bool(node.value());
+}
+
+void sema_tree_writer::visit(const break_node& node)
+{
+  write_header(node_tag::break_, node);
+}
+
+void sema_tree_writer::visit(const cast_to_reference_node& node)
+{
+  write_header(node_tag::cast_to_reference, node);
+  write_type(node.type());
+  write_node(node.expression());
+}
+
+void sema_tree_writer::visit(const cast_to_value_node& node)
+{
+  write_header(node_tag::cast_to_value, node);
+  write_type(node.type());
+  write_node(node.expression());
+}
+
+void sema_tree_writer::visit(const class_member_access_node& node)
+{
+  write_header(node_tag::class_member_access, node);
+  write_node(node.lhs());
+  write_token(node.member_access_name());
+}
+
+void sema_tree_writer::visit(const class_node& node)
+{
+  // Written in the order sema creates the class, so that the reader can
+  // create it the same way: members, declarations of the functions and then
+  // their bodies.
+  write_header(node_tag::class_, node);
+  write_token(node.name());
+  m_out.write_bool(node.ast_node().is_exported());
+  write_nodes(node.members());
+
+  const auto& functions = node.functions();
+  m_out.write_u32(static_cast<std::uint32_t>(functions.size()));
+  for (const auto& function : functions) {
+    const auto& user_function =
+      static_cast<const user_sema_function&>(function->function());
+    write_function_declaration(user_function,
+                               function->ast_node().is_exported());
+  }
+
+  for (const auto& function : functions) {
+    m_out.write_u32(function->begin_location().absolute);
+    m_out.write_u32(function->end_location().absolute);
+    write_node(function->body());
+  }
+}
+
+void sema_tree_writer::visit(const conditional_node& node)
+{
+  write_header(node_tag::conditional, node);
+  write_node(node.get_condition());
+  write_node(node.get_body());
+}
+
+void sema_tree_writer::visit(const constructor_call_node& node)
+{
+  write_header(node_tag::constructor_call, node);
+  write_function(node.function(), &node.type());
+  write_nodes(node.param_expressions());
+  write_token(node.call_name());
+}
+
+void sema_tree_writer::visit(const designated_initializers_node& node)
+{
+  write_header(node_tag::designated_initializers, node);
+
+  const auto& initializers = node.initializers();
+  m_out.write_u32(static_cast<std::uint32_t>(initializers.size()));
+  for (const auto& initializer : initializers) {
+    write_token(initializer.name);
+    write_node(*initializer.init);
+  }
+}
+
+void sema_tree_writer::visit(const double_value_node& node)
+{
+  write_header(node_tag::double_value, node);
+  m_out.write_double(node.value());
+}
+
+void sema_tree_writer::visit(const enum_constant_access_node& node)
+{
+  write_header(node_tag::enum_constant_access, node);
+  write_names(node.names());
+}
+
+void sema_tree_writer::visit(const enum_node& node)
+{
+  write_header(node_tag::enum_, node);
+  write_token(node.name());
+  m_out.write_bool(node.ast_node().is_exported());
+
+  const auto& enumerators = node.enumerators();
+  m_out.write_u32(static_cast<std::uint32_t>(enumerators.size()));
+  for (const auto& enumerator : enumerators) {
+    write_token(enumerator);
+  }
+}
+
+void sema_tree_writer::visit(const for_node& node)
+{
+  write_header(node_tag::for_, node);
+  write_optional_node(node.init());
+  write_optional_node(node.condition());
+  write_optional_node(node.iteration());
+  write_node(node.body());
+}
+
+void sema_tree_writer::visit(const function_call_node& node)
+{
+  write_header(node_tag::function_call, node);
+  write_function(node.function());
+  write_nodes(node.param_expressions());
+  write_token(node.call_name());
+}
+
+void sema_tree_writer::visit(const function_node& node)
+{
+  const auto& function =
+    static_cast<const user_sema_function&>(node.function());
+  write_header(node_tag::function, node);
+  write_function_declaration(function, node.ast_node().is_exported());
+  write_node(node.body());
+}
+
+void sema_tree_writer::visit(const id_node& node)
+{
+  // Index, slot and storage are given by the declaration, that is loaded
+  // before.
+  write_header(node_tag::id, node);
+  write_names(node.names());
+}
+
+void sema_tree_writer::visit(const if_else_node& node)
+{
+  write_header(node_tag::if_else, node);
+  write_nodes(node.ifs());
+  write_optional_node(node.else_body());
+}
+
+void sema_tree_writer::visit(const implicit_member_function_call_node& node)
+{
+  write_header(node_tag::implicit_member_function_call, node);
+  write_function(node.function());
+  write_nodes(node.param_expressions());
+  write_token(node.call_name());
+}
+
+void sema_tree_writer::visit(const implicit_return_node& node)
+{
+  write_header(node_tag::implicit_return, node);
+}
+
+void sema_tree_writer::visit(const import_node& node)
+{
+  write_header(node_tag::import, node);
+  write_token(node.file_path());
+}
+
+void sema_tree_writer::visit(const initializer_list_node& node)
+{
+  // Values go first. Sema creates the list type after them.
+  write_header(node_tag::initializer_list, node);
+  write_nodes(node.values());
+  write_type(node.type());
+}
+
+void sema_tree_writer::visit(const int_value_node& node)
+{
+  write_header(node_tag::int_value, node);
+  m_out.write_u64(static_cast<std::uint64_t>(node.value()));
+}
+
+void sema_tree_writer::visit(const member_function_call_node& node)
+{
+  write_header(node_tag::member_function_call, node);
+  write_node(node.lhs());
+  write_function(node.function(), &node.lhs().type());
+  write_nodes(node.param_expressions());
+  write_token(node.call_name());
+}
+
+void sema_tree_writer::visit(const namespace_node& node)
+{
+  write_header(node_tag::namespace_, node);
+  write_names(node.names());
+  write_nodes(node.nodes());
+}
+
+void sema_tree_writer::visit(const return_node& node)
+{
+  write_header(node_tag::return_, node);
+  write_node(node.expression());
+}
+
+void sema_tree_writer::visit(const string_value_node& node)
+{
+  write_header(node_tag::string_value, node);
+
+  write_text(node.value());
+}
+
+void sema_tree_writer::visit(const ternary_operator_node& node)
+{
+  write_header(node_tag::ternary_operator, node);
+  write_node(node.condition());
+  write_node(node.true_());
+  write_node(node.false_());
+}
+
+void sema_tree_writer::visit(const translation_unit_node& node)
+{
+  write_header(node_tag::translation_unit, node);
+  write_nodes(node.nodes());
+}
+
+void sema_tree_writer::visit(const unary_operator_node& node)
+{
+  write_header(node_tag::unary_operator, node);
+  write_token(node.operator_());
+  write_node(node.expression());
+  write_function(node.function(), &node.expression().type());
+}
+
+void sema_tree_writer::visit(const variable_declaration_node& node)
+{
+  write_header(node_tag::variable_declaration, node);
+  write_type(node.type());
+  write_token(node.name());
+  write_optional_node(node.initialization());
+
+  const auto slot = node.slot();
+  m_out.write_bool(slot.has_value());
+  m_out.write_u32(slot.value_or(0u));
+
+  // Storage of a declaration is not kept in the node, but it's known from
+  // the place of the declaration.
+  const auto is_member = dynamic_cast<const class_node*>(node.parent());
+  const auto storage = slot ? identifier_storage::local
+    : is_member             ? identifier_storage::member
+                            : identifier_storage::global;
+  m_out.write_u8(static_cast<std::uint8_t>(storage));
+  m_out.write_bool(node.ast_node().is_exported());
+}
+
+void sema_tree_writer::visit(const while_node& node)
+{
+  write_header(node_tag::while_, node);
+  write_node(node.conditional());
+}
+
+void sema_tree_writer::write_header(node_tag tag, const sema_node& node)
+{
+  m_out.write_u8(static_cast<std::uint8_t>(tag));
+  m_out.write_u32(node.begin_location().absolute);
+  m_out.write_u32(node.end_location().absolute);
+}
+
+void sema_tree_writer::write_node(const sema_node& node)
+{
+  if (!m_failed) {
+    node.visit(*this);
+  }
+}
+
+void sema_tree_writer::write_optional_node(const sema_node* node)
+{
+  m_out.write_bool(node != nullptr);
+  if (node) {
+    write_node(*node);
+  }
+}
+
+template <typename Nodes>
+void sema_tree_writer::write_nodes(const Nodes& nodes)
+{
+  m_out.write_u32(static_cast<std::uint32_t>(nodes.size()));
+  for (const auto& node : nodes) {
+    write_node(*node);
+  }
+}
+
+void sema_tree_writer::write_token(const lexer::token& token)
+{
+  m_out.write_u8(static_cast<std::uint8_t>(token.get_type()));
+
+  write_text(token.str());
+}
+
+void sema_tree_writer::write_text(cmsl::string_view text)
+{
+  if (text.empty()) {
+    m_out.write_u8(static_cast<std::uint8_t>(text_origin::none));
+    return;
+  }
+
+  const auto source = m_source.source();
+  const auto is_in_source = text.data() >= source.data() &&
+    text.data() + text.size() <= source.data() + source.size();
+  if (is_in_source) {
+    m_out.write_u8(static_cast<std::uint8_t>(text_origin::source));
+    m_out.write_u32(static_cast<std::uint32_t>(text.data() - source.data()));
+  } else {
+    auto [found, inserted] = m_names_offsets.emplace(
+      std::string{ text }, static_cast<unsigned>(m_names.size()));
+    if (inserted) {
+      m_names.append(text.data(), text.size());
+    }
+
+    m_out.write_u8(static_cast<std::uint8_t>(text_origin::names));
+    m_out.write_u32(found->second);
+  }
+
+  m_out.write_u32(static_cast<std::uint32_t>(text.size()));
+}
+
+void sema_tree_writer::write_names(
+  const std::vector<ast::name_with_coloncolon>& names)
+{
+  m_out.write_u32(static_cast<std::uint32_t>(names.size()));
+  for (const auto& name : names) {
+    write_token(name.name);
+    m_out.write_bool(name.coloncolon.has_value());
+    if (name.coloncolon) {
+      write_token(*name.coloncolon);
+    }
+  }
+}
+
+void sema_tree_writer::write_qualified_name(
+  const std::vector<lexer::token>& names)
+{
+  m_out.write_u32(static_cast<std::uint32_t>(names.size()));
+  for (const auto& name : names) {
+    write_token(name);
+  }
+}
+
+void sema_tree_writer::write_type(const sema_type& type)
+{
+  // Name of a generic type tells also whether it's a reference.
+  const auto& name = type.name();
+  if (name.is_generic()) {
+    // The name is spelled as in the module that has created the type, so it
+    // may not be valid in this one. The value type tells which one it is.
+    const auto& not_reference =
+      type.is_reference() ? type.referenced_type() : type;
+    const auto generic =
+      dynamic_cast<const homogeneous_generic_type*>(&not_reference);
+    if (generic == nullptr) {
+      fail();
+      return;
+    }
+
+    m_out.write_u8(static_cast<std::uint8_t>(type_tag::generic));
+    write_type_representation(name);
+    write_type(generic->value_type());
+    return;
+  }
+
+  const auto found = m_type_names.find(&type);
+  if (found == std::cend(m_type_names)) {
+    fail();
+    return;
+  }
+
+  m_out.write_u8(static_cast<std::uint8_t>(type_tag::named));
+  m_out.write_bool(type.is_reference());
+  write_qualified_name(found->second);
+}
+
+void sema_tree_writer::write_type_representation(
+  const ast::type_representation& name)
+{
+  m_out.write_bool(name.is_reference());
+
+  if (!name.is_generic()) {
+    m_out.write_u8(static_cast<std::uint8_t>(name_tag::qualified));
+    write_names(name.qual_name().names());
+    return;
+  }
+
+  m_out.write_u8(static_cast<std::uint8_t>(name_tag::generic));
+  const auto& generic_name = name.generic_name();
+  write_qualified_name(generic_name.tokens);
+  m_out.write_u32(
+    static_cast<std::uint32_t>(generic_name.nested_types.size()));
+  for (const auto& nested : generic_name.nested_types) {
+    write_type_representation(nested);
+  }
+}
+
+void sema_tree_writer::write_function(const sema_function& function,
+                                      const sema_type* owner_type)
+{
+  const auto& ctx = function.context();
+  if (ctx.type() == sema_context::context_type::namespace_) {
+    const auto found = m_function_names.find(&function);
+    if (found == std::cend(m_function_names)) {
+      fail();
+      return;
+    }
+
+    m_out.write_u8(static_cast<std::uint8_t>(function_tag::free));
+    write_qualified_name(found->second);
+  } else {
+    if (owner_type == nullptr || &owner_type->context() != &ctx) {
+      const auto found = m_context_types.find(&ctx);
+      if (found == std::cend(m_context_types)) {
+        fail();
+        return;
+      }
+
+      owner_type = found->second;
+    }
+
+    m_out.write_u8(static_cast<std::uint8_t>(function_tag::member));
+    write_type(*owner_type);
+    write_token(function.signature().name);
+  }
+
+  // Overloads are told apart by types of their parameters.
+  const auto& params = function.signature().params;
+  m_out.write_u32(static_cast<std::uint32_t>(params.size()));
+  for (const auto& param : params) {
+    m_out.write_string(param.ty.name().to_string());
+  }
+}
+
+void sema_tree_writer::write_function_declaration(
+  const user_sema_function& function, bool exported)
+{
+  const auto& signature = function.signature();
+  write_token(signature.name);
+  m_out.write_bool(exported);
+  write_type(function.return_type());
+
+  m_out.write_u32(static_cast<std::uint32_t>(signature.params.size()));
+  for (const auto& param : signature.params) {
+    write_type(param.ty);
+    write_token(param.name);
+  }
+
+  m_out.write_u32(function.locals_count());
+}
+
+void sema_tree_writer::fail()
+{
+  m_failed = true;
+}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "common/source_view.hpp"
+#include "lexer/token.hpp"
+#include "sema/sema_node_visitor.hpp"
+#include "sema/sema_tree_format.hpp"
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cmsl {
+namespace ast {
+struct name_with_coloncolon;
+class type_representation;
+}
+
+namespace sema {
+class sema_context;
+class sema_function;
+class sema_node;
+class sema_type;
+class user_sema_function;
+struct qualified_contextes_refs;
+
+struct serialized_sema_tree
+{
+  // Texts of tokens that don't come from the source of the module, e.g.
+  // names of builtin types. Tokens of a loaded tree point into them.
+  std::string names;
+  std::string nodes;
+};
+
+// Serializes a sema tree, so that sema_tree_reader can load it later without
+// parsing and analysing the source again. Types and functions are written by
+// their names, e.g. a qualified name of a class or a name and parameters of a
+// member function, not by their addresses. It has to be used right after the
+// tree has been built, while its AST is still alive, because export flags of
+// the declarations are kept only in the AST.
+class sema_tree_writer : public sema_node_visitor
+{
+public:
+  explicit sema_tree_writer(source_view source,
+                            const qualified_contextes_refs& qualified_ctxs);
+
+  // Returns nothing if the tree refers to something that can't be found by
+  // name, e.g. to a type that is neither imported, nor exported by a module.
+  // Such tree needs to be compiled every time.
+  std::optional<serialized_sema_tree> write(const sema_node& tree);
+
+  void visit(const add_subdirectory_node& node) override;
+  void visit(const add_subdirectory_with_old_script_node& node) override;
+  void visit(const binary_operator_node& node) override;
+  void visit(const block_node& node) override;
+  void visit(const bool_value_node& node) override;
+  void visit(const break_node& node) override;
+  void visit(const cast_to_reference_node& node) override;
+  void visit(const cast_to_value_node& node) override;
+  void visit(const class_member_access_node& node) override;
+  void visit(const class_node& node) override;
+  void visit(const conditional_node& node) override;
+  void visit(const constructor_call_node& node) override;
+  void visit(const designated_initializers_node& node) override;
+  void visit(const double_value_node& node) override;
+  void visit(const enum_constant_access_node& node) override;
+  void visit(const enum_node& node) override;
+  void visit(const for_node& node) override;
+  void visit(const function_call_node& node) override;
+  void visit(const function_node& node) override;
+  void visit(const id_node& node) override;
+  void visit(const if_else_node& node) override;
+  void visit(const implicit_member_function_call_node& node) override;
+  void visit(const implicit_return_node& node) override;
+  void visit(const import_node& node) override;
+  void visit(const initializer_list_node& node) override;
+  void visit(const int_value_node& node) override;
+  void visit(const member_function_call_node& node) override;
+  void visit(const namespace_node& node) override;
+  void visit(const return_node& node) override;
+  void visit(const string_value_node& node) override;
+  void visit(const ternary_operator_node& node) override;
+  void visit(const translation_unit_node& node) override;
+  void visit(const unary_operator_node& node) override;
+  void visit(const variable_declaration_node& node) override;
+  void visit(const while_node& node) override;
+
+private:
+  void write_header(sema_tree_format::node_tag tag, const sema_node& node);
+  void write_node(const sema_node& node);
+  void write_optional_node(const sema_node* node);
+  template <typename Nodes>
+  void write_nodes(const Nodes& nodes);
+
+  void write_token(const lexer::token& token);
+  void write_text(cmsl::string_view text);
+  void write_names(const std::vector<ast::name_with_coloncolon>& names);
+  void write_qualified_name(const std::vector<lexer::token>& names);
+  void write_type(const sema_type& type);
+  void write_type_representation(const ast::type_representation& name);
+  void write_function(const sema_function& function,
+                      const sema_type* owner_type = nullptr);
+  void write_function_declaration(const user_sema_function& function,
+                                  bool exported);
+
+  void fail();
+
+private:
+  source_view m_source;
+  sema_tree_format::output m_out;
+  std::string m_names;
+  std::unordered_map<std::string, unsigned> m_names_offsets;
+  // Qualified names of types and free functions that can be found from this
+  // module.
+  std::unordered_map<const sema_type*, std::vector<lexer::token>>
+    m_type_names;
+  std::unordered_map<const sema_function*, std::vector<lexer::token>>
+    m_function_names;
+  // Types that own the contexts, so member functions can be found in them.
+  std::unordered_map<const sema_context*, const sema_type*> m_context_types;
+  bool m_failed{ false };
+};
+}
+}
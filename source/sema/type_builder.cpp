@@ -1,7 +1,9 @@
 #include "sema/type_builder.hpp"
+#include "sema/builtin_function_kind.hpp"
 #include "sema/builtin_sema_function.hpp"
 #include "sema/factories.hpp"
 #include "sema/factories_provider.hpp"
+#include "sema/identifiers_index_provider.hpp"
 #include "sema/sema_context_impl.hpp"
 #include "sema/user_sema_function.hpp"
 
@@ -118,9 +120,53 @@ type_builder::built_type_info type_builder::built_type() const
   return { *m_built_type, *m_built_type_ref };
 }
 
+type_builder& type_builder::with_lazy_builtin_functions(
+  builtin_functions_creator_t creator)
+{
+  auto& factories = m_factories;
+  auto& type_ctx = m_type_ctx;
+  type_ctx.add_functions_lazily(
+    [&factories, &type_ctx, creator = std::move(creator)] {
+      for (const auto& fun : creator()) {
+        const auto& function = factories.function_factory().create_builtin(
+          type_ctx, fun.return_type, fun.signature, fun.kind);
+        type_ctx.add_function(function);
+      }
+    });
+
+  return *this;
+}
+
 type_builder& type_builder::with_exported(bool exported)
 {
   m_exported = exported;
   return *this;
 }
-}
\ No newline at end of file
+
+void add_user_type_default_methods(factories_provider& factories,
+                                   const sema_type& class_ty,
+                                   sema_context& class_ctx)
+{
+  const auto& class_ref_ty = *class_ctx.find_reference_for(class_ty);
+
+  const auto dummy_param_name_token =
+    lexer::make_token(lexer::token_type::identifier, "");
+
+  auto functions = {
+    type_builder::builtin_function_info{
+      // operator=(val)
+      class_ref_ty,
+      function_signature{
+        lexer::make_token(lexer::token_type::identifier, "="),
+        { parameter_declaration{ class_ref_ty, dummy_param_name_token,
+                                 identifiers_index_provider::get_next() } } },
+      builtin_function_kind::user_type_operator_equal },
+  };
+
+  for (auto& f : functions) {
+    const auto& function = factories.function_factory().create_builtin(
+      class_ctx, f.return_type, std::move(f.signature), f.kind);
+    class_ctx.add_function(function);
+  }
+}
+}
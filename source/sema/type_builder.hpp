@@ -5,6 +5,9 @@
 #include "sema/function_signature.hpp"
 #include "sema_context.hpp"
 
+#include <functional>
+#include <vector>
+
 namespace cmsl::sema {
 struct member_info;
 class sema_context_impl;
@@ -48,6 +51,12 @@ public:
     return *this;
   }
 
+  // Functions are created on the first lookup of a function of the type.
+  using builtin_functions_creator_t =
+    std::function<std::vector<builtin_function_info>()>;
+  type_builder& with_lazy_builtin_functions(
+    builtin_functions_creator_t creator);
+
   const sema_type& build_and_register_in_context(
     sema_type::flags_t flags = {});
   const sema_type& build_enum_and_register_in_context(
@@ -70,11 +79,17 @@ private:
   factories_provider& m_factories;
   types_context& m_types_ctx;
   sema_context& m_current_ctx;
-  sema_context& m_type_ctx;
+  sema_context_impl& m_type_ctx;
   ast::type_representation m_name;
   std::vector<member_info> m_members;
   const sema_type* m_built_type;
   const sema_type* m_built_type_ref;
   bool m_exported{ false };
 };
+
+// Adds functions that every user type has without declaring them, e.g. the
+// assignment operator.
+void add_user_type_default_methods(factories_provider& factories,
+                                   const sema_type& class_ty,
+                                   sema_context& class_ctx);
 }
@@ -80,6 +80,13 @@ std::unique_ptr<types_context> types_context_impl::clone() const
   return std::move(created);
 }
 
+std::unique_ptr<types_context> types_context_impl::create_overlay() const
+{
+  auto created = std::make_unique<types_context_impl>();
+  created->m_types_finder = m_types_finder.create_overlay();
+  return std::move(created);
+}
+
 std::unique_ptr<types_context> types_context_impl::collect_exported_stuff()
   const
 {
@@ -94,4 +101,12 @@ bool types_context_impl::merge_imported_stuff(const types_context& imported,
   const auto& casted = static_cast<const types_context_impl&>(imported);
   return m_types_finder.merge_imported_stuff(casted.m_types_finder, errs);
 }
+
+void types_context_impl::for_each_type(const type_visitor_t& visitor) const
+{
+  m_types_finder.for_each_entry(
+    [&visitor](const auto& qualified_name, const type_data& data) {
+      visitor(qualified_name, data.ty);
+    });
+}
 }
@@ -3,6 +3,7 @@
 #include "sema/qualified_entries_finder.hpp"
 
 #include <ast/type_representation.hpp>
+#include <functional>
 #include <memory>
 
 namespace cmsl {
@@ -40,10 +41,17 @@ public:
   virtual void leave_ctx() = 0;
 
   virtual std::unique_ptr<types_context> clone() const = 0;
+  virtual std::unique_ptr<types_context> create_overlay() const = 0;
   virtual std::unique_ptr<types_context> collect_exported_stuff() const = 0;
 
   virtual bool merge_imported_stuff(const types_context& imported,
                                     errors::errors_observer& errs) = 0;
+
+  // Visits all the types that can be found by a qualified name, with the name
+  // given from the root scope.
+  using type_visitor_t = std::function<void(
+    const std::vector<lexer::token>& qualified_name, const sema_type& ty)>;
+  virtual void for_each_type(const type_visitor_t& visitor) const = 0;
 };
 
 class types_context_impl : public types_context
@@ -71,11 +79,14 @@ public:
   void leave_ctx() override;
 
   std::unique_ptr<types_context> clone() const override;
+  std::unique_ptr<types_context> create_overlay() const override;
   std::unique_ptr<types_context> collect_exported_stuff() const override;
 
   bool merge_imported_stuff(const types_context& imported,
                             errors::errors_observer& errs) override;
 
+  void for_each_type(const type_visitor_t& visitor) const override;
+
 private:
   qualified_entries_finder<type_data> m_types_finder;
 };
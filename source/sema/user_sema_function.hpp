@@ -12,7 +12,8 @@ public:
   explicit user_sema_function(const sema_context& ctx,
                               const sema_type* return_type,
                               function_signature s)
-    : m_ctx{ ctx }
+    : sema_function{ sema_function_kind::user }
+    , m_ctx{ ctx }
     , m_return_type{ return_type }
     , m_signature{ std::move(s) }
   {
@@ -21,12 +22,18 @@ public:
   // Todo: consider creating user_sema_funciton manipulator class
   void set_body(const block_node& body) { m_body = &body; }
   void set_return_type(const sema_type& ty) { m_return_type = &ty; }
+  void set_locals_count(unsigned count) { m_locals_count = count; }
 
   const block_node& body() const { return *m_body; }
   const function_signature& signature() const override { return m_signature; }
   const sema_context& context() const override { return m_ctx; }
   const sema_type& return_type() const override { return *m_return_type; }
 
+  // Number of frame slots needed to execute the function. Parameters occupy
+  // the first slots, local variables of sibling scopes share the following
+  // ones.
+  unsigned locals_count() const { return m_locals_count; }
+
   // It should used only by sema_builder_ast_visitor while creating sema tree.
   const sema_type* try_return_type() const override { return m_return_type; }
 
@@ -43,5 +50,6 @@ private:
   // It will be set while building a class node. It needs to be set after
   // creation because it can refer to itself in case of a recursion.
   const block_node* m_body;
+  unsigned m_locals_count{ 0u };
 };
 }
\ No newline at end of file
@@ -676,6 +676,50 @@ TEST_F(ParserTest, Expr_TokenLowPrecedenceOpTokenHighPrecedenceOpToken_GetTree)
   EXPECT_THAT(result_ast.get(), AstEq(expected_ast.get()));
 }
 
+TEST_F(ParserTest,
+       Expr_HighPrecedenceOpLowPrecedenceOpHighPrecedenceOp_GetTree)
+{
+  StrictMock<cmsl::test::strings_container_mock> strings;
+
+  // foo * bar - baz / 2
+  const auto lhs_lhs_token = token_identifier("foo");
+  const auto lhs_op_token = token_star();
+  const auto lhs_rhs_token = token_identifier("bar");
+  const auto op_token = token_minus();
+  const auto rhs_lhs_token = token_identifier("baz");
+  const auto rhs_op_token = token_slash();
+  const auto rhs_rhs_token = token_integer("2");
+
+  auto lhs_node = std::make_unique<binary_operator_node>(
+    std::make_unique<id_node>(create_qualified_name(lhs_lhs_token)),
+    lhs_op_token,
+    std::make_unique<id_node>(create_qualified_name(lhs_rhs_token)));
+  auto rhs_node = std::make_unique<binary_operator_node>(
+    std::make_unique<id_node>(create_qualified_name(rhs_lhs_token)),
+    rhs_op_token, std::make_unique<int_value_node>(rhs_rhs_token));
+
+  auto expected_ast = std::make_unique<binary_operator_node>(
+    std::move(lhs_node), op_token, std::move(rhs_node));
+
+  const auto tokens = tokens_container_t{
+    // clang-format off
+    lhs_lhs_token,
+    lhs_op_token,
+    lhs_rhs_token,
+    op_token,
+    rhs_lhs_token,
+    rhs_op_token,
+    rhs_rhs_token
+    // clang-format on
+  };
+  auto parser =
+    parser_t{ dummy_err_observer, strings, cmsl::source_view{ "" }, tokens };
+  auto result_ast = parser.parse_expr();
+
+  ASSERT_THAT(result_ast, NotNull());
+  EXPECT_THAT(result_ast.get(), AstEq(expected_ast.get()));
+}
+
 TEST_F(ParserTest, Expr_IdOpenParenCloseParen_GetFunctionCallWithoutParameters)
 {
   StrictMock<cmsl::test::strings_container_mock> strings;
@@ -6,6 +6,7 @@
 #include <sstream>
 
 namespace cmsl::errors::test {
+using ::testing::Eq;
 using ::testing::Ne;
 using ::testing::_;
 
@@ -38,4 +39,19 @@ TEST(ErrorsObserverTest, WithFacade_NotifyError_ForwardsErrorToFacade)
 
   observer.notify_error(err);
 }
+
+TEST(ErrorsObserverTest, Deferring_NotifyError_KeepsErrorTillForwarded)
+{
+  std::ostringstream oss;
+  errors_observer observer{ oss };
+  errors_observer deferring{ errors_observer::defer_errors };
+  error err{};
+  err.message = "foo";
+
+  deferring.notify_error(err);
+  EXPECT_THAT(oss.str().find("error: foo"), Eq(std::string::npos));
+
+  deferring.forward_deferred_errors(observer);
+  EXPECT_THAT(oss.str().find("error: foo"), Ne(std::string::npos));
+}
 }
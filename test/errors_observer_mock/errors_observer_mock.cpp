@@ -23,8 +23,39 @@ errors_observer::errors_observer(facade::cmake_facade*)
 {
 }
 
+errors_observer::errors_observer(defer_errors_t)
+  : m_deferring{ true }
+{
+}
+
 void errors_observer::notify_error(const cmsl::errors::error& error)
 {
+  ++m_notified_count;
+
+  if (m_deferring) {
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_deferred_errors.push_back(error);
+    return;
+  }
+
   errors_observer_mock_ptr->notify_error(error);
 }
+
+void errors_observer::forward_deferred_errors(errors_observer& observer)
+{
+  std::vector<error> errors;
+  {
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    errors.swap(m_deferred_errors);
+  }
+
+  for (const auto& err : errors) {
+    observer.notify_error(err);
+  }
+}
+
+std::size_t errors_observer::notified_count() const
+{
+  return m_notified_count;
+}
 }
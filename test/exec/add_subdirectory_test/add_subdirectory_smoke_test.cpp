@@ -7,6 +7,8 @@
 
 namespace cmsl::exec::test {
 using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::SizeIs;
 using ::testing::Return;
 using ::testing::_;
 using ::testing::ByMove;
@@ -49,4 +51,65 @@ TEST_F(AddSubdirectorySmokeTest,
   const auto result = m_executor->execute(source);
   EXPECT_THAT(result, Eq(42));
 }
+
+TEST_F(AddSubdirectorySmokeTest, ParallelParsing_SimpleAddSubdirectory)
+{
+  const auto source = "int main()"
+                      "{"
+                      "    add_subdirectory(\"foo\", 4.2);"
+                      "    return 42;"
+                      "}";
+
+  EXPECT_CALL(m_facade, current_directory())
+    .WillRepeatedly(Return(CMAKESL_EXEC_SMOKE_TEST_ROOT_DIR +
+                           std::string{ "/add_subdirectory_test" }));
+
+  m_executor->set_parsing_threads_count(4u);
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(42));
+}
+
+TEST_F(AddSubdirectorySmokeTest,
+       ParallelParsing_ImportsAndAddSubdirectory_OneVariableInstance)
+{
+  const auto source = "import \"add_subdirectory_test/import/foo.cmsl\";"
+                      ""
+                      "int main()"
+                      "{"
+                      "    foo::bar *= 100.0;"
+                      "    add_subdirectory(\"import\");"
+                      "    return int(foo::bar);"
+                      "}";
+
+  EXPECT_CALL(m_facade, current_directory())
+    .WillRepeatedly(Return(CMAKESL_EXEC_SMOKE_TEST_ROOT_DIR +
+                           std::string{ "/add_subdirectory_test" }));
+
+  m_executor->set_parsing_threads_count(4u);
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(42));
+}
+
+TEST_F(AddSubdirectorySmokeTest, MemoryReport_HasEveryCompiledModule)
+{
+  const auto source = "int main()"
+                      "{"
+                      "    add_subdirectory(\"foo\", 4.2);"
+                      "    return 42;"
+                      "}";
+
+  EXPECT_CALL(m_facade, current_directory())
+    .WillRepeatedly(Return(CMAKESL_EXEC_SMOKE_TEST_ROOT_DIR +
+                           std::string{ "/add_subdirectory_test" }));
+
+  const auto result = m_executor->execute(source);
+  ASSERT_THAT(result, Eq(42));
+
+  const auto report = m_executor->memory_report();
+  ASSERT_THAT(report, SizeIs(2u));
+  for (const auto& module : report) {
+    EXPECT_THAT(module.released_bytes, Gt(0u));
+    EXPECT_THAT(module.kept_bytes, Gt(0u));
+  }
+}
 }
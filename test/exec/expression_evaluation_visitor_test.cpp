@@ -178,6 +178,85 @@ TEST_F(ExpressionEvaluationVisitorTest,
   EXPECT_THAT(visitor.result, Eq(&instance_mock));
 }
 
+TEST_F(ExpressionEvaluationVisitorTest,
+       Visit_LocalIdentifier_LooksUpBySlotAndStoresAsResult)
+{
+  StrictMock<inst::test::instance_mock> instance_mock;
+  expression_evaluation_visitor visitor{ m_ctx };
+
+  auto ast_node = fake_ast_node();
+  const auto id_token = token_identifier("foo");
+  const auto identifier_index = 10u;
+  const auto slot = 2u;
+  sema::id_node node{
+    ast_node, valid_type, { { id_token } }, identifier_index, slot
+  };
+
+  EXPECT_CALL(m_ids_ctx, lookup_local_identifier(slot))
+    .WillOnce(Return(&instance_mock));
+
+  EXPECT_CALL(m_cmake_facade, did_fatal_error_occure())
+    .WillRepeatedly(Return(false));
+
+  visitor.visit(node);
+
+  EXPECT_THAT(visitor.result, Eq(&instance_mock));
+}
+
+TEST_F(ExpressionEvaluationVisitorTest,
+       Visit_GlobalIdentifier_LooksUpOnlyGlobalsAndStoresAsResult)
+{
+  StrictMock<inst::test::instance_mock> instance_mock;
+  expression_evaluation_visitor visitor{ m_ctx };
+
+  auto ast_node = fake_ast_node();
+  const auto id_token = token_identifier("foo");
+  const auto identifier_index = 10u;
+  sema::id_node node{ ast_node,
+                      valid_type,
+                      { { id_token } },
+                      identifier_index,
+                      std::nullopt,
+                      sema::identifier_storage::global };
+
+  EXPECT_CALL(m_ids_ctx, lookup_global_identifier(identifier_index))
+    .WillOnce(Return(&instance_mock));
+
+  EXPECT_CALL(m_cmake_facade, did_fatal_error_occure())
+    .WillRepeatedly(Return(false));
+
+  visitor.visit(node);
+
+  EXPECT_THAT(visitor.result, Eq(&instance_mock));
+}
+
+TEST_F(ExpressionEvaluationVisitorTest,
+       Visit_MemberIdentifier_LooksUpOnlyMembersAndStoresAsResult)
+{
+  StrictMock<inst::test::instance_mock> instance_mock;
+  expression_evaluation_visitor visitor{ m_ctx };
+
+  auto ast_node = fake_ast_node();
+  const auto id_token = token_identifier("foo");
+  const auto identifier_index = 10u;
+  sema::id_node node{ ast_node,
+                      valid_type,
+                      { { id_token } },
+                      identifier_index,
+                      std::nullopt,
+                      sema::identifier_storage::member };
+
+  EXPECT_CALL(m_ids_ctx, lookup_member_identifier(identifier_index))
+    .WillOnce(Return(&instance_mock));
+
+  EXPECT_CALL(m_cmake_facade, did_fatal_error_occure())
+    .WillRepeatedly(Return(false));
+
+  visitor.visit(node);
+
+  EXPECT_THAT(visitor.result, Eq(&instance_mock));
+}
+
 TEST_F(
   ExpressionEvaluationVisitorTest,
   Visit_BinaryOperator_EvaluatesLhsAndRhsAndCallsLhsMethodWithRhsAsAParameter)
@@ -34,4 +34,28 @@ TEST_F(FunctionSmokeTest, Recursion)
   const auto result = m_executor->execute(source);
   EXPECT_THAT(result, Eq(42));
 }
+
+TEST_F(FunctionSmokeTest,
+       ParametersAndResults_TemporariesAreMovedVariablesCopied)
+{
+  const auto source = "list<int> appended(list<int> l)"
+                      "{"
+                      "    l.push_back(42);"
+                      "    return l;"
+                      "}"
+                      ""
+                      "int main()"
+                      "{"
+                      "    list<int> l;"
+                      "    l.push_back(1);"
+                      "    auto from_variable = appended(l);"
+                      "    auto from_temporary = appended(appended(l));"
+                      "    return int(l.size() == 1 &&"
+                      "               from_variable.size() == 2 &&"
+                      "               from_temporary.size() == 3 &&"
+                      "               from_temporary.at(2) == 42);"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(1));
+}
 }
@@ -69,4 +69,19 @@ TEST_F(ImportSmokeTest, EnumImport)
   const auto result = m_executor->execute(source);
   EXPECT_THAT(result, Eq(1));
 }
+
+TEST_F(ImportSmokeTest, MemberFunctionOfListTypeCreatedInImportedModule)
+{
+  const auto source = "import \"import_test/foo.cmsl\";"
+                      ""
+                      "int main()"
+                      "{"
+                      "    auto quxes = foo::make_quxes();"
+                      "    foo::qux q;"
+                      "    quxes.push_back(q);"
+                      "    return quxes.size() + quxes.front().get();"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(43));
+}
 }
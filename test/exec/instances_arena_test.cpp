@@ -0,0 +1,136 @@
+#include "exec/instance/instances_arena.hpp"
+
+#include "test/exec/mock/instance_mock.hpp"
+
+#include <gmock/gmock.h>
+
+#include <vector>
+
+namespace cmsl::exec::inst::test {
+using ::testing::Eq;
+using ::testing::NotNull;
+
+namespace {
+class destruction_tracking_instance : public instance_mock
+{
+public:
+  explicit destruction_tracking_instance(unsigned& destroyed_counter)
+    : m_destroyed_counter{ destroyed_counter }
+  {
+  }
+
+  ~destruction_tracking_instance() override { ++m_destroyed_counter; }
+
+private:
+  unsigned& m_destroyed_counter;
+};
+}
+
+TEST(InstancesArenaTest, Create_CountsCreatedInstances)
+{
+  instances_arena arena;
+  unsigned destroyed{ 0u };
+
+  {
+    arena_region region{ arena };
+    const auto created =
+      region.create<destruction_tracking_instance>(destroyed);
+    ASSERT_THAT(created, NotNull());
+    EXPECT_TRUE(region.owns(created));
+  }
+
+  EXPECT_THAT(arena.stats().instances_created, Eq(1u));
+  EXPECT_THAT(arena.stats().blocks_allocated, Eq(1u));
+}
+
+TEST(InstancesArenaTest, Reset_DestroysAllInstances)
+{
+  instances_arena arena;
+  unsigned destroyed{ 0u };
+  arena_region region{ arena };
+
+  const auto first = region.create<destruction_tracking_instance>(destroyed);
+  region.create<destruction_tracking_instance>(destroyed);
+  region.reset();
+
+  EXPECT_THAT(destroyed, Eq(2u));
+  EXPECT_FALSE(region.owns(first));
+}
+
+TEST(InstancesArenaTest, Release_InstanceIsNotOwnedButAliveTillReset)
+{
+  instances_arena arena;
+  unsigned destroyed{ 0u };
+  arena_region region{ arena };
+
+  const auto created = region.create<destruction_tracking_instance>(destroyed);
+  EXPECT_TRUE(region.release(created));
+  EXPECT_FALSE(region.owns(created));
+  EXPECT_FALSE(region.release(created));
+  EXPECT_THAT(destroyed, Eq(0u));
+
+  region.reset();
+  EXPECT_THAT(destroyed, Eq(1u));
+}
+
+TEST(InstancesArenaTest, ManyInstances_AllFoundAfterIndexGrows)
+{
+  instances_arena arena;
+  unsigned destroyed{ 0u };
+  arena_region region{ arena };
+  const auto count = 1000u;
+
+  std::vector<instance*> created;
+  for (auto i = 0u; i < count; ++i) {
+    created.emplace_back(
+      region.create<destruction_tracking_instance>(destroyed));
+  }
+
+  EXPECT_TRUE(region.release(created[count / 2u]));
+  for (auto i = 0u; i < count; ++i) {
+    EXPECT_THAT(region.owns(created[i]), Eq(i != count / 2u));
+  }
+
+  region.reset();
+  EXPECT_THAT(destroyed, Eq(count));
+  EXPECT_FALSE(region.owns(created.front()));
+}
+
+TEST(InstancesArenaTest, RegionsOneAfterAnother_RecycleBlocks)
+{
+  instances_arena arena;
+  unsigned destroyed{ 0u };
+  const auto statements = 100u;
+
+  for (auto i = 0u; i < statements; ++i) {
+    arena_region region{ arena };
+    region.create<destruction_tracking_instance>(destroyed);
+  }
+
+  EXPECT_THAT(destroyed, Eq(statements));
+  EXPECT_THAT(arena.stats().instances_created, Eq(statements));
+  EXPECT_THAT(arena.stats().blocks_allocated, Eq(1u));
+  EXPECT_THAT(arena.stats().blocks_recycled, Eq(statements - 1u));
+}
+
+TEST(InstancesArenaTest, NestedRegions_UseSeparateBlocks)
+{
+  instances_arena arena;
+  unsigned destroyed{ 0u };
+  arena_region outer{ arena };
+  const auto outer_instance =
+    outer.create<destruction_tracking_instance>(destroyed);
+
+  {
+    arena_region inner{ arena };
+    const auto inner_instance =
+      inner.create<destruction_tracking_instance>(destroyed);
+    EXPECT_FALSE(outer.owns(inner_instance));
+    EXPECT_FALSE(inner.owns(outer_instance));
+  }
+
+  EXPECT_THAT(destroyed, Eq(1u));
+  EXPECT_TRUE(outer.owns(outer_instance));
+  EXPECT_THAT(arena.stats().blocks_allocated, Eq(2u));
+}
+}
@@ -467,6 +467,62 @@ TEST_F(ListTypeSmokeTest, FindPos)
   EXPECT_THAT(result, Eq(1));
 }
 
+TEST_F(ListTypeSmokeTest, Contains)
+{
+  const auto source = "int main()"
+                      "{"
+                      "    list<string> l = { \"foo\", \"bar\" };"
+                      "    return int(l.contains(\"bar\")"
+                      "               && l.contains(\"baz\") == false);"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(1));
+}
+
+TEST_F(ListTypeSmokeTest, Unique)
+{
+  const auto source = "int main()"
+                      "{"
+                      "    list<string> l = { \"b\", \"a\", \"b\","
+                      "                       \"c\", \"a\" };"
+                      "    int removed = l.unique();"
+                      "    return int(removed == 2"
+                      "               && l.size() == 3"
+                      "               && l.at(0) == \"b\""
+                      "               && l.at(1) == \"a\""
+                      "               && l.at(2) == \"c\");"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(1));
+}
+
+TEST_F(ListTypeSmokeTest, RepeatedLookupsAfterModifications)
+{
+  const auto source = "int main()"
+                      "{"
+                      "    list<int> l;"
+                      "    for(int n = 0; n < 2; n += 1)"
+                      "    {"
+                      "        for(int i = 0; i < 20; i += 1)"
+                      "        {"
+                      "            l.push_back(i);"
+                      "        }"
+                      "    }"
+                      "    bool found = l.find(7) == 7 && l.find(7, 8) == 27;"
+                      "    l.push_back(99);"
+                      "    bool appended = l.find(99) == 40;"
+                      "    l.at(5) = 99;"
+                      "    bool modified = l.find(99) == 5 && l.find(5) == 25;"
+                      "    int removed = l.remove(7);"
+                      "    return int(found && appended && modified"
+                      "               && removed == 2"
+                      "               && l.contains(7) == false"
+                      "               && l.find(8) == 7);"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(1));
+}
+
 TEST_F(ListTypeSmokeTest, Size)
 {
   const auto source = "int main()"
@@ -570,4 +626,139 @@ TEST_F(ListTypeSmokeTest, InitializerList)
   const auto result = m_executor->execute(source);
   EXPECT_THAT(result, Eq(1));
 }
+
+TEST_F(ListTypeSmokeTest, ModifyElementThroughAt)
+{
+  const auto source = "int main()"
+                      "{"
+                      "    list<int> l = { 1, 2 };"
+                      "    l.at(0) = 40;"
+                      "    l.at(1) += 2;"
+                      "    list<string> s = { \"ab\", \"c\" };"
+                      "    s.at(0) += \"cd\";"
+                      "    s.back().clear();"
+                      "    return int(l.at(0) == 40 && l.at(1) == 4"
+                      "               && s.front() == \"abcd\""
+                      "               && s.at(1).empty());"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(1));
+}
+
+TEST_F(ListTypeSmokeTest, ListOfClassInstances)
+{
+  const auto source = "class foo"
+                      "{"
+                      "    int value;"
+                      "};"
+                      ""
+                      "int main()"
+                      "{"
+                      "    foo f;"
+                      "    f.value = 24;"
+                      "    list<foo> l;"
+                      "    l.push_back(f);"
+                      "    l.push_back(f);"
+                      "    l.at(1).value = 42;"
+                      "    list<foo> l2 = l;"
+                      "    l.at(1).value = 0;"
+                      "    return int(f.value == 24 && l.at(0).value == 24"
+                      "               && l2.at(1).value == 42);"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(1));
+}
+
+TEST_F(ListTypeSmokeTest, NestedLists)
+{
+  const auto source = "list<list<string>> make(list<string> l)"
+                      "{"
+                      "    list<list<string>> result;"
+                      "    result.push_back(l);"
+                      "    return result;"
+                      "}"
+                      ""
+                      "int main()"
+                      "{"
+                      "    list<string> l = { \"a\", \"b\" };"
+                      "    list<list<list<string>>> nested;"
+                      "    nested.push_back(make(l));"
+                      "    nested.at(0).at(0).push_back(\"c\");"
+                      "    list<list<string>> copied = nested.front();"
+                      "    return copied.at(0).size() + l.size();"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(5));
+}
+
+TEST_F(ListTypeSmokeTest, InitializerListOfVariables)
+{
+  const auto source = "int main()"
+                      "{"
+                      "    string a = \"a\";"
+                      "    auto l = { a, \"b\" };"
+                      "    return int(l.size() == 2 && l.at(0) == \"a\");"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(1));
+}
+
+TEST_F(ListTypeSmokeTest, ElementReferenceFollowsElementAfterPushFront)
+{
+  const auto source = "class holder"
+                      "{"
+                      "    list<int> l;"
+                      ""
+                      "    int push_front()"
+                      "    {"
+                      "        l.push_front(40);"
+                      "        return 0;"
+                      "    }"
+                      "};"
+                      ""
+                      "int main()"
+                      "{"
+                      "    holder h;"
+                      "    h.l.push_back(2);"
+                      "    int value = h.l.at(0) + h.push_front();"
+                      "    return value + h.l.at(0);"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(42));
+}
+
+TEST_F(ListTypeSmokeTest, ElementReferenceToInnerListFollowsOuterList)
+{
+  const auto source = "class holder"
+                      "{"
+                      "    list<list<int>> l;"
+                      ""
+                      "    int grow()"
+                      "    {"
+                      "        for (int i = 0; i < 100; i += 1)"
+                      "        {"
+                      "            l.push_back(l.back());"
+                      "        }"
+                      "        return 0;"
+                      "    }"
+                      ""
+                      "    int clear()"
+                      "    {"
+                      "        l.clear();"
+                      "        return 0;"
+                      "    }"
+                      "};"
+                      ""
+                      "int main()"
+                      "{"
+                      "    holder h;"
+                      "    list<int> inner = { 21 };"
+                      "    h.l.push_back(inner);"
+                      "    int grown = h.l.at(0).at(0) + h.grow();"
+                      "    int erased = h.l.at(0).at(0) + h.clear();"
+                      "    return grown + erased + h.l.size();"
+                      "}";
+  const auto result = m_executor->execute(source);
+  EXPECT_THAT(result, Eq(42));
+}
 }
@@ -7,6 +7,9 @@ class identifiers_context_mock : public identifiers_context
 {
 public:
   MOCK_METHOD1(lookup_identifier, inst::instance*(unsigned index));
+  MOCK_METHOD1(lookup_local_identifier, inst::instance*(unsigned slot));
+  MOCK_METHOD1(lookup_global_identifier, inst::instance*(unsigned index));
+  MOCK_METHOD1(lookup_member_identifier, inst::instance*(unsigned index));
   MOCK_METHOD0(get_class_instance, inst::instance*());
 };
 }
\ No newline at end of file
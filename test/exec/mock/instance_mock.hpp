@@ -9,6 +9,7 @@ class instance_mock : public instance
 private:
 public:
   MOCK_CONST_METHOD0(copy, std::unique_ptr<instance>());
+  MOCK_METHOD0(move, std::unique_ptr<instance>());
 
   MOCK_CONST_METHOD0(value, instance_value_variant());
   MOCK_METHOD0(value_accessor, instance_value_accessor());
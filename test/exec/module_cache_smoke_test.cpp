@@ -0,0 +1,318 @@
+#include "exec/global_executor.hpp"
+#include "test/mock/cmake_facade_mock.hpp"
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace cmsl::exec::test {
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::IsEmpty;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace {
+const auto root_source = "import \"util.cmsl\";"
+                         ""
+                         "namespace ns {"
+                         "enum color { red, green, blue };"
+                         ""
+                         "class point"
+                         "{"
+                         "    int x;"
+                         "    int y;"
+                         ""
+                         "    int sum() { return x + y; }"
+                         "};"
+                         ""
+                         "int twice(int& value)"
+                         "{"
+                         "    value *= 2;"
+                         "    return value;"
+                         "}"
+                         "}"
+                         ""
+                         "auto global_value = 5;"
+                         ""
+                         "int main()"
+                         "{"
+                         "    ns::point p = { .x = 1, .y = 2 };"
+                         "    list<int> values = { 1, 2, 3 };"
+                         "    values += 4;"
+                         "    int total = 0;"
+                         "    for(int i = 0; i < values.size(); i += 1)"
+                         "    {"
+                         "        total += values.at(i);"
+                         "    }"
+                         "    int counter = 0;"
+                         "    while(counter < 3) { counter += 1; }"
+                         "    auto color = ns::color::green;"
+                         "    if(color == ns::color::green) { total += 10; }"
+                         "    else { total -= 10; }"
+                         "    string text = \"abc\";"
+                         "    total += text.size();"
+                         "    total += ns::twice(global_value);"
+                         "    total += p.sum();"
+                         "    total += util::answer();"
+                         "    util::box b;"
+                         "    total += b.get() + (counter == 3 ? 1 : 0);"
+                         "    return total;"
+                         "}";
+
+const auto util_source = "namespace util {"
+                         "export int answer()"
+                         "{"
+                         "    return 4;"
+                         "}"
+                         ""
+                         "export class box"
+                         "{"
+                         "    int value;"
+                         ""
+                         "    int get() { return value + 1; }"
+                         "};"
+                         "}";
+}
+
+// Every run uses a new executor, like a re-configure does.
+class ModuleCacheSmokeTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    const auto test_name =
+      ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    m_root_dir = ::testing::TempDir() + "/module_cache_smoke_test/" +
+      test_name + "/source";
+    m_binary_dir = ::testing::TempDir() + "/module_cache_smoke_test/" +
+      test_name + "/build";
+    std::filesystem::remove_all(m_root_dir);
+    std::filesystem::remove_all(m_binary_dir);
+    std::filesystem::create_directories(m_root_dir);
+    std::filesystem::create_directories(m_binary_dir + "/CMakeSLFiles");
+
+    ON_CALL(m_facade, get_current_binary_dir())
+      .WillByDefault(Return(m_binary_dir));
+    ON_CALL(m_facade, current_directory()).WillByDefault(Return(m_root_dir));
+  }
+
+  void write(const std::string& path, const std::string& source) const
+  {
+    const auto full_path = m_root_dir + '/' + path;
+    std::filesystem::create_directories(
+      std::filesystem::path{ full_path }.parent_path());
+    std::ofstream{ full_path } << source;
+  }
+
+  std::string path(const std::string& name) const
+  {
+    return m_root_dir + '/' + name;
+  }
+
+  // Collects paths of the loaded and compiled modules, sorted.
+  int run(const std::string& source, unsigned parsing_threads = 1u)
+  {
+    global_executor executor{ m_root_dir, m_facade };
+    executor.set_parsing_threads_count(parsing_threads);
+    const auto result = executor.execute(source);
+
+    m_loaded.clear();
+    m_compiled.clear();
+    for (const auto& memory : executor.memory_report()) {
+      // Nothing is lexed nor parsed when a module is loaded.
+      auto& paths = memory.released_bytes == 0u ? m_loaded : m_compiled;
+      paths.emplace_back(memory.path);
+    }
+
+    return result;
+  }
+
+  NiceMock<cmake_facade_mock> m_facade;
+  std::string m_root_dir;
+  std::string m_binary_dir;
+  std::vector<std::string> m_loaded;
+  std::vector<std::string> m_compiled;
+};
+
+TEST_F(ModuleCacheSmokeTest, UnchangedSources_LoadedFromCache)
+{
+  write("util.cmsl", util_source);
+
+  const auto compiled_result = run(root_source);
+  ASSERT_THAT(compiled_result, Eq(42));
+  EXPECT_THAT(m_loaded, IsEmpty());
+
+  const auto loaded_result = run(root_source);
+  EXPECT_THAT(loaded_result, Eq(42));
+  EXPECT_THAT(m_loaded,
+              ElementsAre(path("CMakeLists.cmsl"), path("util.cmsl")));
+  EXPECT_THAT(m_compiled, IsEmpty());
+}
+
+TEST_F(ModuleCacheSmokeTest, ParallelParsing_UnchangedSources_LoadedFromCache)
+{
+  write("util.cmsl", util_source);
+  run(root_source, 4u);
+
+  const auto result = run(root_source, 4u);
+
+  EXPECT_THAT(result, Eq(42));
+  EXPECT_THAT(m_loaded,
+              ElementsAre(path("CMakeLists.cmsl"), path("util.cmsl")));
+}
+
+TEST_F(ModuleCacheSmokeTest, ParallelParsing_ChangedImportedModule_Compiled)
+{
+  write("util.cmsl", util_source);
+  run(root_source, 4u);
+
+  write("util.cmsl",
+        "namespace util {"
+        "export int answer()"
+        "{"
+        "    return 3;"
+        "}"
+        ""
+        "export class box"
+        "{"
+        "    int value;"
+        ""
+        "    int get() { return value + 2; }"
+        "};"
+        "}");
+  const auto result = run(root_source, 4u);
+
+  EXPECT_THAT(result, Eq(42));
+  EXPECT_THAT(m_loaded, IsEmpty());
+}
+
+TEST_F(ModuleCacheSmokeTest, ChangedSource_Compiled)
+{
+  write("util.cmsl", util_source);
+  run(root_source);
+
+  const auto source = "import \"util.cmsl\";"
+                      ""
+                      "int main()"
+                      "{"
+                      "    return util::answer() + 20;"
+                      "}";
+  const auto result = run(source);
+
+  EXPECT_THAT(result, Eq(24));
+  EXPECT_THAT(m_loaded, ElementsAre(path("util.cmsl")));
+  EXPECT_THAT(m_compiled, ElementsAre(path("CMakeLists.cmsl")));
+}
+
+TEST_F(ModuleCacheSmokeTest, ChangedImportedModule_ImportingModuleCompiled)
+{
+  write("util.cmsl", util_source);
+  run(root_source);
+
+  write("util.cmsl",
+        "namespace util {"
+        "export int answer()"
+        "{"
+        "    return 3;"
+        "}"
+        ""
+        "export class box"
+        "{"
+        "    int value;"
+        ""
+        "    int get() { return value + 2; }"
+        "};"
+        "}");
+  const auto result = run(root_source);
+
+  EXPECT_THAT(result, Eq(42));
+  EXPECT_THAT(m_loaded, IsEmpty());
+}
+
+TEST_F(ModuleCacheSmokeTest, ChangedIndirectlyImportedModule_Compiled)
+{
+  write("util.cmsl",
+        "import \"numbers.cmsl\";"
+        ""
+        "namespace util {"
+        "export int answer()"
+        "{"
+        "    return numbers::value;"
+        "}"
+        "}");
+  write("numbers.cmsl", "namespace numbers { export int value = 42; }");
+  const auto source = "import \"util.cmsl\";"
+                      ""
+                      "int main()"
+                      "{"
+                      "    return util::answer();"
+                      "}";
+  run(source);
+
+  write("numbers.cmsl", "namespace numbers { export int value = 24; }");
+  const auto result = run(source);
+
+  EXPECT_THAT(result, Eq(24));
+  EXPECT_THAT(m_loaded, IsEmpty());
+}
+
+TEST_F(ModuleCacheSmokeTest, Subdirectory_LoadedFromCache)
+{
+  write("sub/CMakeLists.cmsl",
+        "class foo"
+        "{"
+        "    double value;"
+        "};"
+        ""
+        "int main(double value)"
+        "{"
+        "    foo f = { .value = value };"
+        "    return int(f.value * 10.0);"
+        "}");
+  const auto source = "int main()"
+                      "{"
+                      "    add_subdirectory(\"sub\", 4.2);"
+                      "    return 42;"
+                      "}";
+  run(source);
+
+  const auto result = run(source);
+
+  EXPECT_THAT(result, Eq(42));
+  EXPECT_THAT(m_loaded, ElementsAre(path("CMakeLists.cmsl"),
+                                    path("sub/CMakeLists.cmsl")));
+}
+
+TEST_F(ModuleCacheSmokeTest, CorruptedEntries_Compiled)
+{
+  write("util.cmsl", util_source);
+  run(root_source);
+
+  for (const auto& entry : std::filesystem::directory_iterator{
+         m_binary_dir + "/CMakeSLFiles" }) {
+    const auto size = std::filesystem::file_size(entry.path());
+    std::filesystem::resize_file(entry.path(), size / 2u);
+  }
+  const auto result = run(root_source);
+
+  EXPECT_THAT(result, Eq(42));
+  EXPECT_THAT(m_loaded, IsEmpty());
+}
+
+TEST_F(ModuleCacheSmokeTest, NoBinaryDirectory_NothingCached)
+{
+  ON_CALL(m_facade, get_current_binary_dir())
+    .WillByDefault(Return(std::string{}));
+  write("util.cmsl", util_source);
+  run(root_source);
+
+  const auto result = run(root_source);
+
+  EXPECT_THAT(result, Eq(42));
+  EXPECT_THAT(std::filesystem::is_empty(m_binary_dir + "/CMakeSLFiles"),
+              Eq(true));
+  EXPECT_THAT(m_loaded, IsEmpty());
+}
+}
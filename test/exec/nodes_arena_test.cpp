@@ -0,0 +1,121 @@
+#include "common/nodes_arena.hpp"
+
+#include "common/strings_container_impl.hpp"
+#include "errors/errors_observer.hpp"
+#include "exec/source_parser.hpp"
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <vector>
+
+namespace cmsl::test {
+using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::IsTrue;
+
+namespace {
+class test_node
+{
+public:
+  explicit test_node(unsigned& destroyed_counter)
+    : m_destroyed_counter{ destroyed_counter }
+  {
+  }
+
+  ~test_node() { ++m_destroyed_counter; }
+
+  static void* operator new(std::size_t size)
+  {
+    return nodes_arena::allocate_node(size);
+  }
+  static void operator delete(void* node)
+  {
+    nodes_arena::deallocate_node(node);
+  }
+
+private:
+  unsigned& m_destroyed_counter;
+};
+}
+
+TEST(NodesArenaTest, CreateInScope_AllocatesInArena)
+{
+  nodes_arena arena;
+  unsigned destroyed{ 0u };
+
+  {
+    nodes_arena::scope scope{ arena };
+    auto node = std::make_unique<test_node>(destroyed);
+  }
+
+  EXPECT_THAT(destroyed, Eq(1u));
+  EXPECT_THAT(arena.stats().nodes_allocated, Eq(1u));
+  EXPECT_THAT(arena.stats().blocks_allocated, Eq(1u));
+}
+
+TEST(NodesArenaTest, CreateOutOfScope_AllocatesOnHeap)
+{
+  nodes_arena arena;
+  unsigned destroyed{ 0u };
+
+  {
+    nodes_arena::scope scope{ arena };
+  }
+  auto node = std::make_unique<test_node>(destroyed);
+  node.reset();
+
+  EXPECT_THAT(destroyed, Eq(1u));
+  EXPECT_THAT(arena.stats().nodes_allocated, Eq(0u));
+}
+
+TEST(NodesArenaTest, NestedScopes_AllocateInInnermostArena)
+{
+  nodes_arena outer;
+  nodes_arena inner;
+  unsigned destroyed{ 0u };
+
+  nodes_arena::scope outer_scope{ outer };
+  auto first = std::make_unique<test_node>(destroyed);
+  {
+    nodes_arena::scope inner_scope{ inner };
+    auto second = std::make_unique<test_node>(destroyed);
+  }
+  auto third = std::make_unique<test_node>(destroyed);
+
+  EXPECT_THAT(outer.stats().nodes_allocated, Eq(2u));
+  EXPECT_THAT(inner.stats().nodes_allocated, Eq(1u));
+}
+
+TEST(NodesArenaTest, ManyNodes_ShareBlocks)
+{
+  nodes_arena arena;
+  unsigned destroyed{ 0u };
+  const auto count = 1000u;
+
+  {
+    nodes_arena::scope scope{ arena };
+    std::vector<std::unique_ptr<test_node>> nodes;
+    for (auto i = 0u; i < count; ++i) {
+      nodes.emplace_back(std::make_unique<test_node>(destroyed));
+    }
+  }
+
+  EXPECT_THAT(destroyed, Eq(count));
+  EXPECT_THAT(arena.stats().nodes_allocated, Eq(count));
+  EXPECT_THAT(arena.stats().blocks_allocated, Eq(1u));
+}
+
+TEST(NodesArenaTest, ParseSource_AllocatesAstInArenaOfParsedSource)
+{
+  errors::errors_observer errors_observer;
+  strings_container_impl strings;
+  exec::source_parser parser{ errors_observer, strings };
+
+  const auto parsed =
+    parser.parse(source_view{ "int main() { return 1 + 2; }" });
+
+  ASSERT_THAT(parsed.has_value(), IsTrue());
+  EXPECT_THAT(parsed->arena->stats().nodes_allocated, Gt(0u));
+}
+}
@@ -14,7 +14,18 @@ protected:
   void SetUp() override
   {
     m_executor = std::make_unique<global_executor>(
-      CMAKESL_EXEC_SMOKE_TEST_ROOT_DIR, m_facade);
+      CMAKESL_EXEC_SMOKE_TEST_ROOT_DIR, m_facade, engine_under_test());
+  }
+
+  // Smoke tests are run against both engines. The tree walker is tested by
+  // a separate executable, see test/exec/CMakeLists.txt.
+  static execution_engine engine_under_test()
+  {
+#ifdef CMAKESL_EXEC_SMOKE_TEST_TREE_WALKER
+    return execution_engine::tree_walker;
+#else
+    return execution_engine::bytecode_vm;
+#endif
   }
 
   std::unique_ptr<global_executor> m_executor;
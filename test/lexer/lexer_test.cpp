@@ -401,4 +401,53 @@ const auto values = testing::Values(
     { token_type::identifier, token_type::dot, token_type::identifier } });
 INSTANTIATE_TEST_CASE_P(Lexer, Lex_Comment, values);
 }
+
+namespace identifier_symbol {
+TEST(Lexer_Lex, SameIdentifiersInDifferentSources_GetSameSymbol)
+{
+  const std::string first_source = "foo bar";
+  const std::string second_source = "  bar(foo)";
+  const auto first = create_lexer(first_source).lex();
+  const auto second = create_lexer(second_source).lex();
+  ASSERT_THAT(first.size(), 2u);
+  ASSERT_THAT(second.size(), 4u);
+
+  EXPECT_THAT(first[0].symbol(), second[2].symbol());
+  EXPECT_THAT(first[1].symbol(), second[0].symbol());
+  EXPECT_THAT(first[0].symbol(), testing::Ne(first[1].symbol()));
+  EXPECT_THAT(first[0], second[2]);
+  EXPECT_THAT(std::hash<token>{}(first[0]), std::hash<token>{}(second[2]));
+}
+
+TEST(Lexer_Lex, Identifier_GetSpellingAndRangeFromSource)
+{
+  const std::string source = "foo  some_long_identifier";
+  const auto tokens = create_lexer(source).lex();
+  ASSERT_THAT(tokens.size(), 2u);
+
+  EXPECT_THAT(tokens[1].str(), "some_long_identifier");
+  EXPECT_THAT(tokens[1].str().data(), source.data() + 5u);
+  EXPECT_THAT(tokens[1].src_range().begin.absolute, 5u);
+  EXPECT_THAT(tokens[1].src_range().end.absolute, source.size());
+}
+
+TEST(Lexer_Lex, RepeatedIdentifier_GetSameSymbol)
+{
+  const std::string source = "foo bar foo";
+  const auto tokens = create_lexer(source).lex();
+  ASSERT_THAT(tokens.size(), 3u);
+
+  EXPECT_THAT(tokens[0].symbol(), tokens[2].symbol());
+  EXPECT_THAT(tokens[2].str().data(), source.data() + 8u);
+  EXPECT_THAT(tokens[2], make_token(token_type::identifier, "foo"));
+}
+
+TEST(Lexer_Lex, IdentifierAndKeywordWithSameSpelling_NotEqual)
+{
+  const auto identifier = make_token(token_type::identifier, "int");
+  const auto keyword = make_token(token_type::kw_int, "int");
+
+  EXPECT_THAT(identifier, testing::Ne(keyword));
+}
+}
 }
@@ -67,4 +67,33 @@ TEST_P(CommentNotEndedBeforeEOF, NotifyError)
 const auto values = Values("/*", "/*   \t\n\n\n");
 INSTANTIATE_TEST_CASE_P(LexerErrorTest, CommentNotEndedBeforeEOF, values);
 }
+
+namespace too_long {
+TEST(LexerErrorTest, TokenOfMaxLength_NoError)
+{
+  testing::StrictMock<errors::test::errors_observer_mock> err_observer_mock;
+  errors::errors_observer err_observer;
+  const auto source =
+    '"' + std::string(cmsl::lexer::token::k_max_length - 2u, 'a') + '"';
+  const cmsl::source_info info{ source };
+  auto lex = lexer_t{ err_observer, cmsl::source_view{ info } };
+  const auto tokens = lex.lex();
+  ASSERT_THAT(tokens.size(), Eq(1u));
+  EXPECT_THAT(tokens.front().str().size(), Eq(source.size()));
+}
+
+TEST(LexerErrorTest, TokenLongerThanMaxLength_NotifyError)
+{
+  errors::test::errors_observer_mock err_observer_mock;
+  errors::errors_observer err_observer;
+
+  EXPECT_CALL(err_observer_mock, notify_error(_)).Times(1);
+
+  const auto source =
+    '"' + std::string(cmsl::lexer::token::k_max_length, 'a') + '"';
+  const cmsl::source_info info{ source };
+  auto lex = lexer_t{ err_observer, cmsl::source_view{ info } };
+  EXPECT_THAT(lex.lex(), IsEmpty());
+}
+}
 }
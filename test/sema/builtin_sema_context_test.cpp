@@ -0,0 +1,101 @@
+#include "sema/builtin_sema_context.hpp"
+#include "errors/errors_observer.hpp"
+#include "sema/builtin_token_provider.hpp"
+#include "sema/enum_values_context.hpp"
+#include "sema/factories_provider.hpp"
+#include "sema/functions_context.hpp"
+#include "sema/identifiers_context.hpp"
+#include "sema/qualified_contextes_refs.hpp"
+#include "sema/sema_function.hpp"
+#include "sema/types_context.hpp"
+
+#include "test/common/tokens.hpp"
+
+#include <gmock/gmock.h>
+
+namespace cmsl::sema::test {
+using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::IsEmpty;
+using ::testing::NotNull;
+using ::testing::SizeIs;
+
+using namespace cmsl::test::common;
+
+class BuiltinSemaContextTest : public ::testing::Test
+{
+protected:
+  // list<string> is a parameter type of builtin cmake functions, so the
+  // builtin context creates it, but never looks up its member functions.
+  static ast::type_representation list_of_strings_representation()
+  {
+    const auto string_token =
+      lexer::make_token(lexer::token_type::kw_string, "string");
+    auto generic_name = ast::type_representation::generic_type_name{
+      { lexer::make_token(lexer::token_type::kw_list, "list"),
+        lexer::make_token(lexer::token_type::less, "<"), string_token,
+        lexer::make_token(lexer::token_type::greater, ">") },
+      { ast::type_representation{ ast::qualified_name{ string_token } } }
+    };
+    return ast::type_representation{ generic_name };
+  }
+
+  factories_provider m_factories;
+  errors::errors_observer m_errors_observer;
+  const builtin_token_provider m_tokens{ "" };
+  qualified_contextes m_ctxs{ std::make_unique<enum_values_context_impl>(),
+                              std::make_unique<functions_context_impl>(),
+                              std::make_unique<identifiers_context_impl>(),
+                              std::make_unique<types_context_impl>() };
+  qualified_contextes_refs m_refs{ m_ctxs };
+  const builtin_sema_context m_ctx{ m_factories, m_errors_observer, m_tokens,
+                                    m_refs };
+};
+
+TEST_F(BuiltinSemaContextTest,
+       ListTypeOfBuiltinSignature_MemberFunctionLookup_CreatesFunctions)
+{
+  const auto list_type = m_ctx.find_type(list_of_strings_representation());
+  ASSERT_THAT(list_type, NotNull());
+
+  const auto functions_before_lookup = m_factories.functions_count();
+  const auto found =
+    list_type->context().find_function_in_this_scope(token_identifier("size"));
+
+  EXPECT_THAT(found, SizeIs(1u));
+  EXPECT_THAT(m_factories.functions_count(), Gt(functions_before_lookup));
+}
+
+TEST_F(BuiltinSemaContextTest,
+       ListTypeOfBuiltinSignature_SecondMemberFunctionLookup_CreatesNothing)
+{
+  const auto list_type = m_ctx.find_type(list_of_strings_representation());
+  ASSERT_THAT(list_type, NotNull());
+  const auto& list_ctx = list_type->context();
+
+  const auto first = list_ctx.find_function_in_this_scope(
+    token_identifier("push_back"));
+  const auto functions_after_first_lookup = m_factories.functions_count();
+  const auto second = list_ctx.find_function_in_this_scope(
+    token_identifier("push_back"));
+  const auto other =
+    list_ctx.find_function_in_this_scope(token_identifier("size"));
+
+  EXPECT_THAT(m_factories.functions_count(),
+              Eq(functions_after_first_lookup));
+  EXPECT_THAT(second, Eq(first));
+  EXPECT_THAT(other, SizeIs(1u));
+}
+
+TEST_F(BuiltinSemaContextTest,
+       ListTypeOfBuiltinSignature_NotExistingMemberFunction_FindsNothing)
+{
+  const auto list_type = m_ctx.find_type(list_of_strings_representation());
+  ASSERT_THAT(list_type, NotNull());
+
+  const auto found = list_type->context().find_function_in_this_scope(
+    token_identifier("not_a_member"));
+
+  EXPECT_THAT(found, IsEmpty());
+}
+}
@@ -0,0 +1,133 @@
+#include "sema/fundamental_value.hpp"
+
+#include "sema/builtin_function_kind.hpp"
+#include "sema/builtin_sema_function.hpp"
+#include "sema/sema_context_impl.hpp"
+#include "sema/sema_nodes.hpp"
+#include "sema/sema_type.hpp"
+
+#include "test/ast/mock/ast_node_mock.hpp"
+#include "test/common/tokens.hpp"
+
+#include <gmock/gmock.h>
+
+namespace cmsl::sema::test {
+using ::testing::Eq;
+using ::testing::IsFalse;
+using ::testing::IsNull;
+using ::testing::IsTrue;
+using ::testing::NiceMock;
+using ::testing::NotNull;
+
+using namespace cmsl::test::common;
+
+using kind_t = builtin_function_kind;
+
+class FundamentalValueTest : public ::testing::Test
+{
+protected:
+  builtin_sema_function make_function(kind_t kind)
+  {
+    return builtin_sema_function{ m_ctx, m_type,
+                                  function_signature{ token_identifier() },
+                                  kind };
+  }
+
+  NiceMock<ast::test::ast_node_mock> m_ast_node;
+  const sema_context_impl m_ctx{ "" };
+  const sema_type m_type{ m_ctx, ast::type_representation{ token_kw_int() },
+                          {} };
+};
+
+TEST_F(FundamentalValueTest, Evaluate_IntArithmetic_GivesInt)
+{
+  const auto result = evaluate_fundamental_operator(
+    kind_t::int_operator_minus, fundamental_value{ int_t{ 44 } },
+    fundamental_value{ int_t{ 2 } });
+
+  ASSERT_THAT(result.has_value(), IsTrue());
+  EXPECT_THAT(result->which(), Eq(fundamental_value::kind::int_));
+  EXPECT_THAT(result->get_int(), Eq(42));
+}
+
+TEST_F(FundamentalValueTest, Evaluate_DoubleComparison_GivesBool)
+{
+  const auto result = evaluate_fundamental_operator(
+    kind_t::double_operator_less_equal, fundamental_value{ 4.2 },
+    fundamental_value{ 4.2 });
+
+  ASSERT_THAT(result.has_value(), IsTrue());
+  EXPECT_THAT(result->which(), Eq(fundamental_value::kind::bool_));
+  EXPECT_THAT(result->get_bool(), IsTrue());
+}
+
+TEST_F(FundamentalValueTest, Evaluate_Assignment_GivesNothing)
+{
+  const auto result = evaluate_fundamental_operator(
+    kind_t::int_operator_plus_equal, fundamental_value{ int_t{ 1 } },
+    fundamental_value{ int_t{ 2 } });
+
+  EXPECT_THAT(result.has_value(), IsFalse());
+}
+
+TEST_F(FundamentalValueTest, IsFundamentalOperator)
+{
+  EXPECT_THAT(is_fundamental_operator(kind_t::bool_operator_amp_amp),
+              IsTrue());
+  EXPECT_THAT(is_fundamental_operator(kind_t::int_operator_slash_equal),
+              IsTrue());
+  EXPECT_THAT(is_fundamental_operator(kind_t::double_operator_equal),
+              IsTrue());
+  EXPECT_THAT(is_fundamental_operator(kind_t::int_to_string), IsFalse());
+  EXPECT_THAT(is_fundamental_operator(kind_t::string_operator_plus),
+              IsFalse());
+}
+
+TEST_F(FundamentalValueTest, Fold_LiteralOperands_GivesLiteral)
+{
+  const auto function = make_function(kind_t::int_operator_star);
+  const int_value_node lhs{ m_ast_node, m_type, 6 };
+  const int_value_node rhs{ m_ast_node, m_type, 7 };
+
+  const auto folded = fold_constant_operator(m_ast_node, function, lhs, rhs);
+
+  const auto literal = dynamic_cast<const int_value_node*>(folded.get());
+  ASSERT_THAT(literal, NotNull());
+  EXPECT_THAT(literal->value(), Eq(42));
+  EXPECT_THAT(&literal->type(), Eq(&m_type));
+}
+
+TEST_F(FundamentalValueTest, Fold_UnaryMinus_GivesLiteral)
+{
+  const auto function = make_function(kind_t::int_operator_unary_minus);
+  const int_value_node operand{ m_ast_node, m_type, 42 };
+
+  const auto folded = fold_constant_operator(m_ast_node, function, operand);
+
+  const auto literal = dynamic_cast<const int_value_node*>(folded.get());
+  ASSERT_THAT(literal, NotNull());
+  EXPECT_THAT(literal->value(), Eq(-42));
+}
+
+TEST_F(FundamentalValueTest, Fold_DivisionByZero_IsLeftForRunTime)
+{
+  const auto function = make_function(kind_t::int_operator_slash);
+  const int_value_node lhs{ m_ast_node, m_type, 42 };
+  const int_value_node rhs{ m_ast_node, m_type, 0 };
+
+  const auto folded = fold_constant_operator(m_ast_node, function, lhs, rhs);
+
+  EXPECT_THAT(folded, IsNull());
+}
+
+TEST_F(FundamentalValueTest, Fold_Assignment_IsLeftForRunTime)
+{
+  const auto function = make_function(kind_t::int_operator_plus_equal);
+  const int_value_node lhs{ m_ast_node, m_type, 40 };
+  const int_value_node rhs{ m_ast_node, m_type, 2 };
+
+  const auto folded = fold_constant_operator(m_ast_node, function, lhs, rhs);
+
+  EXPECT_THAT(folded, IsNull());
+}
+}
@@ -543,4 +543,150 @@ TEST_F(IdentifiersContextTest,
   EXPECT_THAT(&(got_info->type.get()), &different_type);
   EXPECT_THAT(got_info->index, different_identifier_index);
 }
+
+TEST_F(IdentifiersContextTest,
+       Overlay_RegisteredInBaseNestedGlobalCtx_TypeOf_ReturnsFromBase)
+{
+  identifiers_context_impl base;
+  base.enter_global_ctx(token_identifier("ctx"),
+                        /*exported=*/false);
+
+  const auto declaration_token = token_identifier("foo");
+  const auto identifier_index = 0u;
+  base.register_identifier(declaration_token, { valid_type, identifier_index },
+                           /*exported=*/false);
+  base.leave_ctx();
+
+  const auto overlay = base.create_overlay();
+
+  {
+    // ctx::foo
+    const auto got_info =
+      overlay->info_of(create_qualified_name("foo", "ctx"));
+    ASSERT_NE(got_info, std::nullopt);
+    EXPECT_THAT(&(got_info->type.get()), &valid_type);
+  }
+  {
+    // The same global ctx entered in the overlay.
+    overlay->enter_global_ctx(token_identifier("ctx"),
+                              /*exported=*/false);
+    const auto got_info = overlay->info_of(create_qualified_name("foo"));
+    ASSERT_NE(got_info, std::nullopt);
+    EXPECT_THAT(&(got_info->type.get()), &valid_type);
+  }
+}
+
+TEST_F(IdentifiersContextTest,
+       Overlay_RegisteredInOverlay_TypeOfInBase_ReturnsNull)
+{
+  identifiers_context_impl base;
+  const auto overlay = base.create_overlay();
+
+  const auto declaration_token = token_identifier("foo");
+  const auto identifier_index = 0u;
+  overlay->register_identifier(declaration_token,
+                               { valid_type, identifier_index },
+                               /*exported=*/false);
+
+  EXPECT_NE(overlay->info_of(create_qualified_name("foo")), std::nullopt);
+  EXPECT_EQ(base.info_of(create_qualified_name("foo")), std::nullopt);
+}
+
+TEST_F(IdentifiersContextTest,
+       Overlay_RegisteredInBaseAndOverlayCtxs_TypeOf_ReturnsFromBoth)
+{
+  identifiers_context_impl base;
+  base.enter_global_ctx(token_identifier("ctx"),
+                        /*exported=*/false);
+  base.register_identifier(token_identifier("foo"), { valid_type, 0u },
+                           /*exported=*/false);
+  base.leave_ctx();
+
+  const auto overlay = base.create_overlay();
+  overlay->enter_global_ctx(token_identifier("ctx"),
+                            /*exported=*/false);
+  overlay->register_identifier(token_identifier("bar"), { different_type, 1u },
+                               /*exported=*/false);
+  overlay->leave_ctx();
+
+  // ::ctx::foo
+  const auto got_foo =
+    overlay->info_of(create_qualified_name("foo", "", "ctx"));
+  ASSERT_NE(got_foo, std::nullopt);
+  EXPECT_THAT(&(got_foo->type.get()), &valid_type);
+
+  // ::ctx::bar
+  const auto got_bar =
+    overlay->info_of(create_qualified_name("bar", "", "ctx"));
+  ASSERT_NE(got_bar, std::nullopt);
+  EXPECT_THAT(&(got_bar->type.get()), &different_type);
+}
+
+TEST_F(IdentifiersContextTest,
+       Overlay_CollectExportedStuff_DoesNotCollectBaseEntries)
+{
+  identifiers_context_impl base;
+  base.register_identifier(token_identifier("foo"), { valid_type, 0u },
+                           /*exported=*/true);
+
+  const auto overlay = base.create_overlay();
+  overlay->register_identifier(token_identifier("bar"), { different_type, 1u },
+                               /*exported=*/true);
+
+  const auto exported = overlay->collect_exported_stuff();
+
+  EXPECT_EQ(exported->info_of(create_qualified_name("foo")), std::nullopt);
+  EXPECT_NE(exported->info_of(create_qualified_name("bar")), std::nullopt);
+}
+
+TEST_F(IdentifiersContextTest,
+       Clone_RegisteredInCloneAndOriginal_TypeOf_FindsOnlyOwnEntries)
+{
+  identifiers_context_impl original;
+  original.enter_global_ctx(token_identifier("ctx"),
+                            /*exported=*/false);
+  original.register_identifier(token_identifier("foo"), { valid_type, 0u },
+                               /*exported=*/false);
+
+  const auto cloned = original.clone();
+  cloned->register_identifier(token_identifier("bar"), { different_type, 1u },
+                              /*exported=*/false);
+  original.register_identifier(token_identifier("baz"), { different_type, 2u },
+                               /*exported=*/false);
+
+  EXPECT_NE(original.info_of(create_qualified_name("foo")), std::nullopt);
+  EXPECT_NE(cloned->info_of(create_qualified_name("foo")), std::nullopt);
+
+  EXPECT_EQ(original.info_of(create_qualified_name("bar")), std::nullopt);
+  EXPECT_NE(cloned->info_of(create_qualified_name("bar")), std::nullopt);
+
+  EXPECT_NE(original.info_of(create_qualified_name("baz")), std::nullopt);
+  EXPECT_EQ(cloned->info_of(create_qualified_name("baz")), std::nullopt);
+}
+
+TEST_F(IdentifiersContextTest,
+       MergeImportedStuff_ExportedFromNestedCtx_TypeOf_ReturnsImported)
+{
+  identifiers_context_impl imported;
+  imported.enter_global_ctx(token_identifier("ctx"),
+                            /*exported=*/true);
+  imported.register_identifier(token_identifier("foo"), { valid_type, 0u },
+                               /*exported=*/true);
+  imported.register_identifier(token_identifier("bar"), { valid_type, 1u },
+                               /*exported=*/false);
+  imported.leave_ctx();
+
+  const auto exported = imported.collect_exported_stuff();
+  identifiers_context_impl ctx;
+  errors::errors_observer errs;
+  EXPECT_TRUE(ctx.merge_imported_stuff(*exported, errs));
+
+  // ctx::foo
+  const auto got_foo = ctx.info_of(create_qualified_name("foo", "ctx"));
+  ASSERT_NE(got_foo, std::nullopt);
+  EXPECT_THAT(&(got_foo->type.get()), &valid_type);
+
+  // ctx::bar
+  EXPECT_EQ(ctx.info_of(create_qualified_name("bar", "ctx")), std::nullopt);
+}
 }
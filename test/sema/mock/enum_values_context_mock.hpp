@@ -14,6 +14,7 @@ public:
   MOCK_METHOD2(enter_global_ctx, void(token_t, bool));
   MOCK_METHOD0(leave_ctx, void());
   MOCK_CONST_METHOD0(clone, std::unique_ptr<enum_values_context>());
+  MOCK_CONST_METHOD0(create_overlay, std::unique_ptr<enum_values_context>());
   MOCK_CONST_METHOD0(collect_exported_stuff,
                      std::unique_ptr<enum_values_context>());
   MOCK_METHOD2(merge_imported_stuff,
@@ -17,6 +17,7 @@ public:
   MOCK_CONST_METHOD0(is_in_global_ctx, bool());
 
   MOCK_CONST_METHOD0(clone, std::unique_ptr<identifiers_context>());
+  MOCK_CONST_METHOD0(create_overlay, std::unique_ptr<identifiers_context>());
   MOCK_CONST_METHOD0(collect_exported_stuff,
                      std::unique_ptr<identifiers_context>());
   MOCK_METHOD2(merge_imported_stuff,
@@ -8,6 +8,11 @@ namespace cmsl::sema::test {
 class sema_function_mock : public sema_function
 {
 public:
+  sema_function_mock()
+    : sema_function{ sema_function_kind::user }
+  {
+  }
+
   MOCK_CONST_METHOD0(body, const block_node&());
   MOCK_CONST_METHOD0(signature, const function_signature&());
   MOCK_CONST_METHOD0(return_type, const sema_type&());
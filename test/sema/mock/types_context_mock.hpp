@@ -24,9 +24,11 @@ public:
   MOCK_METHOD2(enter_global_ctx, void(const lexer::token&, bool));
   MOCK_METHOD0(leave_ctx, void());
   MOCK_CONST_METHOD0(clone, std::unique_ptr<types_context>());
+  MOCK_CONST_METHOD0(create_overlay, std::unique_ptr<types_context>());
   MOCK_CONST_METHOD0(collect_exported_stuff, std::unique_ptr<types_context>());
   MOCK_METHOD2(merge_imported_stuff,
                bool(const types_context& imported,
                     errors::errors_observer& errs));
+  MOCK_CONST_METHOD1(for_each_type, void(const type_visitor_t&));
 };
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "errors/errors_observer.hpp"
 
+#include "sema/overload_resolution_cache.hpp"
 #include "sema/sema_context_impl.hpp"
 #include "sema/sema_nodes.hpp"
 
@@ -316,4 +317,68 @@ TEST_F(OverloarResolutionTest, GoodOveloadedFunction_ReturnFunction)
   EXPECT_THAT(chosen, NotNull());
   EXPECT_THAT(chosen, Eq(&good_function));
 }
+
+TEST_F(OverloarResolutionTest,
+       ChosenFunctionCached_ReturnFunctionWithoutCheckingParams)
+{
+  errs_t errs;
+  const auto call_token = token_identifier("foo");
+  StrictMock<sema_function_mock> function;
+  auto param_expression = expression_mock();
+  auto param_expression_ptr = param_expression.get();
+  std::vector<std::unique_ptr<expression_node>> param_expressions;
+  param_expressions.emplace_back(std::move(param_expression));
+
+  single_scope_function_lookup_result_t scope_result{ &function };
+  function_lookup_result_t lookup_result{ scope_result };
+
+  const auto function_name_token = token_identifier("foo");
+  const auto param_name_token = token_identifier("param");
+  function_signature signature{ function_name_token,
+                                { parameter_declaration{
+                                  valid_type, param_name_token } } };
+  // Params are checked only by the first resolution.
+  EXPECT_CALL(function, signature()).WillOnce(ReturnRef(signature));
+
+  EXPECT_CALL(*param_expression_ptr, type())
+    .WillRepeatedly(ReturnRef(valid_type));
+  EXPECT_CALL(*param_expression_ptr, produces_temporary_value())
+    .WillRepeatedly(Return(false));
+
+  overload_resolution_cache cache;
+  overload_resolution resolution{ errs.observer, call_token, &cache };
+  const auto first_chosen =
+    resolution.choose(lookup_result, param_expressions);
+  const auto second_chosen =
+    resolution.choose(lookup_result, param_expressions);
+
+  EXPECT_THAT(first_chosen, Eq(&function));
+  EXPECT_THAT(second_chosen, Eq(&function));
+}
+
+TEST_F(OverloarResolutionTest, FailedResolutionNotCached_RaiseErrorEveryTime)
+{
+  errs_t errs;
+  const auto call_token = token_identifier("foo");
+
+  StrictMock<sema_function_mock> function;
+
+  single_scope_function_lookup_result_t scope_result{ &function };
+  function_lookup_result_t lookup_result{ scope_result };
+
+  const auto function_name_token = token_identifier("foo");
+  const auto param_name_token = token_identifier("param");
+  function_signature signature{ function_name_token,
+                                { parameter_declaration{
+                                  valid_type, param_name_token } } };
+  EXPECT_CALL(function, signature()).WillRepeatedly(ReturnRef(signature));
+
+  // An error and a note about the candidate, per resolution.
+  EXPECT_CALL(errs.mock, notify_error(_)).Times(4);
+
+  overload_resolution_cache cache;
+  overload_resolution resolution{ errs.observer, call_token, &cache };
+  EXPECT_THAT(resolution.choose(lookup_result, {}), IsNull());
+  EXPECT_THAT(resolution.choose(lookup_result, {}), IsNull());
+}
 }
@@ -20,6 +20,7 @@
 #include "sema/factories.hpp"
 #include "sema/factories_provider.hpp"
 #include "sema/types_context.hpp"
+#include "sema/user_sema_function.hpp"
 #include "test/common/tokens.hpp"
 #include "test/errors_observer_mock/errors_observer_mock.hpp"
 #include "test/sema/mock/add_subdirectory_semantic_handler_mock.hpp"
@@ -2570,4 +2571,308 @@ TEST_F(SemaBuilderAstVisitorTest,
 
   ASSERT_THAT(visitor.m_result_node, IsNull());
 }
+
+TEST_F(SemaBuilderAstVisitorTest, Visit_IdentifierOfLocal_GetIdNodeWithSlot)
+{
+  errs_t errs;
+  StrictMock<sema_context_mock> ctx;
+  StrictMock<identifiers_context_mock> ids_ctx;
+  StrictMock<types_context_mock> types_ctx;
+  StrictMock<functions_context_mock> functions_ctx;
+  enum_values_context_mock enums_ctx;
+  auto [visitor_members, visitor] = create_types_factory_and_visitor(
+    errs, ctx, enums_ctx, ids_ctx, types_ctx, functions_ctx);
+  std::ignore = visitor_members;
+
+  const auto id_token = token_identifier("foo");
+  const ast::id_node node{ create_qualified_name(id_token) };
+  const auto expected_slot = 3u;
+
+  auto expected_info = identifier_info{ valid_type_data.ty, 0u, expected_slot,
+                                        identifier_storage::local };
+  EXPECT_CALL(ids_ctx, info_of(_)).WillOnce(Return(expected_info));
+
+  visitor.visit(node);
+
+  ASSERT_THAT(visitor.m_result_node, NotNull());
+  const auto casted_node =
+    dynamic_cast<const id_node*>(visitor.m_result_node.get());
+  ASSERT_THAT(casted_node, NotNull());
+  EXPECT_THAT(casted_node->slot(), Eq(expected_slot));
+  EXPECT_THAT(casted_node->storage(), Eq(identifier_storage::local));
+}
+
+TEST_F(SemaBuilderAstVisitorTest,
+       Visit_VariableDeclarationOutsideOfFunction_GetNodeWithoutSlot)
+{
+  errs_t errs;
+  sema_context_mock ctx;
+  StrictMock<identifiers_context_mock> ids_ctx;
+  StrictMock<types_context_mock> types_ctx;
+  StrictMock<functions_context_mock> functions_ctx;
+  enum_values_context_mock enums_ctx;
+  auto [visitor_members, visitor] = create_types_factory_and_visitor(
+    errs, ctx, enums_ctx, ids_ctx, types_ctx, functions_ctx);
+  std::ignore = visitor_members;
+
+  auto variable_node = create_standalone_variable_declaration_node(
+    m_int_type_data.representation, token_identifier("foo"));
+
+  EXPECT_CALL(ids_ctx, register_identifier(_, _, _));
+  const auto expected_found_int =
+    types_context::type_with_reference{ m_int_type_data.ty,
+                                        m_int_type_data.ty };
+  EXPECT_CALL(types_ctx, find(m_int_type_data.qualified_names))
+    .WillRepeatedly(Return(expected_found_int));
+
+  visitor.visit(*variable_node);
+
+  const auto casted_node =
+    dynamic_cast<variable_declaration_node*>(visitor.m_result_node.get());
+  ASSERT_THAT(casted_node, NotNull());
+  EXPECT_THAT(casted_node->slot(), Eq(std::nullopt));
+}
+
+TEST_F(SemaBuilderAstVisitorTest,
+       Visit_VariableDeclarationInFunction_GetNodeWithFirstFreeSlot)
+{
+  errs_t errs;
+  sema_context_mock ctx;
+  StrictMock<identifiers_context_mock> ids_ctx;
+  StrictMock<types_context_mock> types_ctx;
+  StrictMock<functions_context_mock> functions_ctx;
+  StrictMock<sema_function_mock> function_mock;
+  enum_values_context_mock enums_ctx;
+  auto [visitor_members, visitor] = create_types_factory_and_visitor(
+    errs, ctx, enums_ctx, ids_ctx, types_ctx, functions_ctx);
+  std::ignore = visitor_members;
+
+  // Two parameters occupy the first slots.
+  auto& function_parsing_ctx = m_parsing_ctx.function_parsing_ctx;
+  function_parsing_ctx.function = &function_mock;
+  function_parsing_ctx.start_locals(2u);
+
+  auto variable_node = create_standalone_variable_declaration_node(
+    m_int_type_data.representation, token_identifier("foo"));
+
+  EXPECT_CALL(ids_ctx, register_identifier(_, _, _));
+  const auto expected_found_int =
+    types_context::type_with_reference{ m_int_type_data.ty,
+                                        m_int_type_data.ty };
+  EXPECT_CALL(types_ctx, find(m_int_type_data.qualified_names))
+    .WillRepeatedly(Return(expected_found_int));
+
+  visitor.visit(*variable_node);
+
+  const auto casted_node =
+    dynamic_cast<variable_declaration_node*>(visitor.m_result_node.get());
+  ASSERT_THAT(casted_node, NotNull());
+  EXPECT_THAT(casted_node->slot(), Eq(2u));
+  EXPECT_THAT(function_parsing_ctx.locals_count, Eq(3u));
+}
+
+TEST_F(SemaBuilderAstVisitorTest,
+       Visit_NestedAndSiblingBlocks_SiblingBlocksShareSlots)
+{
+  errs_t errs;
+  sema_context_mock ctx;
+  StrictMock<identifiers_context_mock> ids_ctx;
+  StrictMock<types_context_mock> types_ctx;
+  StrictMock<functions_context_mock> functions_ctx;
+  StrictMock<sema_function_mock> function_mock;
+  enum_values_context_mock enums_ctx;
+  auto [visitor_members, visitor] = create_types_factory_and_visitor(
+    errs, ctx, enums_ctx, ids_ctx, types_ctx, functions_ctx);
+  std::ignore = visitor_members;
+
+  auto& function_parsing_ctx = m_parsing_ctx.function_parsing_ctx;
+  function_parsing_ctx.function = &function_mock;
+  function_parsing_ctx.start_locals(1u);
+
+  const auto int_type = m_int_type_data.representation;
+
+  // { int a; { int b; } { int c; int d; } int e; }
+  ast::block_node::nodes_t first_inner_nodes;
+  first_inner_nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("b")));
+  ast::block_node::nodes_t second_inner_nodes;
+  second_inner_nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("c")));
+  second_inner_nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("d")));
+
+  ast::block_node::nodes_t nodes;
+  nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("a")));
+  nodes.emplace_back(create_block_node_ptr(std::move(first_inner_nodes)));
+  nodes.emplace_back(create_block_node_ptr(std::move(second_inner_nodes)));
+  nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("e")));
+  auto block = create_block_node_ptr(std::move(nodes));
+
+  EXPECT_CALL(ids_ctx, enter_local_ctx()).Times(3);
+  EXPECT_CALL(ids_ctx, leave_ctx()).Times(3);
+  EXPECT_CALL(ids_ctx, register_identifier(_, _, _)).Times(5);
+  const auto expected_found_int =
+    types_context::type_with_reference{ m_int_type_data.ty,
+                                        m_int_type_data.ty };
+  EXPECT_CALL(types_ctx, find(m_int_type_data.qualified_names))
+    .WillRepeatedly(Return(expected_found_int));
+
+  visitor.visit(*block);
+
+  const auto casted_node =
+    dynamic_cast<block_node*>(visitor.m_result_node.get());
+  ASSERT_THAT(casted_node, NotNull());
+  ASSERT_THAT(casted_node->nodes().size(), Eq(4u));
+
+  const auto slot_of = [](const sema_node& node) {
+    return dynamic_cast<const variable_declaration_node&>(node).slot();
+  };
+  const auto& outer = casted_node->nodes();
+  const auto& first_inner =
+    dynamic_cast<const block_node&>(*outer[1]).nodes();
+  const auto& second_inner =
+    dynamic_cast<const block_node&>(*outer[2]).nodes();
+
+  EXPECT_THAT(slot_of(*outer[0]), Eq(1u));
+  EXPECT_THAT(slot_of(*first_inner[0]), Eq(2u));
+  EXPECT_THAT(slot_of(*second_inner[0]), Eq(2u));
+  EXPECT_THAT(slot_of(*second_inner[1]), Eq(3u));
+  EXPECT_THAT(slot_of(*outer[3]), Eq(2u));
+  EXPECT_THAT(function_parsing_ctx.locals_count, Eq(4u));
+}
+
+TEST_F(SemaBuilderAstVisitorTest,
+       Visit_ForLoopWithInit_InitSlotReleasedAfterLoop)
+{
+  errs_t errs;
+  sema_context_mock ctx;
+  StrictMock<identifiers_context_mock> ids_ctx;
+  StrictMock<types_context_mock> types_ctx;
+  StrictMock<functions_context_mock> functions_ctx;
+  StrictMock<sema_function_mock> function_mock;
+  enum_values_context_mock enums_ctx;
+  auto [visitor_members, visitor] = create_types_factory_and_visitor(
+    errs, ctx, enums_ctx, ids_ctx, types_ctx, functions_ctx);
+  std::ignore = visitor_members;
+
+  auto& function_parsing_ctx = m_parsing_ctx.function_parsing_ctx;
+  function_parsing_ctx.function = &function_mock;
+  function_parsing_ctx.start_locals(0u);
+
+  const auto int_type = m_int_type_data.representation;
+
+  // for (int i;;) { int j; } int k;
+  auto init = std::make_unique<ast::variable_declaration_node>(
+    std::nullopt, int_type, token_identifier("i"), std::nullopt);
+  ast::block_node::nodes_t body_nodes;
+  body_nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("j")));
+  auto loop = ast::for_node{ token_kw_for(),    token_open_paren(),
+                             std::move(init),   token_semicolon(),
+                             nullptr,           token_semicolon(),
+                             nullptr,           token_close_paren(),
+                             create_block_node_ptr(std::move(body_nodes)) };
+  auto after_loop = create_standalone_variable_declaration_node(
+    int_type, token_identifier("k"));
+
+  // One ids context covering initialization and one for body.
+  EXPECT_CALL(ids_ctx, enter_local_ctx()).Times(2);
+  EXPECT_CALL(ids_ctx, leave_ctx()).Times(2);
+  EXPECT_CALL(ids_ctx, register_identifier(_, _, _)).Times(3);
+  const auto expected_found_int =
+    types_context::type_with_reference{ m_int_type_data.ty,
+                                        m_int_type_data.ty };
+  EXPECT_CALL(types_ctx, find(m_int_type_data.qualified_names))
+    .WillRepeatedly(Return(expected_found_int));
+
+  visitor.visit(loop);
+  const auto casted_loop =
+    dynamic_cast<for_node*>(visitor.m_result_node.get());
+  ASSERT_THAT(casted_loop, NotNull());
+  const auto casted_init =
+    dynamic_cast<const variable_declaration_node*>(casted_loop->init());
+  ASSERT_THAT(casted_init, NotNull());
+  const auto& casted_body = casted_loop->body().nodes();
+  ASSERT_THAT(casted_body.size(), Eq(1u));
+  EXPECT_THAT(casted_init->slot(), Eq(0u));
+  EXPECT_THAT(
+    dynamic_cast<const variable_declaration_node&>(*casted_body[0]).slot(),
+    Eq(1u));
+
+  visitor.visit(*after_loop);
+  const auto casted_after_loop =
+    dynamic_cast<variable_declaration_node*>(visitor.m_result_node.get());
+  ASSERT_THAT(casted_after_loop, NotNull());
+  EXPECT_THAT(casted_after_loop->slot(), Eq(0u));
+  EXPECT_THAT(function_parsing_ctx.locals_count, Eq(2u));
+}
+
+TEST_F(SemaBuilderAstVisitorTest,
+       Visit_FunctionWithParametersAndLocals_GetLocalsCountOfDeepestScope)
+{
+  errs_t errs;
+  sema_context_mock ctx;
+  StrictMock<identifiers_context_mock> ids_ctx;
+  StrictMock<types_context_mock> types_ctx;
+  StrictMock<functions_context_mock> functions_ctx;
+  enum_values_context_mock enums_ctx;
+  auto [visitor_members, visitor] = create_types_factory_and_visitor(
+    errs, ctx, enums_ctx, ids_ctx, types_ctx, functions_ctx);
+  std::ignore = visitor_members;
+
+  const auto int_type = m_int_type_data.representation;
+  auto name_token = token_identifier("foo");
+
+  ast::user_function_node::params_t params;
+  params.emplace_back(
+    ast::param_declaration{ int_type, token_identifier("first") });
+  params.emplace_back(
+    ast::param_declaration{ int_type, token_identifier("second") });
+
+  // void foo(int first, int second) { int a; { int b; } }
+  ast::block_node::nodes_t inner_nodes;
+  inner_nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("b")));
+  ast::block_node::nodes_t nodes;
+  nodes.emplace_back(create_standalone_variable_declaration_node(
+    int_type, token_identifier("a")));
+  nodes.emplace_back(create_block_node_ptr(std::move(inner_nodes)));
+  auto node = create_user_function_node(
+    m_void_type_data.representation, name_token,
+    create_block_node_ptr(std::move(nodes)), std::move(params));
+
+  const auto expected_found_void =
+    types_context::type_with_reference{ m_void_type_data.ty,
+                                        m_void_type_data.ty };
+  const auto expected_found_int =
+    types_context::type_with_reference{ m_int_type_data.ty,
+                                        m_int_type_data.ty };
+  EXPECT_CALL(types_ctx, find(m_void_type_data.qualified_names))
+    .WillRepeatedly(Return(expected_found_void));
+  EXPECT_CALL(types_ctx, find(m_int_type_data.qualified_names))
+    .WillRepeatedly(Return(expected_found_int));
+
+  EXPECT_CALL(functions_ctx, find_in_current_scope(_))
+    .WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(functions_ctx, register_function(name_token, _, _));
+
+  EXPECT_CALL(ctx, add_function(_));
+
+  // Scopes of parameters, function body and the inner block.
+  EXPECT_CALL(ids_ctx, enter_local_ctx()).Times(3);
+  EXPECT_CALL(ids_ctx, leave_ctx()).Times(3);
+  EXPECT_CALL(ids_ctx, register_identifier(_, _, _)).Times(4);
+
+  visitor.visit(*node);
+
+  const auto casted_node =
+    dynamic_cast<function_node*>(visitor.m_result_node.get());
+  ASSERT_THAT(casted_node, NotNull());
+
+  const auto& function =
+    dynamic_cast<const user_sema_function&>(casted_node->function());
+  EXPECT_THAT(function.locals_count(), Eq(4u));
+}
 }
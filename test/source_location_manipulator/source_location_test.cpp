@@ -1,3 +1,4 @@
+#include "common/source_view.hpp"
 #include "lexer/source_location_manipulator.hpp"
 
 #include <gmock/gmock.h>
@@ -153,4 +154,77 @@ const auto values = Values(IncrementSourceLocationTestState{ "01234", 4u },
 INSTANTIATE_TEST_CASE_P(SourceLocationManipulator,
                         SourceSizeMinusOneOrMoreIncrements, values);
 }
+
+namespace source_view_location {
+struct SourceViewLocation : public TestWithParam<std::string>
+{
+};
+
+TEST_P(SourceViewLocation, SameAsManipulatorAtEveryPosition)
+{
+  const auto& source = GetParam();
+  const cmsl::source_info info{ source };
+  const auto view = cmsl::source_view{ info };
+  source_location_manipulator_t sl_manip{ source };
+
+  for (auto i = 0u; i <= source.size(); ++i) {
+    const auto expected = sl_manip.location();
+    const auto loc = view.location(expected.absolute);
+
+    EXPECT_THAT(loc.line, expected.line) << "at " << expected.absolute;
+    EXPECT_THAT(loc.column, expected.column) << "at " << expected.absolute;
+    EXPECT_THAT(loc.absolute, expected.absolute);
+
+    sl_manip.consume_char();
+  }
+}
+
+const auto values = Values("", "01234", "\n", "\n\n", "0\n", "0\n1",
+                           "01\n\n234\n", "\n01\n2");
+INSTANTIATE_TEST_CASE_P(SourceView, SourceViewLocation, values);
+
+TEST(SourceView, Line_GetsLinesAfterTheFirstOneWithTheirStartPositions)
+{
+  const auto source = std::string{ "01\n234\n\n5" };
+  const cmsl::source_info info{ source };
+  const auto view = cmsl::source_view{ info };
+
+  EXPECT_THAT(view.line(2u).line, Eq("234"));
+  EXPECT_THAT(view.line(2u).start_pos, Eq(3u));
+  EXPECT_THAT(view.line(3u).line, Eq(""));
+  EXPECT_THAT(view.line(4u).line, Eq("5"));
+  EXPECT_THAT(view.line(5u).line, Eq(""));
+  EXPECT_THAT(view.line(5u).start_pos, Eq(0u));
+}
+
+TEST(SourceView, UnownedSource_SameAsOwnedOne)
+{
+  const auto source = std::string{ "01\n234\n\n5" };
+  const cmsl::source_info info{ source };
+  const auto owned = cmsl::source_view{ info };
+  const auto unowned = cmsl::source_view{ source };
+
+  for (auto i = 0u; i <= source.size(); ++i) {
+    EXPECT_THAT(unowned.location(i).line, Eq(owned.location(i).line));
+    EXPECT_THAT(unowned.location(i).column, Eq(owned.location(i).column));
+  }
+  for (auto line = 1u; line <= 5u; ++line) {
+    EXPECT_THAT(unowned.line(line).line, Eq(owned.line(line).line));
+  }
+}
+
+TEST(SourceView, SourceChangedAtTheSameAddress_UsesNewLines)
+{
+  auto source = std::string{ "01\n23" };
+  const auto view = cmsl::source_view{ source };
+  EXPECT_THAT(view.location(4u).line, Eq(2u));
+  EXPECT_THAT(view.line(2u).line, Eq("23"));
+
+  source[2] = '2';
+  const auto changed = cmsl::source_view{ source };
+
+  EXPECT_THAT(changed.location(4u).line, Eq(1u));
+  EXPECT_THAT(changed.line(2u).line, Eq(""));
+}
+}
 }
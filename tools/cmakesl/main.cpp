@@ -2,9 +2,14 @@
 #include "exec/global_executor.hpp"
 #include "exec/instance/instance.hpp"
 
+#include <algorithm>
+#include <charconv>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <stack>
+#include <string_view>
+#include <thread>
 
 class fake_cmake_facade : public cmsl::facade::cmake_facade
 {
@@ -159,10 +164,36 @@ private:
   bool m_fatal_error_occured{ false };
 };
 
+namespace {
+constexpr auto k_usage = "Usage: cmakesl path/to/root/CMakeLists.cmsl [-jN]";
+
+// Parses -jN. N has to be a positive number. It's clamped to the number of
+// hardware threads, as more parsing threads would only compete for cores.
+std::optional<unsigned> parse_parsing_threads_count(std::string_view arg)
+{
+  if (arg.rfind("-j", 0u) != 0u) {
+    return std::nullopt;
+  }
+
+  const auto value = arg.substr(2u);
+  auto count = 0u;
+  const auto [end, ec] =
+    std::from_chars(value.data(), value.data() + value.size(), count);
+  if (ec != std::errc{} || end != value.data() + value.size() ||
+      count == 0u) {
+    return std::nullopt;
+  }
+
+  const auto hardware_threads =
+    std::max(std::thread::hardware_concurrency(), 1u);
+  return std::min(count, hardware_threads);
+}
+}
+
 int main(int argc, const char* argv[])
 {
-  if (argc < 2) {
-    std::cerr << "Usage: cmakesl path/to/root/CMakeLists.cmsl";
+  if (argc < 2 || argc > 3) {
+    std::cerr << k_usage;
     return 1;
   }
 
@@ -174,10 +205,22 @@ int main(int argc, const char* argv[])
   const auto root_file_path = std::string{ argv[1] };
   const auto end_of_root_dir = root_file_path.find("/CMakeLists.cmsl");
   if (end_of_root_dir == std::string::npos) {
-    std::cerr << "Usage: cmakesl path/to/root/CMakeLists.cmsl";
+    std::cerr << k_usage;
     return 1;
   }
 
+  // -jN parses scripts reachable from the root one with N threads.
+  auto parsing_threads_count = 1u;
+  if (argc > 2) {
+    const auto count = parse_parsing_threads_count(argv[2]);
+    if (!count) {
+      std::cerr << k_usage;
+      return 1;
+    }
+
+    parsing_threads_count = *count;
+  }
+
   const auto root_dir_path = root_file_path.substr(0, end_of_root_dir);
 
   std::ifstream in{ root_file_path };
@@ -186,6 +229,7 @@ int main(int argc, const char* argv[])
 
   fake_cmake_facade facade;
   cmsl::exec::global_executor executor{ root_dir_path, facade };
+  executor.set_parsing_threads_count(parsing_threads_count);
 
   executor.execute(source);
 }
@@ -48,7 +48,10 @@ cmsl_parsed_source* cmsl_parse_source(
     std::make_unique<cmsl::sema::builtin_token_provider>(
       std::move(builtin_documentation_path));
 
-  cmsl::source_view source_view{ parsed_source->source };
+  parsed_source->source_info =
+    std::make_unique<cmsl::source_info>(parsed_source->source);
+  cmsl::source_view source_view{ *parsed_source->source_info };
+  cmsl::nodes_arena::scope arena_scope{ *parsed_source->arena };
 
   cmsl::lexer::lexer lex{ parsed_source->context.errors_observer,
                           source_view };
@@ -1,6 +1,7 @@
 #include "cmsl_parsed_source.hpp"
 
 #include "ast/ast_node.hpp"
+#include "common/source_view.hpp"
 #include "common/strings_container.hpp"
 #include "sema/add_subdirectory_semantic_handler.hpp"
 #include "sema/builtin_token_provider.hpp"
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/nodes_arena.hpp"
 #include "sema/builtin_types_accessor.hpp"
 #include "sema/import_handler.hpp"
 #include "sema/sema_node.hpp"
@@ -9,6 +10,7 @@
 #include <string>
 
 namespace cmsl {
+class source_info;
 class strings_container;
 
 namespace sema {
@@ -21,7 +23,13 @@ struct cmsl_parsed_source
 {
   ~cmsl_parsed_source();
 
+  // Nodes of the trees are allocated in the arena, so it has to be destroyed
+  // last.
+  std::unique_ptr<cmsl::nodes_arena> arena{
+    std::make_unique<cmsl::nodes_arena>()
+  };
   std::string source;
+  std::unique_ptr<cmsl::source_info> source_info;
   std::unique_ptr<cmsl::sema::builtin_token_provider> builtin_token_provider;
   cmsl::sema::sema_tree_building_context context;
   std::unique_ptr<cmsl::sema::add_subdirectory_semantic_handler>